@@ -0,0 +1,159 @@
+﻿// Copyright 2023-2024, Le Binh Son, All Rights Reserved.
+
+#include "ChirpPhasorBank.h"
+
+#include "ExtendArrayMath.h"
+#include "ImpactSFXSynth/Public/Utils.h"
+
+namespace LBSImpactSFXSynth
+{
+	FChirpPhasorBank::FChirpPhasorBank()
+		: TimeResolution(0.f), NumModals(0), NumSimdModals(0)
+	{
+	}
+
+	void FChirpPhasorBank::Init(const int32 MaxNumModals, const float InSamplingRate)
+	{
+		TimeResolution = 1.f / InSamplingRate;
+		NumModals = 0;
+		NumSimdModals = 0;
+		
+		const int32 NumBufferModals = FitToAudioRegister(MaxNumModals);
+		ModeBuffer.SetNumUninitialized(NumBufferModals);
+		for(FAlignedFloatBuffer* Buffer : { &AmpBuffer, &DecayBuffer, &F0Buffer, &ChirpRateBuffer, &FreqRangeBuffer,
+											&PhaseBuffer, &SpeedBuffer, &AccelBuffer,
+											&ZRealBuffer, &ZImgBuffer, &WRealBuffer, &WImgBuffer, &RRealBuffer, &RImgBuffer })
+		{
+			Buffer->SetNumUninitialized(NumBufferModals);
+			FMemory::Memzero(Buffer->GetData(), NumBufferModals * sizeof(float));
+		}
+	}
+
+	void FChirpPhasorBank::AddModal(const EChirpPhaseMode Mode, const float Amp, const float Decay, const float F0,
+	                                const float ChirpRate, const float FreqRange)
+	{
+		check(NumModals < AmpBuffer.Num());
+		
+		ModeBuffer[NumModals] = Mode;
+		AmpBuffer[NumModals] = Amp;
+		DecayBuffer[NumModals] = Decay;
+		F0Buffer[NumModals] = F0;
+		ChirpRateBuffer[NumModals] = ChirpRate;
+		FreqRangeBuffer[NumModals] = FreqRange;
+		NumModals++;
+	}
+
+	void FChirpPhasorBank::Synthesize(TArrayView<const float> TimeValues, TArrayView<float> OutAudio)
+	{
+		const int32 NumOutFrames = OutAudio.Num();
+		if(NumModals <= 0 || NumOutFrames <= 0)
+			return;
+
+		check(TimeValues.Num() >= NumOutFrames);
+		
+		//Padded modals have zero amplitude so they don't add anything to the output
+		NumSimdModals = FitToAudioRegister(NumModals);
+		for(int32 i = NumModals; i < NumSimdModals; i++)
+		{
+			ModeBuffer[i] = EChirpPhaseMode::Linear;
+			AmpBuffer[i] = 0.f;
+			DecayBuffer[i] = 0.f;
+			F0Buffer[i] = 0.f;
+			ChirpRateBuffer[i] = 0.f;
+			FreqRangeBuffer[i] = 0.f;
+		}
+		
+		const float StartTime = TimeValues[0];
+		for(int32 StartFrame = 0; StartFrame < NumOutFrames; StartFrame += NumRenormSamples)
+		{
+			const int32 NumFrames = FMath::Min(NumRenormSamples, NumOutFrames - StartFrame);
+			const float Time = TimeValues[StartFrame];
+			AnchorPhases(Time, Time - StartTime);
+			ExtendArrayMath::ArrayChirpPhasorSynth(ZRealBuffer, ZImgBuffer, WRealBuffer, WImgBuffer, RRealBuffer, RImgBuffer,
+												   NumSimdModals, OutAudio.Slice(StartFrame, NumFrames));
+		}
+	}
+
+	void FChirpPhasorBank::AnchorPhases(const float Time, const float ElapsedTime)
+	{
+		for(int32 i = 0; i < NumSimdModals; i++)
+			GetPhaseDerivatives(i, Time, PhaseBuffer[i], SpeedBuffer[i], AccelBuffer[i]);
+
+		//Phase(n) ~= Phase + Speed * n + Accel * n^2 / 2
+		//Z = Amp * exp(Decay * t) * e^(i * Phase), W = exp(Decay * dt) * e^(i * (Speed + Accel / 2)), R = e^(i * Accel) 
+		const VectorRegister4Float ElapsedVector = VectorSetFloat1(ElapsedTime);
+		const VectorRegister4Float TimeStepVector = VectorSetFloat1(TimeResolution);
+		const VectorRegister4Float HalfVector = VectorSetFloat1(0.5f);
+		for(int32 i = 0; i < NumSimdModals; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
+		{
+			const VectorRegister4Float DecayVector = VectorLoadAligned(&DecayBuffer[i]);
+			const VectorRegister4Float AccelVector = VectorLoadAligned(&AccelBuffer[i]);
+			const VectorRegister4Float Envelope = VectorMultiply(VectorLoadAligned(&AmpBuffer[i]), VectorExp(VectorMultiply(DecayVector, ElapsedVector)));
+			const VectorRegister4Float DecayPerSample = VectorExp(VectorMultiply(DecayVector, TimeStepVector));
+			
+			const VectorRegister4Float PhaseVector = VectorLoadAligned(&PhaseBuffer[i]);
+			const VectorRegister4Float StepVector = VectorMultiplyAdd(AccelVector, HalfVector, VectorLoadAligned(&SpeedBuffer[i]));
+
+			VectorRegister4Float SinVector;
+			VectorRegister4Float CosVector;
+			VectorSinCos(&SinVector, &CosVector, &PhaseVector);
+			VectorStore(VectorMultiply(Envelope, CosVector), &ZRealBuffer[i]);
+			VectorStore(VectorMultiply(Envelope, SinVector), &ZImgBuffer[i]);
+
+			VectorSinCos(&SinVector, &CosVector, &StepVector);
+			VectorStore(VectorMultiply(DecayPerSample, CosVector), &WRealBuffer[i]);
+			VectorStore(VectorMultiply(DecayPerSample, SinVector), &WImgBuffer[i]);
+
+			VectorSinCos(&SinVector, &CosVector, &AccelVector);
+			VectorStore(CosVector, &RRealBuffer[i]);
+			VectorStore(SinVector, &RImgBuffer[i]);
+		}
+	}
+
+	void FChirpPhasorBank::GetPhaseDerivatives(const int32 Index, const float Time, float& OutPhase, float& OutSpeed, float& OutAccel) const
+	{
+		//Speed and Accel are the first and second derivatives of phase scaled to per sample units
+		const float F0 = F0Buffer[Index];
+		const float ChirpRate = ChirpRateBuffer[Index];
+		const float TimeStepSquare = TimeResolution * TimeResolution;
+		switch (ModeBuffer[Index])
+		{
+		case EChirpPhaseMode::Sigmoid:
+			{
+				//Phase = 2Pi * t * (F0 + FRange * s(t)) with s(t) = 2 / (1 + e^(-kt)) - 1
+				const float FreqRange = FreqRangeBuffer[Index];
+				const float ExpValue = FMath::Exp(-Time * ChirpRate);
+				const float InvOnePlusExp = 1.f / (1.f + ExpValue);
+				const float Sigmoid = 2.f * InvOnePlusExp - 1.f;
+				const float SigmoidD1 = 2.f * ChirpRate * ExpValue * InvOnePlusExp * InvOnePlusExp;
+				const float SigmoidD2 = SigmoidD1 * ChirpRate * (ExpValue - 1.f) * InvOnePlusExp;
+				OutPhase = UE_TWO_PI * Time * (F0 + FreqRange * Sigmoid);
+				OutSpeed = UE_TWO_PI * (F0 + FreqRange * (Sigmoid + Time * SigmoidD1)) * TimeResolution;
+				OutAccel = UE_TWO_PI * FreqRange * (2.f * SigmoidD1 + Time * SigmoidD2) * TimeStepSquare;
+			}
+			break;
+			
+		case EChirpPhaseMode::Exponent:
+			{
+				//Phase = 2Pi * (F0 - FRange) * t + 2Pi * 2 * FRange / k * ln(e^(kt) + 1)
+				const float FreqRange = FreqRangeBuffer[Index];
+				const float DeltaF0Range = (F0 - FreqRange) * UE_TWO_PI;
+				const float ExpConst = 2.0f * FreqRange / ChirpRate * UE_TWO_PI;
+				const float KTime = Time * ChirpRate;
+				const float ExpValue = FMath::Exp(-KTime);
+				const float Sigma = 1.f / (1.f + ExpValue);
+				OutPhase = DeltaF0Range * Time + ExpConst * (KTime + FMath::Loge(1.f + ExpValue));
+				OutSpeed = (DeltaF0Range + ExpConst * ChirpRate * Sigma) * TimeResolution;
+				OutAccel = ExpConst * ChirpRate * ChirpRate * Sigma * (1.f - Sigma) * TimeStepSquare;
+			}
+			break;
+			
+		default:
+			//Phase = 2Pi * t * (F0 + c * t)
+			OutPhase = UE_TWO_PI * Time * (F0 + ChirpRate * Time);
+			OutSpeed = UE_TWO_PI * (F0 + 2.f * ChirpRate * Time) * TimeResolution;
+			OutAccel = 2.f * UE_TWO_PI * ChirpRate * TimeStepSquare;
+			break;
+		}
+	}
+}
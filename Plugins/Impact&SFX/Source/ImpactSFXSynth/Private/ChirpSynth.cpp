@@ -41,6 +41,8 @@ namespace LBSImpactSFXSynth
 				break;
 			}
 		}
+
+		PhasorBank.Init(NumModals, SamplingRate);
 		
 		return NumModals;
 	}
@@ -133,6 +135,7 @@ namespace LBSImpactSFXSynth
 		const float CurrentAlpha = GetCurrentRandAlpha();
 		const bool bReachDuration = IsReachRamDuration(); 
 		const float ChirpDuration = bReachDuration ? CurrentMaxRampDuration : Duration;   
+		PhasorBank.Reset();
 		for(int i = 0, j = 0; i < NumUsedParams; i += FModalSynth::NumParamsPerModal, j++)
 		{
 			float Amp = FMath::Clamp(ModalParamsBuffer[i] * Params.AmpScale, -1.f, 1.f);
@@ -154,17 +157,16 @@ namespace LBSImpactSFXSynth
 			bIsFinish = false;
 			if(Freq <= FModalSynth::FMin || Freq >= FModalSynth::FMax || FMath::IsNearlyZero(Params.ChirpRate) || bReachDuration)
 			{
-				const float PhiSpeed = FMath::Clamp(Freq, FModalSynth::FMin, FModalSynth::FMax) * UE_TWO_PI;
-				ExtendArrayMath::ArrayImpactModalDeltaDecay(TimeBuffer, Amp, Decay, PhiSpeed, OutAudio);
+				const float ConstFreq = FMath::Clamp(Freq, FModalSynth::FMin, FModalSynth::FMax);
+				PhasorBank.AddModal(EChirpPhaseMode::Linear, Amp, Decay, ConstFreq, 0.f, 0.f);
 				continue;
 			}
 			
-			if(NumModals > 1)
-				ExtendArrayMath::ArrayLinearChirpSynth(TimeBuffer, Params.ChirpRate, Amp, Decay, F0, OutAudio);
-			else
-				ExtendArrayMath::ArrayLinearChirpSynthSingle(TimeBuffer, Params.ChirpRate, Amp, Decay, F0, OutAudio);
+			PhasorBank.AddModal(EChirpPhaseMode::Linear, Amp, Decay, F0, Params.ChirpRate, 0.f);
 		}
 
+		PhasorBank.Synthesize(TimeBuffer, OutAudio);
+
 		if(!bNotAllSameDecayParam)
 		{
 			const float Decay = -ModalParamsBuffer[FModalSynth::DecayBin] * Params.DecayScale;
@@ -266,6 +268,7 @@ namespace LBSImpactSFXSynth
 		const float ChirpRate = CalculateChirpRate(Params.ChirpRate, Params.RampDuration);
 		const float CurrentAlpha = GetCurrentRandAlpha();
 		bIsAllFrequencyReachTarget = true;
+		PhasorBank.Reset();
 		for(int i = 0, j = 0; i < NumUsedParams; i += FModalSynth::NumParamsPerModal, j++)
 		{
 			float Amp = FMath::Clamp(ModalParamsBuffer[i] * Params.AmpScale, -1.f, 1.f);
@@ -300,15 +303,16 @@ namespace LBSImpactSFXSynth
 			
 			if(bReachFTarget)
 			{
-				const float PhiSpeed = (CurrentFreq * UE_TWO_PI);
-				ExtendArrayMath::ArrayImpactModalDeltaDecay(TimeBuffer, Amp, Decay, PhiSpeed, OutAudio);
+				PhasorBank.AddModal(EChirpPhaseMode::Linear, Amp, Decay, CurrentFreq, 0.f, 0.f);
 			}
 			else
 			{
 				bIsAllFrequencyReachTarget = false;
-				ArrayChirpSynthesize(OutAudio, ChirpRate, Amp, Decay, F0, FreqRange, 0.f);
+				AddChirpModal(ChirpRate, Amp, Decay, F0, FreqRange);
 			}
 		}
+
+		PhasorBank.Synthesize(TimeBuffer, OutAudio);
 		
 		if(!bNotAllSameDecayParam && Params.DecayScale > 1e-6f)
 		{
@@ -329,17 +333,16 @@ namespace LBSImpactSFXSynth
 		return F0 + FreqRange * (-1.0f + 2.0f / (1.0f + FMath::Exp(-ExpFactor)));
 	}
 
-	void FSigmoidChirpSynth::ArrayChirpSynthesize(const TArrayView<float>& OutAudio, float ChirpRate, float Amp, float Decay, float F0,
-												  float FreqRange, const float Bias)
+	void FSigmoidChirpSynth::AddChirpModal(float ChirpRate, float Amp, float Decay, float F0, float FreqRange)
     {
 		if(ChirpRate > 0.01f)
 		{
-			ExtendArrayMath::ArraySigmoidChirpSynth(TimeBuffer, ChirpRate, Amp, Decay, F0, FreqRange, Bias, OutAudio);
+			PhasorBank.AddModal(EChirpPhaseMode::Sigmoid, Amp, Decay, F0, ChirpRate, FreqRange);
 		}
 		else
 		{ //If chirp rate is too smale just use linear for better performance and avoid floating point accuracy problem 
 			ChirpRate = FreqRange / CurrentMaxRampDuration;
-			ExtendArrayMath::ArrayLinearChirpSynth(TimeBuffer, ChirpRate, Amp, Decay, F0, OutAudio);
+			PhasorBank.AddModal(EChirpPhaseMode::Linear, Amp, Decay, F0, ChirpRate, 0.f);
 		}
     }
 	
@@ -435,16 +438,16 @@ namespace LBSImpactSFXSynth
 		return F0 + FreqRange * (-1.0f + 2.0f / (1.0f + FMath::Exp(-ExpFactor)));
 	}
 
-	void FExponentChirpSynth::ArrayChirpSynthesize(const TArrayView<float>& OutAudio, float ChirpRate, float Amp, float Decay, float F0, float FreqRange, const float Bias)
+	void FExponentChirpSynth::AddChirpModal(float ChirpRate, float Amp, float Decay, float F0, float FreqRange)
 	{
 		if(ChirpRate > 0.05f)
 		{
-			ExtendArrayMath::ArrayExponentChirpSynth(TimeBuffer, ChirpRate, Amp, Decay, F0, FreqRange, Bias, OutAudio);
+			PhasorBank.AddModal(EChirpPhaseMode::Exponent, Amp, Decay, F0, ChirpRate, FreqRange);
 		}
 		else
 		{ //If chirp rate is too smale just use linear for better performance and avoid floating point accuracy problem 
 			ChirpRate = FreqRange / CurrentMaxRampDuration;
-			ExtendArrayMath::ArrayLinearChirpSynth(TimeBuffer, ChirpRate, Amp, Decay, F0, OutAudio);
+			PhasorBank.AddModal(EChirpPhaseMode::Linear, Amp, Decay, F0, ChirpRate, 0.f);
 		}
 	}
 	
@@ -0,0 +1,86 @@
+﻿// Copyright 2023-2024, Le Binh Son, All Rights Reserved.
+
+#include "CustomStatGroup.h"
+
+DEFINE_STAT(STAT_ImpactSFXActiveVoices);
+DEFINE_STAT(STAT_ImpactSFXActiveModals);
+DEFINE_STAT(STAT_ImpactSFXResidualFrames);
+DEFINE_STAT(STAT_ImpactSFXVoicesStolen);
+DEFINE_STAT(STAT_ImpactSFXVoiceCreations);
+
+UE_TRACE_CHANNEL_DEFINE(ImpactSFXSynthChannel);
+
+namespace LBSImpactSFXSynth
+{
+	FThreadSafeCounter FSynthNodeTrace::TotalActiveVoices;
+	FThreadSafeCounter FSynthNodeTrace::TotalActiveModals;
+	FThreadSafeCounter FSynthNodeTrace::NumInstances;
+	
+	FSynthNodeTrace::FSynthNodeTrace(const FName& InNodeName)
+		: LastNumActiveVoices(0), LastNumActiveModals(0)
+	{
+		//Same node can be instanced by many graphs so append an id to keep Insights tracks separated
+		Name = FString::Printf(TEXT("ImpactSFX/%s_%d"), *InNodeName.ToString(), NumInstances.Increment());
+	}
+
+	FSynthNodeTrace::~FSynthNodeTrace()
+	{
+		UpdateLevels(0, 0);
+	}
+
+	void FSynthNodeTrace::Publish(FSynthBlockCounters& InCounters)
+	{
+		UpdateLevels(InCounters.NumActiveVoices, InCounters.NumActiveModals);
+		
+		INC_DWORD_STAT_BY(STAT_ImpactSFXResidualFrames, InCounters.NumResidualFrames);
+		INC_DWORD_STAT_BY(STAT_ImpactSFXVoicesStolen, InCounters.NumVoicesStolen);
+		INC_DWORD_STAT_BY(STAT_ImpactSFXVoiceCreations, InCounters.NumVoiceCreations);
+		
+#if COUNTERSTRACE_ENABLED
+		if(UE_TRACE_CHANNELEXPR_IS_ENABLED(ImpactSFXSynthChannel))
+		{
+			if(!ActiveVoicesCounter.IsValid())
+				CreateTraceCounters();
+			
+			ActiveVoicesCounter->Set(InCounters.NumActiveVoices);
+			ActiveModalsCounter->Set(InCounters.NumActiveModals);
+			ResidualFramesCounter->Set(InCounters.NumResidualFrames);
+			VoicesStolenCounter->Set(InCounters.NumVoicesStolen);
+			VoiceCreationsCounter->Set(InCounters.NumVoiceCreations);
+		}
+#endif
+		
+		InCounters.ResetEvents();
+	}
+
+	void FSynthNodeTrace::UpdateLevels(const int32 NumActiveVoices, const int32 NumActiveModals)
+	{
+		//Totals are kept outside of stats so they stay correct when stat collection is toggled during a session
+		const int32 Voices = TotalActiveVoices.Add(NumActiveVoices - LastNumActiveVoices) + NumActiveVoices - LastNumActiveVoices;
+		const int32 Modals = TotalActiveModals.Add(NumActiveModals - LastNumActiveModals) + NumActiveModals - LastNumActiveModals;
+		LastNumActiveVoices = NumActiveVoices;
+		LastNumActiveModals = NumActiveModals;
+		
+		SET_DWORD_STAT(STAT_ImpactSFXActiveVoices, Voices);
+		SET_DWORD_STAT(STAT_ImpactSFXActiveModals, Modals);
+	}
+
+#if COUNTERSTRACE_ENABLED
+	void FSynthNodeTrace::CreateTraceCounters()
+	{
+		//Trace counters keep a pointer to their names so these strings must live as long as the counters
+		CounterNames.Empty(5);
+		CounterNames.Emplace(Name + TEXT("/Active Voices"));
+		CounterNames.Emplace(Name + TEXT("/Active Modals"));
+		CounterNames.Emplace(Name + TEXT("/Residual Frames"));
+		CounterNames.Emplace(Name + TEXT("/Voices Stolen"));
+		CounterNames.Emplace(Name + TEXT("/Voice Creations"));
+		
+		ActiveVoicesCounter = MakeUnique<FTraceCounter>(*CounterNames[0], TraceCounterDisplayHint_None);
+		ActiveModalsCounter = MakeUnique<FTraceCounter>(*CounterNames[1], TraceCounterDisplayHint_None);
+		ResidualFramesCounter = MakeUnique<FTraceCounter>(*CounterNames[2], TraceCounterDisplayHint_None);
+		VoicesStolenCounter = MakeUnique<FTraceCounter>(*CounterNames[3], TraceCounterDisplayHint_None);
+		VoiceCreationsCounter = MakeUnique<FTraceCounter>(*CounterNames[4], TraceCounterDisplayHint_None);
+	}
+#endif
+}
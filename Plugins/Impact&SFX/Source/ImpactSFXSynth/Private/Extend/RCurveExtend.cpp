@@ -117,19 +117,20 @@ bool FRCurveExtendAssetProxy::IsXAxisRangeMatch(float Start, float End) const
 	return FMath::IsNearlyEqual(MinX, Start, 1e-5f) && FMath::IsNearlyEqual(MaxX, End, 1e-5f);
 }
 
-void FRCurveExtendAssetProxy::GetArrayByTimeCyclicInterp(float StartX, float XStep, TArrayView<float>& OutArray, int NumRemoveLastSample)
+void FRCurveExtendAssetProxy::GetArrayByTimeCyclicInterp(float StartX, float XStep, TArrayView<float>& OutArray, int NumRemoveLastSample) const
 {
 	const int32 NumSamples = OutArray.Num();
-	if(Step <= 0.f || Data.Num() <= 0)
+	if(Data.Num() == 1)
 	{
-		FMemory::Memzero(OutArray.GetData(), NumSamples * sizeof(float));
+		for(int i = 0; i < NumSamples; i++)
+			OutArray[i] = Data[0];
 		return;
 	}
 	
-	if(Data.Num() == 1)
+	if(Step <= 0.f || Data.Num() <= 0)
 	{
-		for(int i = 0; i < NumSamples; i++)
-			OutArray[i] = Data[0];
+		FMemory::Memzero(OutArray.GetData(), NumSamples * sizeof(float));
+		return;
 	}
 	
 	StartX = StartX - MinX;
@@ -138,21 +139,76 @@ void FRCurveExtendAssetProxy::GetArrayByTimeCyclicInterp(float StartX, float XSt
 		FMemory::Memzero(OutArray.GetData(), NumSamples * sizeof(float));
 		return;
 	}
-
 	
-	const int32 NumData = Data.Num() - NumRemoveLastSample;
+	const int32 NumData = FMath::Clamp(Data.Num() - NumRemoveLastSample, 1, Data.Num());
+	
+	// Phase is kept in fixed point and already wrapped into [0, NumData) so it never loses precision over long plays
+	const double FixedScale = static_cast<double>(1ull << PhaseFracBits);
+	const uint64 Period = static_cast<uint64>(NumData) << PhaseFracBits;
+	double StartBin = FMath::Fmod(static_cast<double>(StartX) / Step, static_cast<double>(NumData));
+	double BinStep = FMath::Fmod(static_cast<double>(XStep) / Step, static_cast<double>(NumData));
+	if(BinStep < 0.)
+		BinStep += NumData;
+	const uint64 Phase = static_cast<uint64>(StartBin * FixedScale) % Period;
+	const uint64 PhaseStep = static_cast<uint64>(BinStep * FixedScale) % Period;
 	
-	float StartBin = StartX / Step;
-	float BinStep = XStep / Step;
-	for(int i = 0; i < NumSamples; i++)
+	if(FMath::IsPowerOfTwo(NumData))
+		CyclicInterpFixedPoint<true>(Phase, PhaseStep, NumData, OutArray);
+	else
+		CyclicInterpFixedPoint<false>(Phase, PhaseStep, NumData, OutArray);
+}
+
+template <bool bIsPowerOfTwo>
+void FRCurveExtendAssetProxy::CyclicInterpFixedPoint(uint64 Phase, const uint64 PhaseStep, const int32 NumData, TArrayView<float>& OutArray) const
+{
+	const int32 NumSamples = OutArray.Num();
+	const uint64 Period = static_cast<uint64>(NumData) << PhaseFracBits;
+	const uint64 PhaseMask = Period - 1;
+	const int32 IndexMask = NumData - 1;
+	const float FracScale = 1.f / static_cast<float>(1ull << PhaseFracBits);
+	const float* DataPtr = Data.GetData();
+	float* OutData = OutArray.GetData();
+
+	alignas(16) float Lefts[AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER];
+	alignas(16) float Rights[AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER];
+	alignas(16) float Fracs[AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER];
+	
+	auto FetchLane = [&](const int32 Lane)
 	{
-		int32 LeftIndex = FMath::Floor(StartBin);
-		float Percent = StartBin - LeftIndex;
-		LeftIndex = LeftIndex % NumData;
-		const int32 RightIndex = (LeftIndex + 1) % NumData;
-		OutArray[i] = Data[LeftIndex] * (1.0f - Percent) + Data[RightIndex] * Percent;
+		const int32 LeftIndex = static_cast<int32>(Phase >> PhaseFracBits);
+		int32 RightIndex;
+		if constexpr (bIsPowerOfTwo)
+			RightIndex = (LeftIndex + 1) & IndexMask;
+		else
+			RightIndex = LeftIndex + 1 < NumData ? LeftIndex + 1 : 0;
+		
+		Lefts[Lane] = DataPtr[LeftIndex];
+		Rights[Lane] = DataPtr[RightIndex];
+		Fracs[Lane] = static_cast<float>(static_cast<uint32>(Phase & ((1ull << PhaseFracBits) - 1))) * FracScale;
 
-		StartBin += BinStep;
+		Phase += PhaseStep;
+		if constexpr (bIsPowerOfTwo)
+			Phase &= PhaseMask;
+		else
+			Phase = Phase >= Period ? Phase - Period : Phase;
+	};
+
+	const int32 NumVecSamples = NumSamples - NumSamples % AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
+	for(int i = 0; i < NumVecSamples; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
+	{
+		for(int j = 0; j < AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER; j++)
+			FetchLane(j);
+
+		const VectorRegister4Float LeftReg = VectorLoadAligned(Lefts);
+		const VectorRegister4Float RightReg = VectorLoadAligned(Rights);
+		const VectorRegister4Float FracReg = VectorLoadAligned(Fracs);
+		VectorStore(VectorMultiplyAdd(VectorSubtract(RightReg, LeftReg), FracReg, LeftReg), &OutData[i]);
+	}
+
+	for(int i = NumVecSamples; i < NumSamples; i++)
+	{
+		FetchLane(0);
+		OutData[i] = Lefts[0] + (Rights[0] - Lefts[0]) * Fracs[0];
 	}
 }
 
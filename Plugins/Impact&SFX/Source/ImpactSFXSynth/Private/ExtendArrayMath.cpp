@@ -18,6 +18,50 @@ namespace ExtendArrayMath
 	{
 		const int32 SimdMask = 0xFFFFFFFC;
 		const int32 NotSimdMask = 0x00000003;
+
+		/** One euler rotation step of four modals. Modals below ThresholdReg are silenced. Returns the new real parts. */
+		FORCEINLINE VectorRegister4Float ModalEulerStep(float* RealData, float* ImgData, const VectorRegister4Float& PVector,
+														const VectorRegister4Float& QVector, const VectorRegister4Float& ThresholdReg)
+		{
+			VectorRegister4Float RealVectorData = VectorLoadAligned(RealData);
+			VectorRegister4Float ImgVectorData = VectorLoadAligned(ImgData);
+			VectorRegister4Float DecayLowNumReg = VectorAdd(VectorAbs(RealVectorData), VectorAbs(ImgVectorData));
+			DecayLowNumReg = VectorCompareGE(DecayLowNumReg, ThresholdReg);
+			RealVectorData = VectorBitwiseAnd(RealVectorData, DecayLowNumReg);
+			ImgVectorData = VectorBitwiseAnd(ImgVectorData, DecayLowNumReg);
+
+			const VectorRegister4Float RealTempVector = VectorSubtract(VectorMultiply(RealVectorData, PVector), VectorMultiply(ImgVectorData, QVector));
+			VectorRegister4Float ImgTempVector = VectorMultiply(RealVectorData, QVector);
+			ImgTempVector = VectorMultiplyAdd(ImgVectorData, PVector, ImgTempVector);
+					
+			VectorStore(RealTempVector, RealData);
+			VectorStore(ImgTempVector, ImgData);
+			return RealTempVector;
+		}
+
+		/** Ramp P and Q by one step, renormalize them to the target decay and run one euler step with them */
+		FORCEINLINE VectorRegister4Float ModalEulerRampStep(float* RealData, float* ImgData, float* PData, float* QData,
+															const float* PDeltaData, const float* QDeltaData, const float* DecayData,
+															const VectorRegister4Float& EpsilonReg, const VectorRegister4Float& ThresholdReg)
+		{
+			const VectorRegister4Float PVector = VectorAdd(VectorLoadAligned(PData), VectorLoadAligned(PDeltaData));
+			const VectorRegister4Float QVector = VectorAdd(VectorLoadAligned(QData), VectorLoadAligned(QDeltaData));
+			VectorStore(PVector, PData);
+			VectorStore(QVector, QData);
+
+			//A linear ramp between two rotations shrinks |P + iQ| mid-way. Only the angle is ramped, the magnitude is always the target decay.
+			VectorRegister4Float NormReg = VectorMultiplyAdd(PVector, PVector, VectorMultiplyAdd(QVector, QVector, EpsilonReg));
+			NormReg = VectorMultiply(VectorReciprocalSqrtAccurate(NormReg), VectorLoadAligned(DecayData));
+			
+			return ModalEulerStep(RealData, ImgData, VectorMultiply(PVector, NormReg), VectorMultiply(QVector, NormReg), ThresholdReg);
+		}
+
+		FORCEINLINE float HorizontalSum(const VectorRegister4Float& SumVector)
+		{
+			float SumVal[4];
+			VectorStore(SumVector, SumVal);
+			return SumVal[0] + SumVal[1] + SumVal[2] + SumVal[3];
+		}
 	}
 	
 	void ArraySin(TArrayView<float> InValues, TArrayView<float> OutFloatBuffer)
@@ -265,35 +309,159 @@ namespace ExtendArrayMath
 		}
 	}
 
+	void ArrayImpactModalEuler(TArrayView<float> RealBuffer, TArrayView<float> ImgBuffer,
+	                           TArrayView<const float> PBuffer, TArrayView<const float> QBuffer,
+	                           TArrayView<const float> GainBuffer, int32 NumModal, TArrayView<float> OutputBuffer)
+	{
+		CSV_SCOPED_TIMING_STAT(Audio_ExendArrayMatch, ArrayImpactModalEuler);
+		
+		const int32 NumData = RealBuffer.Num();
+		checkf((NumData % AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER) == 0, TEXT("NumModal must be a multiple of register size"))
+		
+		NumModal = NumModal > 0 ? FMath::Min(NumData, NumModal) : NumData;
+		
+		float* RealData = RealBuffer.GetData();
+		float* ImgData = ImgBuffer.GetData();
+		const float* PData = PBuffer.GetData();
+		const float* QData = QBuffer.GetData();
+		const float* GainData = GainBuffer.GetData();
+
+		const int32 NumOutputFrames = OutputBuffer.Num();
+		const VectorRegister4Float ThresholdReg = VectorSet(LOW_THRESH, LOW_THRESH, LOW_THRESH, LOW_THRESH);
+		for(int outFrame = 0; outFrame < NumOutputFrames; outFrame++)
+		{
+			VectorRegister4Float SumVector = VectorZeroFloat();
+			for (int32 i = 0; i < NumModal; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
+			{
+				const VectorRegister4Float RealVector = MathIntrinsics::ModalEulerStep(&RealData[i], &ImgData[i],
+																					 VectorLoadAligned(&PData[i]), VectorLoadAligned(&QData[i]),
+																					 ThresholdReg);
+				SumVector = VectorMultiplyAdd(VectorLoadAligned(&GainData[i]), RealVector, SumVector);
+			}
+
+			OutputBuffer[outFrame] = MathIntrinsics::HorizontalSum(SumVector);
+		}
+	}
+
 	float CalModalEuler(int32 NumModal, float* RealData, float* ImgData, const float* PData, const float* QData, const VectorRegister4Float& ThresholdReg)
 	{
 		VectorRegister4Float SumVector = VectorZeroFloat();
 		
 		for (int32 i = 0; i < NumModal; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
 		{
-			VectorRegister4Float RealVectorData = VectorLoadAligned(&RealData[i]);
-			VectorRegister4Float ImgVectorData = VectorLoadAligned(&ImgData[i]);
-			VectorRegister4Float DecayLowNumReg = VectorAdd(VectorAbs(RealVectorData), VectorAbs(ImgVectorData));
-			DecayLowNumReg = VectorCompareGE(DecayLowNumReg, ThresholdReg);
-			RealVectorData = VectorBitwiseAnd(RealVectorData, DecayLowNumReg);
-			ImgVectorData = VectorBitwiseAnd(ImgVectorData, DecayLowNumReg);
-			
-			VectorRegister4Float PVector = VectorLoadAligned(&PData[i]);
-			VectorRegister4Float QVector = VectorLoadAligned(&QData[i]);
+			const VectorRegister4Float PVector = VectorLoadAligned(&PData[i]);
+			const VectorRegister4Float QVector = VectorLoadAligned(&QData[i]);
+			SumVector = VectorAdd(SumVector, MathIntrinsics::ModalEulerStep(&RealData[i], &ImgData[i], PVector, QVector, ThresholdReg));
+		}
 
-			VectorRegister4Float RealTempVector = VectorSubtract(VectorMultiply(RealVectorData, PVector), VectorMultiply(ImgVectorData, QVector));
-			VectorRegister4Float ImgTempVector = VectorMultiply(RealVectorData, QVector);
-			ImgTempVector = VectorMultiplyAdd(ImgVectorData, PVector, ImgTempVector);
-					
-			VectorStore(RealTempVector, &RealData[i]);
-			VectorStore(ImgTempVector, &ImgData[i]);
+		return MathIntrinsics::HorizontalSum(SumVector);
+	}
+
+	void ArrayImpactModalEulerRamp(TArrayView<float> RealBuffer, TArrayView<float> ImgBuffer,
+	                               TArrayView<float> PBuffer, TArrayView<float> QBuffer,
+	                               TArrayView<const float> PDeltaBuffer, TArrayView<const float> QDeltaBuffer,
+	                               TArrayView<const float> DecayBuffer, int32 NumModal, TArrayView<float> OutputBuffer)
+	{
+		CSV_SCOPED_TIMING_STAT(Audio_ExendArrayMatch, ArrayImpactModalEulerRamp);
+
+		const int32 NumData = RealBuffer.Num();
+		checkf((NumData % AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER) == 0, TEXT("NumModal must be a multiple of register size"))
+
+		NumModal = NumModal > 0 ? FMath::Min(NumData, NumModal) : NumData;
+
+		float* RealData = RealBuffer.GetData();
+		float* ImgData = ImgBuffer.GetData();
+		float* PData = PBuffer.GetData();
+		float* QData = QBuffer.GetData();
+		const float* PDeltaData = PDeltaBuffer.GetData();
+		const float* QDeltaData = QDeltaBuffer.GetData();
+		const float* DecayData = DecayBuffer.GetData();
 
-			SumVector = VectorAdd(SumVector, RealTempVector);
+		const int32 NumOutputFrames = OutputBuffer.Num();
+		const VectorRegister4Float ThresholdReg = VectorSet(LOW_THRESH, LOW_THRESH, LOW_THRESH, LOW_THRESH);
+		//Keeps padded modals with P = Q = 0 away from a division by zero
+		const VectorRegister4Float EpsilonReg = VectorSetFloat1(1e-30f);
+		for(int outFrame = 0; outFrame < NumOutputFrames; outFrame++)
+		{
+			VectorRegister4Float SumVector = VectorZeroFloat();
+			for (int32 i = 0; i < NumModal; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
+			{
+				SumVector = VectorAdd(SumVector, MathIntrinsics::ModalEulerRampStep(&RealData[i], &ImgData[i], &PData[i], &QData[i],
+																				  &PDeltaData[i], &QDeltaData[i], &DecayData[i],
+																				  EpsilonReg, ThresholdReg));
+			}
+
+			OutputBuffer[outFrame] = MathIntrinsics::HorizontalSum(SumVector);
 		}
+	}
 
-		float SumVal[4];
-		VectorStore(SumVector, SumVal);
-		return  SumVal[0] + SumVal[1] + SumVal[2] + SumVal[3];
+	void ArrayImpactModalEulerRamp(TArrayView<float> RealBuffer, TArrayView<float> ImgBuffer,
+	                               TArrayView<float> PBuffer, TArrayView<float> QBuffer,
+	                               TArrayView<const float> PDeltaBuffer, TArrayView<const float> QDeltaBuffer,
+	                               TArrayView<const float> DecayBuffer, TArrayView<const float> GainBuffer,
+	                               int32 NumModal, TArrayView<float> OutputBuffer)
+	{
+		CSV_SCOPED_TIMING_STAT(Audio_ExendArrayMatch, ArrayImpactModalEulerRamp);
+
+		const int32 NumData = RealBuffer.Num();
+		checkf((NumData % AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER) == 0, TEXT("NumModal must be a multiple of register size"))
+
+		NumModal = NumModal > 0 ? FMath::Min(NumData, NumModal) : NumData;
+
+		float* RealData = RealBuffer.GetData();
+		float* ImgData = ImgBuffer.GetData();
+		float* PData = PBuffer.GetData();
+		float* QData = QBuffer.GetData();
+		const float* PDeltaData = PDeltaBuffer.GetData();
+		const float* QDeltaData = QDeltaBuffer.GetData();
+		const float* DecayData = DecayBuffer.GetData();
+		const float* GainData = GainBuffer.GetData();
+
+		const int32 NumOutputFrames = OutputBuffer.Num();
+		const VectorRegister4Float ThresholdReg = VectorSet(LOW_THRESH, LOW_THRESH, LOW_THRESH, LOW_THRESH);
+		const VectorRegister4Float EpsilonReg = VectorSetFloat1(1e-30f);
+		for(int outFrame = 0; outFrame < NumOutputFrames; outFrame++)
+		{
+			VectorRegister4Float SumVector = VectorZeroFloat();
+			for (int32 i = 0; i < NumModal; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
+			{
+				const VectorRegister4Float RealVector = MathIntrinsics::ModalEulerRampStep(&RealData[i], &ImgData[i], &PData[i], &QData[i],
+																						 &PDeltaData[i], &QDeltaData[i], &DecayData[i],
+																						 EpsilonReg, ThresholdReg);
+				SumVector = VectorMultiplyAdd(VectorLoadAligned(&GainData[i]), RealVector, SumVector);
+			}
+
+			OutputBuffer[outFrame] = MathIntrinsics::HorizontalSum(SumVector);
+		}
+	}
+
+	void ArrayEulerRotationCoefs(TArrayView<const float> AngleBuffer, TArrayView<const float> DecayBuffer,
+	                             int32 NumModal, TArrayView<float> OutPBuffer, TArrayView<float> OutQBuffer)
+	{
+		CSV_SCOPED_TIMING_STAT(Audio_ExendArrayMatch, ArrayEulerRotationCoefs);
+
+		const int32 NumData = OutPBuffer.Num();
+		checkf((NumData % AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER) == 0, TEXT("NumModal must be a multiple of register size"))
+
+		NumModal = NumModal > 0 ? FMath::Min(NumData, NumModal) : NumData;
+
+		const float* AngleData = AngleBuffer.GetData();
+		const float* DecayData = DecayBuffer.GetData();
+		float* PData = OutPBuffer.GetData();
+		float* QData = OutQBuffer.GetData();
+
+		for (int32 i = 0; i < NumModal; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
+		{
+			const VectorRegister4Float AngleVector = VectorLoadAligned(&AngleData[i]);
+			const VectorRegister4Float DecayVector = VectorLoadAligned(&DecayData[i]);
+
+			VectorRegister4Float SinVector;
+			VectorRegister4Float CosVector;
+			VectorSinCos(&SinVector, &CosVector, &AngleVector);
+
+			VectorStore(VectorMultiply(CosVector, DecayVector), &PData[i]);
+			VectorStore(VectorMultiply(SinVector, DecayVector), &QData[i]);
+		}
 	}
 
 	float ArrayModalTotalGain(TArrayView<const float> RealBuffer, TArrayView<const float> ImgBuffer, int32 NumModal)
@@ -393,363 +561,51 @@ namespace ExtendArrayMath
 		}
 	}
 
-	void ArrayLinearChirpSynth(TArrayView<const float> TimeValues, const float ChirpRate,
-							  const float Amp, const float Decay,
-							  const float F0, TArrayView<float> OutFloatBuffer)
-	{
-		CSV_SCOPED_TIMING_STAT(Audio_ExendArrayMatch, ArrayChirpSynth);
-
-		const int32 Num = OutFloatBuffer.Num();
-		check(TimeValues.Num() >= Num);
-		
-		const float* TimeValuesData = TimeValues.GetData();
-		float* OutBufferPtr = OutFloatBuffer.GetData();
-		
-		const int32 NumToSimd = Num & MathIntrinsics::SimdMask;
-		const int32 NumNotToSimd = Num & MathIntrinsics::NotSimdMask;
-
-		if (NumToSimd)
-		{
-			VectorRegister4Float AmpVector = VectorLoadFloat1(&Amp);
-			VectorRegister4Float FreqVector = VectorLoadFloat1(&F0);
-			VectorRegister4Float ChirpRateVector = VectorLoadFloat1(&ChirpRate);
-			VectorRegister4Float TwoPi = MakeVectorRegisterFloat(UE_TWO_PI, UE_TWO_PI, UE_TWO_PI, UE_TWO_PI);
-			
-			if(FMath::IsNearlyZero(Decay)) 
-			{ //Don't calculate exp(Decay * t) 
-				VectorRegister4Float DurationVector = VectorLoadFloat1(&TimeValues[0]);
-				
-				for (int32 i = 0; i < NumToSimd; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
-				{
-					VectorRegister4Float TimeVectorData = VectorLoadAligned(&TimeValuesData[i]);
-				
-					VectorRegister4Float VectorChirp = VectorMultiply(TimeVectorData, ChirpRateVector);
-					VectorChirp = VectorAdd(VectorChirp, FreqVector);
-					VectorChirp = VectorMultiply(TimeVectorData, VectorChirp);
-					VectorChirp = VectorSin(VectorMultiply(TwoPi, VectorChirp));
-					
-					VectorChirp = VectorMultiplyAdd(AmpVector, VectorChirp, VectorLoad(&OutBufferPtr[i]));
-					VectorStore(VectorChirp, &OutBufferPtr[i]);
-				}
-			}
-			else
-			{
-				VectorRegister4Float DecayVector = VectorLoadFloat1(&Decay);
-				VectorRegister4Float DurationVector = VectorLoadFloat1(&TimeValues[0]);
-				
-				for (int32 i = 0; i < NumToSimd; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
-				{
-					VectorRegister4Float TimeVectorData = VectorLoadAligned(&TimeValuesData[i]);
-					
-					VectorRegister4Float VectorTemp = VectorMultiply(VectorSubtract(TimeVectorData, DurationVector), DecayVector);
-					VectorTemp = VectorExp(VectorTemp);
-					
-					VectorRegister4Float VectorChirp = VectorMultiply(TimeVectorData, ChirpRateVector);
-					VectorChirp = VectorAdd(VectorChirp, FreqVector);
-					VectorChirp = VectorMultiply(TimeVectorData, VectorChirp);
-					VectorChirp = VectorSin(VectorMultiply(TwoPi, VectorChirp));
-					
-					VectorChirp = VectorMultiply(VectorTemp, VectorChirp);
-				
-					VectorTemp = VectorLoad(&OutBufferPtr[i]);
-					VectorChirp = VectorMultiplyAdd(AmpVector, VectorChirp, VectorTemp);
-					VectorStore(VectorChirp, &OutBufferPtr[i]);
-				}
-			}
-		}
-
-		if (NumNotToSimd)
-		{
-			if(FMath::IsNearlyZero(Decay))
-			{
-				for (int32 i = NumToSimd; i < Num; i++)
-				{
-					float Time = TimeValuesData[i];
-					OutFloatBuffer[i] = OutFloatBuffer[i] + Amp * FMath::Sin(UE_TWO_PI * Time * (F0 + ChirpRate * Time));
-				}
-			}
-			else
-			{
-				const float Duration = TimeValues[0];
-				for (int32 i = NumToSimd; i < Num; i++)
-				{
-					float Time = TimeValuesData[i];
-					OutFloatBuffer[i] = OutFloatBuffer[i] + Amp * FMath::Exp(Decay * (Time - Duration)) * FMath::Sin(UE_TWO_PI * Time * (F0 + ChirpRate * Time));
-				}	
-			}
-		}
-	}
-
-	void ArrayLinearChirpSynthSingle(TArrayView<const float> TimeValues, const float ChirpRate,
-									const float Amp, const float Decay,
-									const float F0, TArrayView<float> OutFloatBuffer)
+	void ArrayChirpPhasorSynth(TArrayView<float> ZRealBuffer, TArrayView<float> ZImgBuffer,
+	                           TArrayView<float> WRealBuffer, TArrayView<float> WImgBuffer,
+	                           TArrayView<const float> RRealBuffer, TArrayView<const float> RImgBuffer,
+	                           int32 NumModal, TArrayView<float> OutFloatBuffer)
 	{
-		CSV_SCOPED_TIMING_STAT(Audio_ExendArrayMatch, ArrayChirpSynthSingle);
+		CSV_SCOPED_TIMING_STAT(Audio_ExendArrayMatch, ArrayChirpPhasorSynth);
 
-		const int32 Num = OutFloatBuffer.Num();
-		check(TimeValues.Num() >= Num);
-		
-		const float* TimeValuesData = TimeValues.GetData();
-		float* OutBufferPtr = OutFloatBuffer.GetData();
-		
-		const int32 NumToSimd = Num & MathIntrinsics::SimdMask;
-		const int32 NumNotToSimd = Num & MathIntrinsics::NotSimdMask;
-
-		if (NumToSimd)
-		{
-			VectorRegister4Float AmpVector = VectorLoadFloat1(&Amp);
-			VectorRegister4Float FreqVector = VectorLoadFloat1(&F0);
-			VectorRegister4Float ChirpRateVector = VectorLoadFloat1(&ChirpRate);
-			VectorRegister4Float TwoPi = MakeVectorRegisterFloat(UE_TWO_PI, UE_TWO_PI, UE_TWO_PI, UE_TWO_PI);
-			
-			if(FMath::IsNearlyZero(Decay)) 
-			{ //Don't calculate exp(Decay * t) 
-				VectorRegister4Float DurationVector = VectorLoadFloat1(&TimeValues[0]);
-				
-				for (int32 i = 0; i < NumToSimd; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
-				{
-					VectorRegister4Float TimeVectorData = VectorLoadAligned(&TimeValuesData[i]);
-				
-					VectorRegister4Float VectorChirp = VectorMultiply(TimeVectorData, ChirpRateVector);
-					VectorChirp = VectorAdd(VectorChirp, FreqVector);
-					VectorChirp = VectorMultiply(TimeVectorData, VectorChirp);
-					VectorChirp = VectorSin(VectorMultiply(TwoPi, VectorChirp));
-					
-					VectorChirp = VectorMultiplyAdd(AmpVector, VectorChirp, VectorLoad(&OutBufferPtr[i]));
-					VectorStore(VectorChirp, &OutBufferPtr[i]);
-				}
-			}
-			else
-			{
-				VectorRegister4Float DecayVector = VectorLoadFloat1(&Decay);
-				VectorRegister4Float DurationVector = VectorLoadFloat1(&TimeValues[0]);
-				
-				for (int32 i = 0; i < NumToSimd; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
-				{
-					VectorRegister4Float TimeVectorData = VectorLoadAligned(&TimeValuesData[i]);
-					
-					VectorRegister4Float VectorTemp = VectorMultiply(VectorSubtract(TimeVectorData, DurationVector), DecayVector);
-					VectorTemp = VectorExp(VectorTemp);
-					
-					VectorRegister4Float VectorChirp = VectorMultiply(TimeVectorData, ChirpRateVector);
-					VectorChirp = VectorAdd(VectorChirp, FreqVector);
-					VectorChirp = VectorMultiply(TimeVectorData, VectorChirp);
-					VectorChirp = VectorSin(VectorMultiply(TwoPi, VectorChirp));
-					
-					VectorChirp = VectorMultiply(VectorTemp, VectorChirp);					
-					VectorStore(VectorMultiply(AmpVector, VectorChirp), &OutBufferPtr[i]);
-				}
-			}
-		}
-
-		if (NumNotToSimd)
-		{
-			if(FMath::IsNearlyZero(Decay))
-			{
-				for (int32 i = NumToSimd; i < Num; i++)
-				{
-					float Time = TimeValuesData[i];
-					OutFloatBuffer[i] = Amp * FMath::Sin(UE_TWO_PI * Time * (F0 + ChirpRate * Time));
-				}
-			}
-			else
-			{
-				const float Duration = TimeValues[0];
-				for (int32 i = NumToSimd; i < Num; i++)
-				{
-					float Time = TimeValuesData[i];
-					OutFloatBuffer[i] = Amp * FMath::Exp(Decay * (Time - Duration)) * FMath::Sin(UE_TWO_PI * Time * (F0 + ChirpRate * Time));
-				}	
-			}
-		}
-	}
+		const int32 NumData = ZRealBuffer.Num();
+		checkf((NumData % AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER) == 0, TEXT("NumModal must be a multiple of register size"))
 
-	void ArraySigmoidChirpSynth(TArrayView<const float> TimeValues, const float ChirpRate, const float Amp,
-								const float Decay, const float F0, const float FRange, const float Bias,
-								TArrayView<float> OutFloatBuffer)
-	{
-		CSV_SCOPED_TIMING_STAT(Audio_ExendArrayMatch, ArraySigmoidChirpSynth);
+		NumModal = NumModal > 0 ? FMath::Min(NumData, NumModal) : NumData;
 
-		const int32 Num = OutFloatBuffer.Num();
-		check(TimeValues.Num() >= Num);
-		
-		const float* TimeValuesData = TimeValues.GetData();
+		float* ZRealData = ZRealBuffer.GetData();
+		float* ZImgData = ZImgBuffer.GetData();
+		float* WRealData = WRealBuffer.GetData();
+		float* WImgData = WImgBuffer.GetData();
+		const float* RRealData = RRealBuffer.GetData();
+		const float* RImgData = RImgBuffer.GetData();
 		float* OutBufferPtr = OutFloatBuffer.GetData();
-		
-		const int32 NumToSimd = Num & MathIntrinsics::SimdMask;
-		const int32 NumNotToSimd = Num & MathIntrinsics::NotSimdMask;
-		if (NumToSimd)
-		{
-			VectorRegister4Float AmpVector = VectorLoadFloat1(&Amp);
-			VectorRegister4Float FreqVector = VectorLoadFloat1(&F0);
-			VectorRegister4Float FRangeVector = VectorLoadFloat1(&FRange);
-			VectorRegister4Float ChirpRateVector = VectorLoadFloat1(&ChirpRate);
-			VectorRegister4Float TwoPi = MakeVectorRegisterFloat(UE_TWO_PI, UE_TWO_PI, UE_TWO_PI, UE_TWO_PI);
-			VectorRegister4Float OneVector = VectorOneFloat();
-			VectorRegister4Float TwoVector = MakeVectorRegisterFloat(2.f, 2.f, 2.f, 2.f);
-			// Disable this until we find a better way to sync phi bias when changing frequency
-			// VectorRegister4Float BiasVector = VectorLoadFloat1(&Bias);
-			
-			if(FMath::IsNearlyZero(Decay)) 
-			{ //Don't calculate exp(Decay * t) 
-				
-				for (int32 i = 0; i < NumToSimd; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
-				{
-					VectorRegister4Float TimeVectorData = VectorLoadAligned(&TimeValuesData[i]);
-					VectorRegister4Float VectorChirp = VectorMultiply(VectorNegate(TimeVectorData), ChirpRateVector);
-					VectorChirp = VectorExp(VectorChirp);
-					VectorChirp = VectorAdd(VectorChirp, OneVector);
-					VectorChirp = VectorDivide(TwoVector, VectorChirp);
-					VectorChirp = VectorSubtract(VectorChirp, OneVector);
-					VectorChirp = VectorMultiply(VectorChirp, FRangeVector);
-					
-					VectorChirp = VectorMultiply(VectorAdd(VectorChirp,FreqVector), TimeVectorData);
-					//VectorChirp = VectorSin(VectorAdd(BiasVector, VectorMultiply(TwoPi, VectorChirp)));
-					VectorChirp = VectorSin(VectorMultiply(TwoPi, VectorChirp));
-					
-					VectorChirp = VectorMultiplyAdd(AmpVector, VectorChirp, VectorLoad(&OutBufferPtr[i]));
-					VectorStore(VectorChirp, &OutBufferPtr[i]);
-				}
-			}
-			else
-			{
-				VectorRegister4Float DurationVector = VectorLoadFloat1(&TimeValues[0]);
-				VectorRegister4Float DecayVector = VectorLoadFloat1(&Decay);
-				
-				for (int32 i = 0; i < NumToSimd; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
-				{
-					VectorRegister4Float TimeVectorData = VectorLoadAligned(&TimeValuesData[i]);
-					VectorRegister4Float VectorChirp = VectorMultiply(VectorNegate(TimeVectorData), ChirpRateVector);
-					VectorChirp = VectorExp(VectorChirp);
-					VectorChirp = VectorAdd(VectorChirp, OneVector);
-					VectorChirp = VectorDivide(TwoVector, VectorChirp);
-					VectorChirp = VectorSubtract(VectorChirp, OneVector);
-					VectorChirp = VectorMultiply(VectorChirp, FRangeVector);
-					
-					VectorChirp = VectorMultiply(VectorAdd(VectorChirp,FreqVector), TimeVectorData);
-					VectorChirp = VectorSin(VectorMultiply(TwoPi, VectorChirp));
 
-					VectorRegister4Float VectorTemp = VectorMultiply(VectorSubtract(TimeVectorData, DurationVector), DecayVector);
-					VectorTemp = VectorExp(VectorTemp);
-					VectorChirp = VectorMultiplyAdd(AmpVector, VectorMultiply(VectorChirp, VectorTemp), VectorLoad(&OutBufferPtr[i]));
-					VectorStore(VectorChirp, &OutBufferPtr[i]);
-				}
-			}
-		}
-
-		if (NumNotToSimd)
+		const int32 NumOutputFrames = OutFloatBuffer.Num();
+		for(int outFrame = 0; outFrame < NumOutputFrames; outFrame++)
 		{
-			if(FMath::IsNearlyZero(Decay))
-			{
-				for (int32 i = NumToSimd; i < Num; i++)
-				{
-					float Time = TimeValuesData[i];
-					float Freq = FRange * (-1.f + 2.0f / (1.0f + FMath::Exp(-Time * ChirpRate)));
-					OutFloatBuffer[i] = OutFloatBuffer[i] + Amp * FMath::Sin(UE_TWO_PI * ((F0 + Freq) * Time));
-				}
-			}
-			else
+			VectorRegister4Float SumVector = VectorZeroFloat();
+			for (int32 i = 0; i < NumModal; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
 			{
-				const float Duration = TimeValues[0];
-				for (int32 i = NumToSimd; i < Num; i++)
-				{
-					float Time = TimeValuesData[i];
-					float Freq = FRange * (-1.f + 2.0f / (1.0f + FMath::Exp(-Time * ChirpRate)));
-					OutFloatBuffer[i] = OutFloatBuffer[i] + Amp * FMath::Exp(Decay * (Time - Duration)) * FMath::Sin(UE_TWO_PI * ((F0 + Freq) * Time));
-				}	
-			}
-		}
-	}
+				const VectorRegister4Float ZReal = VectorLoadAligned(&ZRealData[i]);
+				const VectorRegister4Float ZImg = VectorLoadAligned(&ZImgData[i]);
+				const VectorRegister4Float WReal = VectorLoadAligned(&WRealData[i]);
+				const VectorRegister4Float WImg = VectorLoadAligned(&WImgData[i]);
+				const VectorRegister4Float RReal = VectorLoadAligned(&RRealData[i]);
+				const VectorRegister4Float RImg = VectorLoadAligned(&RImgData[i]);
 
-	void ArrayExponentChirpSynth(TArrayView<const float> TimeValues, const float ChirpRate, const float Amp,
-		const float Decay, const float F0, const float FRange, const float Bias,
-		TArrayView<float> OutFloatBuffer)
-	{
-		CSV_SCOPED_TIMING_STAT(Audio_ExendArrayMatch, ArrayExponentChirpSynth);
+				SumVector = VectorAdd(SumVector, ZImg);
 
-		const int32 Num = OutFloatBuffer.Num();
-		check(TimeValues.Num() >= Num);
-		
-		const float* TimeValuesData = TimeValues.GetData();
-		float* OutBufferPtr = OutFloatBuffer.GetData();
-		
-		const int32 NumToSimd = Num & MathIntrinsics::SimdMask;
-		const int32 NumNotToSimd = Num & MathIntrinsics::NotSimdMask;
-
-		const float DeltaF0Range = (F0 - FRange) * UE_TWO_PI;
-		const float ExpConst = 2.0f * FRange / ChirpRate * UE_TWO_PI;
-		if (NumToSimd)
-		{
-			VectorRegister4Float AmpVector = VectorLoadFloat1(&Amp);
-			VectorRegister4Float DeltaF0Vector = VectorLoadFloat1(&DeltaF0Range);
+				VectorStore(VectorSubtract(VectorMultiply(ZReal, WReal), VectorMultiply(ZImg, WImg)), &ZRealData[i]);
+				VectorStore(VectorMultiplyAdd(ZImg, WReal, VectorMultiply(ZReal, WImg)), &ZImgData[i]);
 
-			VectorRegister4Float ChirpRateVector = VectorLoadFloat1(&ChirpRate);
-			VectorRegister4Float OneVector = VectorOneFloat();
-			VectorRegister4Float ExpConstVector = VectorLoadFloat1(&ExpConst);
-			//Disable this until we find a better and more performance way to sync phi when changing frequency 
-			//VectorRegister4Float BiasVector = VectorLoadFloat1(&Bias);
-			
-			if(FMath::IsNearlyZero(Decay)) 
-			{ //Don't calculate exp(Decay * t)
-				for (int32 i = 0; i < NumToSimd; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
-				{
-					VectorRegister4Float TimeVectorData = VectorLoadAligned(&TimeValuesData[i]);
-					VectorRegister4Float VectorChirp = VectorMultiply(TimeVectorData, ChirpRateVector);
-					VectorChirp = VectorAdd(VectorExp(VectorChirp), OneVector);
-					VectorChirp = VectorMultiply(VectorLog(VectorChirp), ExpConstVector);
-			
-					VectorChirp = VectorAdd(VectorMultiply(DeltaF0Vector, TimeVectorData), VectorChirp);
-					//VectorChirp = VectorSin(VectorAdd(BiasVector, VectorChirp));
-					VectorChirp = VectorSin(VectorChirp);
-			
-					VectorChirp = VectorMultiplyAdd(AmpVector, VectorChirp, VectorLoad(&OutBufferPtr[i]));
-					VectorStore(VectorChirp, &OutBufferPtr[i]);
-				}
+				VectorStore(VectorSubtract(VectorMultiply(WReal, RReal), VectorMultiply(WImg, RImg)), &WRealData[i]);
+				VectorStore(VectorMultiplyAdd(WImg, RReal, VectorMultiply(WReal, RImg)), &WImgData[i]);
 			}
-			else
-			{
-				VectorRegister4Float DurationVector = VectorLoadFloat1(&TimeValues[0]);
-				VectorRegister4Float DecayVector = VectorLoadFloat1(&Decay);
-				
-				for (int32 i = 0; i < NumToSimd; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
-				{
-					VectorRegister4Float TimeVectorData = VectorLoadAligned(&TimeValuesData[i]);
-					VectorRegister4Float VectorChirp = VectorMultiply(TimeVectorData, ChirpRateVector);
-					VectorChirp = VectorAdd(VectorExp(VectorChirp), OneVector);
-					VectorChirp = VectorMultiply(VectorLog(VectorChirp), ExpConstVector);
-					
-					VectorChirp = VectorAdd(VectorMultiply(DeltaF0Vector, TimeVectorData), VectorChirp);
-					VectorChirp = VectorSin(VectorChirp);
 
-					VectorRegister4Float VectorTemp = VectorMultiply(VectorSubtract(TimeVectorData, DurationVector), DecayVector);
-					VectorTemp = VectorExp(VectorTemp);
-					VectorChirp = VectorMultiplyAdd(AmpVector, VectorMultiply(VectorChirp, VectorTemp), VectorLoad(&OutBufferPtr[i]));
-					VectorStore(VectorChirp, &OutBufferPtr[i]);
-				}
-			}
-		}
-
-		if (NumNotToSimd)
-		{
-			if(FMath::IsNearlyZero(Decay))
-			{
-				for (int32 i = NumToSimd; i < Num; i++)
-				{
-					const float Time = TimeValuesData[i];
-					const float PhiSpeed = DeltaF0Range * Time + ExpConst * FMath::Loge(FMath::Exp(Time * ChirpRate) + 1.0f);
-					OutFloatBuffer[i] = OutFloatBuffer[i] + Amp * FMath::Sin(PhiSpeed);
-				}
-			}
-			else
-			{
-				const float Duration = TimeValues[0];
-				for (int32 i = NumToSimd; i < Num; i++)
-				{
-					const float Time = TimeValuesData[i];
-					const float PhiSpeed = DeltaF0Range * Time + ExpConst * FMath::Loge(FMath::Exp(Time * ChirpRate) + 1.0f);
-					OutFloatBuffer[i] = OutFloatBuffer[i] + Amp * FMath::Exp(Decay * (Time - Duration)) * FMath::Sin(PhiSpeed);
-				}	
-			}
+			float SumVal[4];
+			VectorStore(SumVector, SumVal);
+			OutBufferPtr[outFrame] += SumVal[0] + SumVal[1] + SumVal[2] + SumVal[3];
 		}
 	}
 
@@ -866,4 +722,25 @@ namespace ExtendArrayMath
 			}
 		}
 	}
+
+	void ArrayReverseInPlace(TArrayView<float> InValues)
+	{
+		float* Data = InValues.GetData();
+		int32 Left = 0;
+		int32 Right = InValues.Num() - AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
+		while(Left + AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER <= Right)
+		{
+			const VectorRegister4Float LeftVector = VectorLoad(&Data[Left]);
+			const VectorRegister4Float RightVector = VectorLoad(&Data[Right]);
+			VectorStore(VectorSwizzle(RightVector, 3, 2, 1, 0), &Data[Left]);
+			VectorStore(VectorSwizzle(LeftVector, 3, 2, 1, 0), &Data[Right]);
+			Left += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
+			Right -= AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
+		}
+
+		int32 i = Left;
+		int32 j = Right + AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER - 1;
+		while(i < j)
+			Swap(Data[i++], Data[j--]);
+	}
 }
@@ -47,6 +47,18 @@ namespace LBSImpactSFXSynth
 
 		NumFramesTempHold = NumFramesPerBlock + 1;
 		TempBuffer.SetNumUninitialized(NumFramesTempHold);
+
+		CosThetas.SetNumUninitialized(NumModals);
+		SinThetaPhis.SetNumUninitialized(NumModals);
+		for(int i = 0; i < NumModals; i++)
+		{
+			const float Theta = 2.0f * UE_PI * FHRTFModal::Freqs[i] / SamplingRate;
+			CosThetas[i] = FMath::Cos(Theta);
+			SinThetaPhis[i] = FMath::Sin(Theta - FHRTFModal::Phis[i]);
+		}
+
+		//Build the shared table here instead of on the first direction change in the audio render
+		GetDirectionTable();
     }
 
 	void FHRTFModal::SetHeadRadius(const float InRadius)
@@ -195,16 +207,8 @@ namespace LBSImpactSFXSynth
 			InterpolateAmp(true, CurrentAzi, ElevationShift, AmpBufferLeft, Gain);
 			InterpolateAmp(false, CurrentAzi, ElevationShift, AmpBufferRight, Gain);
 			
-			const float AbsCosElev = FMath::Abs(FMath::Cos(CurrentElev));
-			const float DecayLeft = GetDecay(true, CurrentAzi, AbsCosElev);
-			const float DecayRight = GetDecay(false, CurrentAzi, AbsCosElev);
-			
-			float ITDLeft = 0.f;
-			if(CurrentAzi > UE_PI && CurrentAzi < UE_TWO_PI)
-				ITDLeft = GetInterauralTimeDelay(UE_TWO_PI - CurrentAzi, AbsCosElev);			
-			float ITDRight = 0.f;
-			if(CurrentAzi > 0.f && CurrentAzi < UE_PI)
-				ITDRight = GetInterauralTimeDelay(CurrentAzi, AbsCosElev);
+			float DecayLeft, DecayRight, ITDLeft, ITDRight;
+			LookupDirection(CurrentAzi, CurrentElev, DecayLeft, DecayRight, ITDLeft, ITDRight);
 
 			const int32 NewLeftDelay = FMath::RoundToInt32(ITDLeft * SamplingRate);
 			const int32 NewRightDelay = FMath::RoundToInt32(ITDRight * SamplingRate);
@@ -221,24 +225,22 @@ namespace LBSImpactSFXSynth
 				NumRightDelay = FMath::Max(0, NumRightDelay + FMath::Clamp(DeltaRightDelay, -1, 1));
 			}
 			
-			for(int i = 0; i < NumModals; i++)
-			{
-				const float Theta = 2.0f * UE_PI * FHRTFModal::Freqs[i] / SamplingRate;
-				const float CosTheta = FMath::Cos(Theta);
-				const float SinThetaPhi = FMath::Sin(Theta - FHRTFModal::Phis[i]);
-				
-				const float RLeft = FMath::Exp(-DecayLeft / SamplingRate);
-				TwoRCosLeft[i] = 2.0f * RLeft * CosTheta;
-				R2Left = RLeft * RLeft;
-				GainFLeft[i] = AmpBufferLeft[i] * RLeft * SinThetaPhi;
-				GainPhiLeft[i] = AmpBufferLeft[i] * FHRTFModal::SinPhis[i];
-				
-				const float RRight = FMath::Exp(-DecayRight / SamplingRate);
-				TwoRCosRight[i] = 2.0f * RRight * CosTheta;
-				R2Right = RRight * RRight;
-				GainFRight[i] = AmpBufferRight[i] * RRight * SinThetaPhi;
-				GainPhiRight[i] = AmpBufferRight[i] * FHRTFModal::SinPhis[i];
-			}
+			constexpr int32 CopySize = NumModals * sizeof(float);
+			const float RLeft = FMath::Exp(-DecayLeft / SamplingRate);
+			R2Left = RLeft * RLeft;
+			Audio::ArrayMultiplyByConstant(CosThetas, 2.0f * RLeft, TwoRCosLeft);
+			Audio::ArrayMultiplyByConstant(SinThetaPhis, RLeft, GainFLeft);
+			Audio::ArrayMultiplyInPlace(AmpBufferLeft, GainFLeft);
+			FMemory::Memcpy(GainPhiLeft.GetData(), FHRTFModal::SinPhis.GetData(), CopySize);
+			Audio::ArrayMultiplyInPlace(AmpBufferLeft, GainPhiLeft);
+			
+			const float RRight = FMath::Exp(-DecayRight / SamplingRate);
+			R2Right = RRight * RRight;
+			Audio::ArrayMultiplyByConstant(CosThetas, 2.0f * RRight, TwoRCosRight);
+			Audio::ArrayMultiplyByConstant(SinThetaPhis, RRight, GainFRight);
+			Audio::ArrayMultiplyInPlace(AmpBufferRight, GainFRight);
+			FMemory::Memcpy(GainPhiRight.GetData(), FHRTFModal::SinPhis.GetData(), CopySize);
+			Audio::ArrayMultiplyInPlace(AmpBufferRight, GainPhiRight);
 
 			if(FMath::IsNearlyEqual(CurrentElev, Elevation, 1e-3f)				
 				&& NumLeftDelay == NewLeftDelay
@@ -314,6 +316,11 @@ namespace LBSImpactSFXSynth
 	}
 
 	float FHRTFModal::GetInterauralTimeDelay(float Azi, float AbsCosElev)
+	{
+		return HeadRadius * GetITDUnit(Azi, AbsCosElev);
+	}
+	
+	float FHRTFModal::GetITDUnit(float Azi, float AbsCosElev)
 	{
 		if(Azi < 0.f)
 			Azi = Azi + UE_TWO_PI;
@@ -323,7 +330,7 @@ namespace LBSImpactSFXSynth
 		else if(Azi > PI_DIV_TWO)
 			Azi = UE_PI - Azi;
 
-		return HeadRadius * (Azi + FMath::Sin(Azi)) * AbsCosElev / SoundSpeed;
+		return (Azi + FMath::Sin(Azi)) * AbsCosElev / SoundSpeed;
 	}
 	
 	float FHRTFModal::GetDecay(bool bIsLefChannel, float Azi, float AbsCosElev)
@@ -344,6 +351,64 @@ namespace LBSImpactSFXSynth
 		return (FMath::Sin(Azi) * 413.25f + 949.2f * ExtraDecay) * AbsCosElev + 4240.f;
 	}
 
+	const FAlignedFloatBuffer& FHRTFModal::GetDirectionTable()
+	{
+		static const FAlignedFloatBuffer DirectionTable = []()
+		{
+			FAlignedFloatBuffer Table;
+			Table.SetNumUninitialized(NumDirTableElev * NumDirTableAzi * NumDirTableParams);
+			int32 Index = 0;
+			for(int32 ElevIdx = 0; ElevIdx < NumDirTableElev; ElevIdx++)
+			{
+				const float Elev = FMath::Min(ElevIdx * DirTableStep - PI_DIV_TWO, PI_DIV_TWO);
+				const float AbsCosElev = FMath::Abs(FMath::Cos(Elev));
+				for(int32 AziIdx = 0; AziIdx < NumDirTableAzi; AziIdx++, Index += NumDirTableParams)
+				{
+					const float Azi = (AziIdx % (NumDirTableAzi - 1)) * DirTableStep;
+					Table[Index] = GetDecay(true, Azi, AbsCosElev);
+					Table[Index + 1] = GetDecay(false, Azi, AbsCosElev);
+					Table[Index + 2] = (Azi > UE_PI && Azi < UE_TWO_PI) ? GetITDUnit(UE_TWO_PI - Azi, AbsCosElev) : 0.f;
+					Table[Index + 3] = (Azi > 0.f && Azi < UE_PI) ? GetITDUnit(Azi, AbsCosElev) : 0.f;
+				}
+			}
+			return Table;
+		}();
+		
+		return DirectionTable;
+	}
+
+	void FHRTFModal::LookupDirection(const float Azi, const float Elev, float& OutDecayLeft, float& OutDecayRight,
+									 float& OutITDLeft, float& OutITDRight) const
+	{
+		const FAlignedFloatBuffer& Table = GetDirectionTable();
+		
+		const float AziPos = FMath::Clamp(Azi / DirTableStep, 0.f, NumDirTableAzi - 1.f);
+		const int32 AziIdx = FMath::Min(FMath::FloorToInt32(AziPos), NumDirTableAzi - 2);
+		const float AziPercent = AziPos - AziIdx;
+
+		const float ElevPos = FMath::Clamp((Elev + PI_DIV_TWO) / DirTableStep, 0.f, NumDirTableElev - 1.f);
+		const int32 ElevIdx = FMath::Min(FMath::FloorToInt32(ElevPos), NumDirTableElev - 2);
+		const float ElevPercent = ElevPos - ElevIdx;
+
+		const int32 BottomIdx = (ElevIdx * NumDirTableAzi + AziIdx) * NumDirTableParams;
+		const int32 UpIdx = BottomIdx + NumDirTableAzi * NumDirTableParams;
+		const VectorRegister4Float AziAlpha = VectorSetFloat1(AziPercent);
+		const VectorRegister4Float ElevAlpha = VectorSetFloat1(ElevPercent);
+
+		//All 4 parameters are interpolated at once
+		const VectorRegister4Float BottomLeft = VectorLoadAligned(&Table[BottomIdx]);
+		const VectorRegister4Float Bottom = VectorMultiplyAdd(VectorSubtract(VectorLoadAligned(&Table[BottomIdx + NumDirTableParams]), BottomLeft), AziAlpha, BottomLeft);
+		const VectorRegister4Float UpLeft = VectorLoadAligned(&Table[UpIdx]);
+		const VectorRegister4Float Up = VectorMultiplyAdd(VectorSubtract(VectorLoadAligned(&Table[UpIdx + NumDirTableParams]), UpLeft), AziAlpha, UpLeft);
+		
+		float Params[NumDirTableParams];
+		VectorStore(VectorMultiplyAdd(VectorSubtract(Up, Bottom), ElevAlpha, Bottom), Params);
+		OutDecayLeft = Params[0];
+		OutDecayRight = Params[1];
+		OutITDLeft = HeadRadius * Params[2];
+		OutITDRight = HeadRadius * Params[3];
+	}
+	
 	void FHRTFModal::ConvolveModal(FMultichannelBufferView& OutAudio, const TArrayView<const float>& InAudio)
 	{
 		const float* TwoRCosDataLeft = TwoRCosLeft.GetData();
@@ -357,8 +422,7 @@ namespace LBSImpactSFXSynth
 			CirBuffer.Pop(ToPop);
 		CirBuffer.Push(InAudio);
 
-		CirBuffer.Peek(TempBuffer.GetData(), MaxDelaySamples - 1 - NumLeftDelay, NumFramesPerBlock + 1);
-		ConvolveOneChannel(OutAudio[0], TempBuffer, TwoRCosDataLeft, GainFDataLeft, GainPhiDataLeft,
+		ConvolveOneChannel(OutAudio[0], GetDelayedInput(NumLeftDelay), TwoRCosDataLeft, GainFDataLeft, GainPhiDataLeft,
 							OutL1BufferPtr, OutL2BufferPtr,R2Left);
 		
 		const float* TwoRCosDataRight = TwoRCosRight.GetData();
@@ -367,11 +431,23 @@ namespace LBSImpactSFXSynth
 		float* OutR1BufferPtr = Out1DRight.GetData();
 		float* OutR2BufferPtr = Out2DRight.GetData();
 		
-		CirBuffer.Peek(TempBuffer.GetData(), MaxDelaySamples - 1 - NumRightDelay, NumFramesPerBlock + 1);
-		ConvolveOneChannel(OutAudio[1], TempBuffer, TwoRCosDataRight, GainFDataRight, GainPhiDataRight,
+		ConvolveOneChannel(OutAudio[1], GetDelayedInput(NumRightDelay), TwoRCosDataRight, GainFDataRight, GainPhiDataRight,
 							OutR1BufferPtr, OutR2BufferPtr,R2Right);
 	}
 
+	TArrayView<const float> FHRTFModal::GetDelayedInput(const int32 NumDelay)
+	{
+		TArrayView<const float> FirstView;
+		TArrayView<const float> SecondView;
+		CirBuffer.PeekContiguous(MaxDelaySamples - 1 - NumDelay, NumFramesTempHold, FirstView, SecondView);
+		if(SecondView.Num() == 0)
+			return FirstView;
+
+		FMemory::Memcpy(TempBuffer.GetData(), FirstView.GetData(), FirstView.Num() * sizeof(float));
+		FMemory::Memcpy(&TempBuffer[FirstView.Num()], SecondView.GetData(), SecondView.Num() * sizeof(float));
+		return TempBuffer;
+	}
+
 	void FHRTFModal::ConvolveOneChannel(TArrayView<float>& OutAudio, const TArrayView<const float>& InAudio,
 										const float* TwoRCosData,
 										const float* GainFData, const float* GainPhiData, float* OutD1BufferPtr, float* OutD2BufferPtr,
@@ -446,6 +522,251 @@ namespace LBSImpactSFXSynth
 
 }
 
+namespace LBSImpactSFXSynth
+{
+	FHRTFModalBank::FHRTFModalBank(float InSamplingRate, int32 InNumFramesPerBlock, int32 InMaxNumSources)
+		: SamplingRate(InSamplingRate), NumFramesPerBlock(InNumFramesPerBlock), NumFramesDelayed(InNumFramesPerBlock + 1)
+		, MaxNumSources(FMath::Max(1, InMaxNumSources)), NumActiveSources(0)
+	{
+		Sources.SetNum(MaxNumSources);
+		IsSourceUsed.Init(false, MaxNumSources);
+		IsSourceSubmitted.Init(false, MaxNumSources);
+
+		const int32 NumPackedModals = MaxNumSources * FHRTFModal::NumModals;
+		for(FAlignedFloatBuffer* Buffer : { &TwoRCosLeft, &GainFLeft, &GainPhiLeft, &R2Left, &Out1DLeft, &Out2DLeft,
+											&TwoRCosRight, &GainFRight, &GainPhiRight, &R2Right, &Out1DRight, &Out2DRight })
+		{
+			Buffer->SetNumUninitialized(NumPackedModals);
+			FMemory::Memzero(Buffer->GetData(), NumPackedModals * sizeof(float));
+		}
+
+		const int32 NumDelayedFrames = MaxNumSources * NumFramesDelayed;
+		DelayedInLeft.SetNumUninitialized(NumDelayedFrames);
+		DelayedInRight.SetNumUninitialized(NumDelayedFrames);
+		FMemory::Memzero(DelayedInLeft.GetData(), NumDelayedFrames * sizeof(float));
+		FMemory::Memzero(DelayedInRight.GetData(), NumDelayedFrames * sizeof(float));
+	}
+
+	int32 FHRTFModalBank::AddSource()
+	{
+		for(int32 SourceId = 0; SourceId < MaxNumSources; SourceId++)
+		{
+			if(IsSourceUsed[SourceId])
+				continue;
+
+			Sources[SourceId] = MakeUnique<FHRTFModal>(SamplingRate, NumFramesPerBlock);
+			IsSourceUsed[SourceId] = true;
+			IsSourceSubmitted[SourceId] = false;
+			NumActiveSources = FMath::Max(NumActiveSources, SourceId + 1);
+			return SourceId;
+		}
+
+		UE_LOG(LogImpactSFXSynth, Warning, TEXT("FHRTFModalBank::AddSource: The number of sources has reached the max value (%d)!"), MaxNumSources);
+		return INDEX_NONE;
+	}
+
+	void FHRTFModalBank::RemoveSource(const int32 SourceId)
+	{
+		if(!IsSourceUsed.IsValidIndex(SourceId) || !IsSourceUsed[SourceId])
+			return;
+
+		IsSourceUsed[SourceId] = false;
+		IsSourceSubmitted[SourceId] = false;
+		Sources[SourceId].Reset();
+
+		//Zero coefficients and states so this slot doesn't contribute anything to the packed loop
+		const int32 StartIdx = SourceId * FHRTFModal::NumModals;
+		constexpr int32 ResetSize = FHRTFModal::NumModals * sizeof(float);
+		for(FAlignedFloatBuffer* Buffer : { &TwoRCosLeft, &GainFLeft, &GainPhiLeft, &R2Left, &Out1DLeft, &Out2DLeft,
+											&TwoRCosRight, &GainFRight, &GainPhiRight, &R2Right, &Out1DRight, &Out2DRight })
+		{
+			FMemory::Memzero(&(*Buffer)[StartIdx], ResetSize);
+		}
+		
+		while(NumActiveSources > 0 && !IsSourceUsed[NumActiveSources - 1])
+			NumActiveSources--;
+	}
+
+	bool FHRTFModalBank::SetSourceInput(const int32 SourceId, const TArrayView<const float>& InAudio, float Azimuth, float Elevation,
+										const float Gain, const bool bIsAudioEnd)
+	{
+		if(!IsSourceUsed.IsValidIndex(SourceId) || !IsSourceUsed[SourceId])
+		{
+			UE_LOG(LogImpactSFXSynth, Error, TEXT("FHRTFModalBank::SetSourceInput: Invalid source ID (%d)!"), SourceId);
+			return true;
+		}
+
+		if(InAudio.Num() != NumFramesPerBlock)
+		{
+			UE_LOG(LogImpactSFXSynth, Warning, TEXT("FHRTFModalBank::SetSourceInput: The number of input frames != the number of frame per block!"));
+			return true;
+		}
+		
+		if(bIsAudioEnd && IsSourceFinish(SourceId))
+			return true;
+		
+		FHRTFModal* Source = Sources[SourceId].Get();
+		Source->SetHeadRadius(FHRTFModal::GlobalHeadRadius);
+		
+		Azimuth = FMath::Clamp(Azimuth, -360.f, 360.f);
+		Elevation = FMath::Clamp(Elevation, -90.f, 90.f);
+		Source->InitBuffers(Azimuth, Elevation, Gain);
+		PackSourceCoefs(SourceId);
+		PushSourceInput(SourceId, InAudio);
+		
+		Source->bIsFirstFrame = false;
+		IsSourceSubmitted[SourceId] = true;
+		return false;
+	}
+
+	void FHRTFModalBank::PushSourceInput(const int32 SourceId, const TArrayView<const float>& InAudio)
+	{
+		FHRTFModal* Source = Sources[SourceId].Get();
+		TCircularAudioBufferCustom<float>& CirBuffer = Source->CirBuffer;
+		const int32 MaxDelaySamples = Source->MaxDelaySamples;
+		const int32 ToPop = CirBuffer.Num() - MaxDelaySamples;
+		if(ToPop > 0)
+			CirBuffer.Pop(ToPop);
+		
+		if(InAudio.Num() > 0)
+			CirBuffer.Push(InAudio);
+		else
+			CirBuffer.PushZeros(NumFramesPerBlock);
+
+		const int32 DelayedIdx = SourceId * NumFramesDelayed;
+		CirBuffer.Peek(&DelayedInLeft[DelayedIdx], MaxDelaySamples - 1 - Source->NumLeftDelay, NumFramesDelayed);
+		CirBuffer.Peek(&DelayedInRight[DelayedIdx], MaxDelaySamples - 1 - Source->NumRightDelay, NumFramesDelayed);
+	}
+
+	void FHRTFModalBank::PackSourceCoefs(const int32 SourceId)
+	{
+		const FHRTFModal* Source = Sources[SourceId].Get();
+		const int32 StartIdx = SourceId * FHRTFModal::NumModals;
+		constexpr int32 CopySize = FHRTFModal::NumModals * sizeof(float);
+		
+		FMemory::Memcpy(&TwoRCosLeft[StartIdx], Source->TwoRCosLeft.GetData(), CopySize);
+		FMemory::Memcpy(&GainFLeft[StartIdx], Source->GainFLeft.GetData(), CopySize);
+		FMemory::Memcpy(&GainPhiLeft[StartIdx], Source->GainPhiLeft.GetData(), CopySize);
+		
+		FMemory::Memcpy(&TwoRCosRight[StartIdx], Source->TwoRCosRight.GetData(), CopySize);
+		FMemory::Memcpy(&GainFRight[StartIdx], Source->GainFRight.GetData(), CopySize);
+		FMemory::Memcpy(&GainPhiRight[StartIdx], Source->GainPhiRight.GetData(), CopySize);
+		
+		for(int32 i = StartIdx; i < StartIdx + FHRTFModal::NumModals; i++)
+		{
+			R2Left[i] = Source->R2Left;
+			R2Right[i] = Source->R2Right;
+		}
+	}
+
+	bool FHRTFModalBank::IsSourceFinish(const int32 SourceId) const
+	{
+		const int32 StartIdx = SourceId * FHRTFModal::NumModals;
+		VectorRegister4Float SumModalVector = VectorZeroFloat();
+		for(int32 j = StartIdx; j < StartIdx + FHRTFModal::NumModals; j += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
+		{
+			SumModalVector = VectorAdd(VectorAbs(VectorLoadAligned(&Out1DLeft[j])), SumModalVector);
+			SumModalVector = VectorAdd(VectorAbs(VectorLoadAligned(&Out2DLeft[j])), SumModalVector);
+			SumModalVector = VectorAdd(VectorAbs(VectorLoadAligned(&Out1DRight[j])), SumModalVector);
+			SumModalVector = VectorAdd(VectorAbs(VectorLoadAligned(&Out2DRight[j])), SumModalVector);
+		}
+		
+		float SumVal[4];
+		VectorStore(SumModalVector, SumVal);
+		return (SumVal[0] + SumVal[1] + SumVal[2] + SumVal[3]) < STRENGTH_MIN;
+	}
+	
+	void FHRTFModalBank::ProcessBlock(FMultichannelBufferView& OutAudio, const bool bClampOutput)
+	{
+		if(OutAudio.Num() != 2)
+		{
+			UE_LOG(LogImpactSFXSynth, Error, TEXT("FHRTFModalBank::ProcessBlock: the number of output channels must be 2!"));
+			return;
+		}
+
+		const int32 NumOutputFrames = GetMultichannelBufferNumFrames(OutAudio);
+		if(NumOutputFrames != NumFramesPerBlock)
+		{
+			UE_LOG(LogImpactSFXSynth, Warning, TEXT("FHRTFModalBank::ProcessBlock: The number of requested frames != the number of frame per block!"));
+			return;
+		}
+
+		//Sources which are not submitted in this block are fed silence with their last direction.
+		//Their delay lines still advance so the interaural delay tail is played and the resonators ring out.
+		for(int32 SourceId = 0; SourceId < NumActiveSources; SourceId++)
+		{
+			if(IsSourceUsed[SourceId] && !IsSourceSubmitted[SourceId] && !Sources[SourceId]->bIsFirstFrame)
+				PushSourceInput(SourceId, TArrayView<const float>());
+		}
+		
+		ConvolvePackedChannel(OutAudio[0], DelayedInLeft, TwoRCosLeft, GainFLeft, GainPhiLeft, R2Left, Out1DLeft, Out2DLeft);
+		ConvolvePackedChannel(OutAudio[1], DelayedInRight, TwoRCosRight, GainFRight, GainPhiRight, R2Right, Out1DRight, Out2DRight);
+
+		if(bClampOutput)
+		{			
+			for(int32 Channel = 0; Channel < 2; Channel++)
+			{
+				Audio::ArrayClampInPlace(OutAudio[Channel], -1.f, 1.f);
+			}
+		}
+		
+		for(int32 SourceId = 0; SourceId < NumActiveSources; SourceId++)
+			IsSourceSubmitted[SourceId] = false;
+	}
+
+	void FHRTFModalBank::ConvolvePackedChannel(TArrayView<float>& OutAudio, const FAlignedFloatBuffer& DelayedInput,
+											   const FAlignedFloatBuffer& TwoRCos, const FAlignedFloatBuffer& GainF,
+											   const FAlignedFloatBuffer& GainPhi, const FAlignedFloatBuffer& R2,
+											   FAlignedFloatBuffer& Out1D, FAlignedFloatBuffer& Out2D, const float Threshold)
+	{
+		const float* InData = DelayedInput.GetData();
+		const float* TwoRCosData = TwoRCos.GetData();
+		const float* GainFData = GainF.GetData();
+		const float* GainPhiData = GainPhi.GetData();
+		const float* R2Data = R2.GetData();
+		float* OutD1BufferPtr = Out1D.GetData();
+		float* OutD2BufferPtr = Out2D.GetData();
+		
+		VectorRegister4Float ThresholdReg = VectorLoadFloat1(&Threshold);
+		for(int i = 0; i < NumFramesPerBlock; i++)
+		{
+			VectorRegister4Float SumVector = VectorZeroFloat();
+			
+			//All sources are accumulated in the same register so only one horizontal sum is needed per sample
+			for(int32 SourceId = 0, ModalIdx = 0; SourceId < NumActiveSources; SourceId++)
+			{
+				const int32 InIdx = SourceId * NumFramesDelayed + i;
+				VectorRegister4Float InAudioDelayReg = VectorLoadFloat1(&InData[InIdx]);
+				VectorRegister4Float InAudioReg = VectorLoadFloat1(&InData[InIdx + 1]);
+				
+				const int32 EndModalIdx = ModalIdx + FHRTFModal::NumModals;
+				for(; ModalIdx < EndModalIdx; ModalIdx += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
+				{
+					VectorRegister4Float y1 = VectorLoadAligned(&OutD1BufferPtr[ModalIdx]);
+					VectorRegister4Float y2 = VectorLoadAligned(&OutD2BufferPtr[ModalIdx]);
+					VectorRegister4Float DecayLowNumReg = VectorAdd(VectorAbs(y1), VectorAbs(y2));
+					DecayLowNumReg = VectorCompareGE(DecayLowNumReg, ThresholdReg);
+					y1 = VectorBitwiseAnd(y1, DecayLowNumReg);
+					y2 = VectorBitwiseAnd(y2, DecayLowNumReg);
+					
+					VectorStore(y1, &OutD2BufferPtr[ModalIdx]);
+					y1 = VectorMultiply(VectorLoadAligned(&TwoRCosData[ModalIdx]), y1);
+					y2 = VectorMultiply(VectorLoadAligned(&R2Data[ModalIdx]), y2);
+					y1 = VectorSubtract(y1, y2);
+					y1 = VectorMultiplyAdd(VectorLoadAligned(&GainFData[ModalIdx]), InAudioDelayReg, y1);
+					y1 = VectorMultiplyAdd(VectorLoadAligned(&GainPhiData[ModalIdx]), InAudioReg, y1);
+					SumVector = VectorAdd(SumVector, y1);
+					VectorStore(y1, &OutD1BufferPtr[ModalIdx]);
+				}
+			}
+		
+			float SumVal[4];
+			VectorStore(SumVector, SumVal);
+			OutAudio[i] =  SumVal[0] + SumVal[1] + SumVal[2] + SumVal[3];
+		}
+	}
+}
+
 #undef THREE_PI_DIV_TWO
 #undef PI_DIV_TWO
 #undef STRENGTH_MIN
@@ -0,0 +1,110 @@
+﻿// Copyright 2023-2024, Le Binh Son, All Rights Reserved.
+
+#include "HalfBandResampler.h"
+
+namespace LBSImpactSFXSynth
+{
+	const float* FHalfBandFilter::GetEvenTaps()
+	{
+		static const TArray<float> EvenTaps = []()
+		{
+			TArray<float> Taps;
+			Taps.SetNumUninitialized(NumEvenTaps);
+			float Sum = 0.f;
+			for(int32 i = 0; i < NumEvenTaps; i++)
+			{
+				const int32 k = 2 * i;
+				const float Offset = (k - CenterTap) / 2.0f;
+				const float Sinc = FMath::Sin(UE_PI * Offset) / (UE_PI * Offset);
+				const float Window = 0.42f - 0.5f * FMath::Cos(UE_TWO_PI * k / (NumTaps - 1))
+									 + 0.08f * FMath::Cos(2.f * UE_TWO_PI * k / (NumTaps - 1));
+				Taps[i] = Sinc * Window;
+				Sum += Taps[i];
+			}
+
+			//The center tap is 0.5 so the even taps must sum to 0.5 for a unit DC gain
+			for(int32 i = 0; i < NumEvenTaps; i++)
+				Taps[i] *= 0.5f / Sum;
+			return Taps;
+		}();
+
+		return EvenTaps.GetData();
+	}
+
+	FHalfBandDecimator::FHalfBandDecimator()
+	{
+		Reset();
+	}
+
+	void FHalfBandDecimator::Reset()
+	{
+		WorkBuffer.SetNumZeroed(NumHistory, EAllowShrinking::No);
+		FMemory::Memzero(WorkBuffer.GetData(), NumHistory * sizeof(float));
+		Phase = 0;
+	}
+
+	int32 FHalfBandDecimator::ProcessAudio(TArrayView<const float> InAudio, TArrayView<float> OutAudio)
+	{
+		const int32 NumInput = InAudio.Num();
+		if(NumInput <= 0)
+			return 0;
+		
+		//History samples are kept at the start of the work buffer
+		WorkBuffer.SetNumUninitialized(NumHistory + NumInput, EAllowShrinking::No);
+		float* WorkData = WorkBuffer.GetData();
+		FMemory::Memcpy(&WorkData[NumHistory], InAudio.GetData(), NumInput * sizeof(float));
+
+		const float* EvenTaps = FHalfBandFilter::GetEvenTaps();
+		int32 NumOutput = 0;
+		for(int32 i = 1 - Phase; i < NumInput; i += 2)
+		{
+			const float* Newest = &WorkData[NumHistory + i];
+			float Sum = 0.5f * Newest[-FHalfBandFilter::CenterTap];
+			for(int32 j = 0; j < FHalfBandFilter::NumEvenTaps; j++)
+				Sum += EvenTaps[j] * Newest[-2 * j];
+			OutAudio[NumOutput] = Sum;
+			NumOutput++;
+		}
+
+		Phase = (Phase + NumInput) % 2;
+		FMemory::Memmove(WorkData, &WorkData[NumInput], NumHistory * sizeof(float));
+		return NumOutput;
+	}
+
+	FHalfBandInterpolator::FHalfBandInterpolator()
+	{
+		Reset();
+	}
+
+	void FHalfBandInterpolator::Reset()
+	{
+		WorkBuffer.SetNumZeroed(NumHistory, EAllowShrinking::No);
+		FMemory::Memzero(WorkBuffer.GetData(), NumHistory * sizeof(float));
+	}
+
+	void FHalfBandInterpolator::ProcessAudio(TArrayView<const float> InAudio, TArrayView<float> OutAudio)
+	{
+		const int32 NumInput = InAudio.Num();
+		if(NumInput <= 0)
+			return;
+
+		WorkBuffer.SetNumUninitialized(NumHistory + NumInput, EAllowShrinking::No);
+		float* WorkData = WorkBuffer.GetData();
+		FMemory::Memcpy(&WorkData[NumHistory], InAudio.GetData(), NumInput * sizeof(float));
+
+		//Zero stuffing halves the signal power, so both phases are scaled by 2
+		const float* EvenTaps = FHalfBandFilter::GetEvenTaps();
+		constexpr int32 CenterDelay = FHalfBandFilter::CenterTap / 2;
+		for(int32 i = 0; i < NumInput; i++)
+		{
+			const float* Newest = &WorkData[NumHistory + i];
+			float Sum = 0.f;
+			for(int32 j = 0; j < FHalfBandFilter::NumEvenTaps; j++)
+				Sum += EvenTaps[j] * Newest[-j];
+			OutAudio[2 * i] = 2.f * Sum;
+			OutAudio[2 * i + 1] = Newest[-CenterDelay];
+		}
+		
+		FMemory::Memmove(WorkData, &WorkData[NumInput], NumHistory * sizeof(float));
+	}
+}
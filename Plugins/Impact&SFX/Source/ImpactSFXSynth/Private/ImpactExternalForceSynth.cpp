@@ -23,6 +23,8 @@ namespace LBSImpactSFXSynth
 
 		TimeStep = 1.0f / SamplingRate;
 		FrameTime = 0.f;
+		MixedForceBuffers.SetNum(NumOutChannel);
+		MixedForceViews.SetNum(NumOutChannel);
 		
 		if(ModalsParams.IsValid())
 		{
@@ -153,6 +155,44 @@ namespace LBSImpactSFXSynth
 		return false;
 	}
 
+	bool FImpactExternalForceSynth::SynthesizeMultiForces(FMultichannelBufferView& OutAudio, TArrayView<const TArrayView<const float>> InForces,
+														  TArrayView<const float> InForceGains, const FImpactModalObjAssetProxyPtr& ModalsParams,
+														  const float AmplitudeScale, const float DecayScale, const float FreqScale,
+														  const bool bIsForceStop, bool bClampOutput)
+	{
+		if(OutL1Buffer.Num() <= 0 || InForces.Num() <= 0)
+			return true;
+
+		if(NumOutChannel != OutAudio.Num() || (InForceGains.Num() > 0 && InForceGains.Num() != InForces.Num() * NumOutChannel))
+		{
+			UE_LOG(LogImpactSFXSynth, Error, TEXT("FImpactExternalForceSynth::SynthesizeMultiForces: the number of channels or force gains isn't correct!"));
+			return true;
+		}
+
+		int32 NumFrames = GetMultichannelBufferNumFrames(OutAudio);
+		for(const TArrayView<const float>& Force : InForces)
+			NumFrames = FMath::Min(NumFrames, Force.Num());
+
+		for(int32 Channel = 0; Channel < NumOutChannel; Channel++)
+		{
+			FAlignedFloatBuffer& MixedForce = MixedForceBuffers[Channel];
+			MixedForce.SetNumUninitialized(NumFrames, EAllowShrinking::No);
+			FMemory::Memzero(MixedForce.GetData(), NumFrames * sizeof(float));
+			
+			for(int32 i = 0; i < InForces.Num(); i++)
+			{
+				const float Gain = InForceGains.Num() > 0 ? InForceGains[i * NumOutChannel + Channel] : 1.f;
+				if(FMath::IsNearlyZero(Gain))
+					continue;
+				Audio::ArrayMultiplyAddInPlace(InForces[i].Slice(0, NumFrames), Gain, MixedForce);
+			}
+			
+			MixedForceViews[Channel] = TArrayView<const float>(MixedForce.GetData(), NumFrames);
+		}
+
+		return Synthesize(OutAudio, MixedForceViews, ModalsParams, AmplitudeScale, DecayScale, FreqScale, bIsForceStop, bClampOutput);
+	}
+
 	void FImpactExternalForceSynth::ReInitBuffersIfNeeded(const FImpactModalObjAssetProxyPtr& ModalsParamsPtr, const float AmplitudeScale, const float DecayScale, const float FreqScale)
 	{
 		if(ModalsParamsPtr->IsParamChanged() || !FMath::IsNearlyEqual(AmplitudeScale, CurAmpScale, 1e-2)
@@ -69,6 +69,7 @@ namespace LBSImpactSFXSynth
 	{
 		FOperatorSettings Settings;
 		TArray<FOutputDataVertex> OutputAudioVertices;
+		FName NodeName;
 		
 		FTriggerReadRef PlayTrigger;
 		FTriggerReadRef StopTrigger;
@@ -102,6 +103,7 @@ namespace LBSImpactSFXSynth
 
 		FImpactSynthOperator(const FImpactSynthOpArgs& InArgs)
 			: OperatorSettings(InArgs.Settings)
+			, NodeTrace(InArgs.NodeName)
 			, PlayTrigger(InArgs.PlayTrigger)
 			, StopTrigger(InArgs.StopTrigger)
 			, ImpactStrengthScale(InArgs.ImpactStrengthScale)
@@ -251,6 +253,7 @@ namespace LBSImpactSFXSynth
 		void Execute()
 		{
 			METASOUND_TRACE_CPUPROFILER_EVENT_SCOPE(Metasound::FImpactSynthOperator::Execute);
+			IMPACTSFX_TRACE_NODE_SCOPE(NodeTrace);
 
 			SCOPE_CYCLE_COUNTER(STAT_ImpactSynth);
 			
@@ -261,6 +264,10 @@ namespace LBSImpactSFXSynth
 				FMemory::Memzero(OutputBuffer->GetData(), OperatorSettings.GetNumFramesPerBlock() * sizeof(float));
 			
 			ExecuteSubBlocks();
+
+			BlockCounters.NumActiveVoices = bIsPlaying ? 1 : 0;
+			BlockCounters.NumActiveModals = ModalSynth.IsValid() ? ModalSynth->GetNumActiveModals() : 0;
+			NodeTrace.Publish(BlockCounters);
 		}
 		
 #if ENGINE_MINOR_VERSION > 2
@@ -365,7 +372,7 @@ namespace LBSImpactSFXSynth
 													ImpactModalProxy, ModalStartTime->GetSeconds(), ModalDuration->GetSeconds(),
 													*NumModals, GetAmplitudeScaleClamped(), GetDecayScaleClamped(), GetPitchScaleClamped(*PitchShift),
 													StrengthScale, GetDampingRatioClamped(*DampingRatio));
-				
+				BlockCounters.NumVoiceCreations++;
 			}
 
 			const FResidualDataAssetProxyPtr& ResidualDataProxy = (*ResidualData).GetProxy();
@@ -397,6 +404,7 @@ namespace LBSImpactSFXSynth
 														   ResidualDataProxy.ToSharedRef(), PlaySpeed, *ResidualAmplitudeScale, PitchScale,
 														   Seed, StartTime, Duration,
 														   false, StrengthScale);
+				BlockCounters.NumVoiceCreations++;
 			}
 
 			bIsPlaying = ModalSynth.IsValid() || ResidualSynth.IsValid();
@@ -431,6 +439,7 @@ namespace LBSImpactSFXSynth
 			if(bIsEnableResidualSynth)
 			{
 				bIsResidualStop = ResidualSynth->Synthesize(BufferToGenerate, bIsEnableModalSynth, true);
+				BlockCounters.NumResidualFrames += ResidualSynth->GetNumLastSynthesizedFrames();
 				if(bIsResidualStop)
 					ResidualSynth.Reset();
 			}
@@ -458,6 +467,8 @@ namespace LBSImpactSFXSynth
 		}
 		
 		const FOperatorSettings OperatorSettings;
+		FSynthNodeTrace NodeTrace;
+		FSynthBlockCounters BlockCounters;
 		
 		FTriggerReadRef PlayTrigger;
 		FTriggerReadRef StopTrigger;
@@ -516,6 +527,7 @@ namespace LBSImpactSFXSynth
 			{
 				InParams.OperatorSettings,
 				OutputAudioVertices,
+				InParams.Node.GetInstanceName(),
 				Inputs.GetOrConstructDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputTriggerPlay), InParams.OperatorSettings),
 				Inputs.GetOrConstructDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputTriggerStop), InParams.OperatorSettings),
 				Inputs.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputImpactStrengthScale), InParams.OperatorSettings),
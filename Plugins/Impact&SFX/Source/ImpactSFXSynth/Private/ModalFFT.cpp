@@ -51,4 +51,135 @@ namespace LBSImpactSFXSynth
 		
 		return bIsDecayToZero;
 	}
+
+	bool FModalFFTTable::IsBuiltFor(TArrayView<const float> ModalsParams, const FModalMods& InMods) const
+	{
+		return IsValid() && ParamsData == ModalsParams.GetData() && NumParams == ModalsParams.Num()
+				&& Mods.NumModals == InMods.NumModals
+				&& Mods.DecayScale == InMods.DecayScale && Mods.FreqScale == InMods.FreqScale;
+	}
+
+	void FModalFFTTable::Reset()
+	{
+		NumModals = 0;
+		ParamsData = nullptr;
+		NumParams = 0;
+	}
+
+	const TArray<float>& FModalFFT::GetGaussianLUT()
+	{
+		//Row r holds the weights of all adjacent bins when the fractional part of the peak bin is r / GaussianLUTResolution
+		static const TArray<float> GaussianLUT = []()
+		{
+			TArray<float> LUT;
+			LUT.SetNumUninitialized((GaussianLUTResolution + 1) * NumWeights);
+			for(int32 r = 0; r <= GaussianLUTResolution; r++)
+			{
+				const float Frac = static_cast<float>(r) / GaussianLUTResolution;
+				for(int32 k = 0; k < NumWeights; k++)
+				{
+					const float Distance = Frac - (k - NumAdjBin);
+					LUT[r * NumWeights + k] = FMath::Pow(2.f, -Distance * Distance);
+				}
+			}
+			return LUT;
+		}();
+		
+		return GaussianLUT;
+	}
+	
+	void FModalFFT::BuildTable(TArrayView<const float> ModalsParams, const float SamplingRate, const int32 NumFFT,
+							   const int32 NumMagBins, const FModalMods& InMods, FModalFFTTable& OutTable)
+	{
+		const int32 NumStoredModals = ModalsParams.Num() / FModalSynth::NumParamsPerModal;
+		const int32 NumModals = InMods.NumModals > 0 ? FMath::Min(NumStoredModals, InMods.NumModals) : NumStoredModals;
+		OutTable.Reset();
+		if(NumModals <= 0)
+		{
+			UE_LOG(LogImpactSFXSynth, Warning, TEXT("FModalFFT::BuildTable: the number of modals is zero"));
+			return;
+		}
+		
+		const int32 NumPadded = FMath::DivideAndRoundUp(NumModals, AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER) * AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
+		OutTable.Amps.SetNumZeroed(NumPadded, EAllowShrinking::No);
+		OutTable.Decays.SetNumZeroed(NumPadded, EAllowShrinking::No);
+		OutTable.FrameAmps.SetNumZeroed(NumPadded, EAllowShrinking::No);
+		OutTable.StartBins.SetNumUninitialized(NumModals, EAllowShrinking::No);
+		OutTable.NumBins.SetNumUninitialized(NumModals, EAllowShrinking::No);
+		OutTable.Weights.SetNumZeroed(NumModals * NumWeights, EAllowShrinking::No);
+
+		const TArray<float>& GaussianLUT = GetGaussianLUT();
+		const float BinScale = NumFFT / SamplingRate;
+		for(int32 i = 0, j = 0; i < NumModals; i++, j += FModalSynth::NumParamsPerModal)
+		{
+			OutTable.Amps[i] = ModalsParams[j];
+			OutTable.Decays[i] = FMath::Clamp(ModalsParams[j + 1] * InMods.DecayScale, 0.f, FModalSynth::DecayMax);
+			
+			const float Freq = FMath::Clamp(ModalsParams[j + 2] * InMods.FreqScale, FModalSynth::FMin, FModalSynth::FMax);
+			const float BinF =  Freq * BinScale;
+			const int32 Bin = FMath::FloorToInt32(BinF);
+			const int32 LUTRow = FMath::RoundToInt32((BinF - Bin) * GaussianLUTResolution);
+			const int32 StartBin = FMath::Max(0, Bin - NumAdjBin);
+			const int32 EndBin = FMath::Min(NumMagBins, Bin + NumAdjBin + 1);
+			const int32 NumBins = FMath::Max(0, EndBin - StartBin);
+			OutTable.StartBins[i] = StartBin;
+			OutTable.NumBins[i] = NumBins;
+			if(NumBins > 0)
+			{
+				const int32 FirstWeight = LUTRow * NumWeights + StartBin - (Bin - NumAdjBin);
+				FMemory::Memcpy(&OutTable.Weights[i * NumWeights], &GaussianLUT[FirstWeight], NumBins * sizeof(float));
+			}
+		}
+
+		OutTable.ParamsData = ModalsParams.GetData();
+		OutTable.NumParams = ModalsParams.Num();
+		OutTable.Mods = InMods;
+		OutTable.NumModals = NumModals;
+		OutTable.MagScale = NumFFT / 4.0f;
+	}
+
+	bool FModalFFT::GetFFTMag(FModalFFTTable& Table, const float AmplitudeScale, const float Time, TArrayView<float> FFTMagBuffer)
+	{
+		if(!Table.IsValid())
+			return true;
+		
+		const int32 NumPadded = Table.FrameAmps.Num();
+		const float* AmpData = Table.Amps.GetData();
+		const float* DecayData = Table.Decays.GetData();
+		float* FrameAmpData = Table.FrameAmps.GetData();
+		
+		const VectorRegister4Float AmpScaleReg = VectorSetFloat1(AmplitudeScale);
+		const VectorRegister4Float MagScaleReg = VectorSetFloat1(Table.MagScale);
+		const VectorRegister4Float TimeReg = VectorSetFloat1(-Time);
+		const VectorRegister4Float ZeroReg = VectorZeroFloat();
+		const VectorRegister4Float OneReg = VectorOneFloat();
+		for(int32 i = 0; i < NumPadded; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
+		{
+			VectorRegister4Float AmpReg = VectorMultiply(VectorLoad(&AmpData[i]), AmpScaleReg);
+			AmpReg = VectorMin(VectorMax(AmpReg, ZeroReg), OneReg);
+			
+			const VectorRegister4Float DecayReg = VectorExp(VectorMultiply(VectorLoad(&DecayData[i]), TimeReg));
+			VectorStore(VectorMultiply(VectorMultiply(AmpReg, DecayReg), MagScaleReg), &FrameAmpData[i]);
+		}
+
+		bool bIsDecayToZero = true;
+		const int32* StartBinData = Table.StartBins.GetData();
+		const int32* NumBinData = Table.NumBins.GetData();
+		const float* WeightData = Table.Weights.GetData();
+		float* MagData = FFTMagBuffer.GetData();
+		for(int32 i = 0; i < Table.NumModals; i++)
+		{
+			const float TotalAmp = FrameAmpData[i];
+			if(TotalAmp < 5e-2f)
+				continue;
+			bIsDecayToZero = false;
+
+			float* MagBins = &MagData[StartBinData[i]];
+			const float* ModalWeights = &WeightData[i * NumWeights];
+			for(int32 j = 0; j < NumBinData[i]; j++)
+				MagBins[j] += TotalAmp * ModalWeights[j];
+		}
+		
+		return bIsDecayToZero;
+	}
 }
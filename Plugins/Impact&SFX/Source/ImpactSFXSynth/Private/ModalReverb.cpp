@@ -3,6 +3,7 @@
 #include "ModalReverb.h"
 #include "ImpactSFXSynthLog.h"
 #include "ResidualData.h"
+#include "DSP/FloatArrayMath.h"
 
 #define STRENGTH_MIN (0.001f)
 
@@ -10,15 +11,16 @@ namespace LBSImpactSFXSynth
 {
 	FModalReverb::FModalReverb(const float InSamplingRate, const FModalReverbParams& InReverbParams,
 							   const int32 NumModalsLow, const int32 NumModalsMid, const int32 NumModalsHigh,
-	                           const float InAbsorption, const float InRoomSize, const float InOpenFactor, const float InGain)
-	: SamplingRate(InSamplingRate), LastInAudioSample(0.f)
+	                           const float InAbsorption, const float InRoomSize, const float InOpenFactor, const float InGain,
+	                           const bool bInIsMultirate)
+	: SamplingRate(InSamplingRate)
 	{
 		ReverbParams = InReverbParams;
 		SetEnvCoefs(InAbsorption, InRoomSize, InOpenFactor, InGain);
 		
 		TimeStep = 1.0f / SamplingRate;
 		
-		InitBuffers(NumModalsLow, NumModalsMid, NumModalsHigh);
+		InitBuffers(NumModalsLow, NumModalsMid, NumModalsHigh, bInIsMultirate);
 	}
 
 	void FModalReverb::SetEnvCoefs(const float InAbsorption, const float InRoomSize, const float InOpenRoomFactor, const float InGain)
@@ -39,66 +41,86 @@ namespace LBSImpactSFXSynth
 		OutDoorMinDecay = OpenFactor;
 	}
 
-	void FModalReverb::InitBuffers(const int32 NumModalsLow, const int32 NumModalsMid, const int32 NumModalsHigh)
+	void FModalReverb::InitBuffers(const int32 NumModalsLow, const int32 NumModalsMid, const int32 NumModalsHigh, const bool bIsMultirate)
 	{
-		MaxNumModals = FMath::Clamp(NumModalsLow + NumModalsMid + NumModalsHigh, AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER, MaxSupportNumModals);
-		//Make sure NumModals is a multiplier of Vector register so all modals can run in SIMD when synthesizing
-		const int32 RemVec = MaxNumModals % AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
-		if(RemVec > 0)
-			MaxNumModals = MaxNumModals + (AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER - RemVec);
-		CurrentNumModals = MaxNumModals;
-		const int32 ClearSize = MaxNumModals * sizeof(float);
-		
-		OutL1Buffer.SetNumUninitialized(MaxNumModals);
-		FMemory::Memzero(OutL1Buffer.GetData(), ClearSize);
-		OutL2Buffer.SetNumUninitialized(MaxNumModals);
-		FMemory::Memzero(OutL2Buffer.GetData(), ClearSize);
-
-		FreqBuffer.SetNumUninitialized(MaxNumModals);
-		PhaseBuffer.SetNumUninitialized(MaxNumModals);
-		GainBuffer.SetNumUninitialized(MaxNumModals);
-		TwoDecayCosBuffer.SetNumUninitialized(MaxNumModals);
-		DecaySqrBuffer.SetNumUninitialized(MaxNumModals);
-		Activation1DBuffer.SetNumUninitialized(MaxNumModals);
-		ActivationBuffer.SetNumUninitialized(MaxNumModals);
+		const int32 NumLow = FMath::Clamp(NumModalsLow, 0, MaxSupportNumModals);
+		const int32 NumMid = FMath::Clamp(NumModalsMid, 0, MaxSupportNumModals - NumLow);
+		int32 NumHigh = FMath::Clamp(NumModalsHigh, 0, MaxSupportNumModals - NumLow - NumMid);
+		if(NumLow + NumMid + NumHigh <= 0)
+			NumHigh = AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
 		
-		InitBufferBand(LowBandFMin, LowBandFMax, NumModalsLow, 0, 1.0f);
-		InitBufferBand(MidBandFMin, MidBandFMax, NumModalsMid, NumModalsLow, 1.0f);
-		const int32 BufferIndex = NumModalsLow + NumModalsMid;
+		InitBand(Bands[0], bIsMultirate ? GetBandDecimation(LowBandFMax) : 1, LowBandFMin, LowBandFMax, NumLow, 1.0f);
+		InitBand(Bands[1], bIsMultirate ? GetBandDecimation(MidBandFMax) : 1, MidBandFMin, MidBandFMax, NumMid, 1.0f);
 		//Due to its wide frequency range, need to double the high band gain to balance its power. 
-		InitBufferBand(HighBandFMin, HighBandFMax, MaxNumModals - BufferIndex, BufferIndex, 2.0f);
+		InitBand(Bands[2], 1, HighBandFMin, HighBandFMax, NumHigh, 2.0f);
+	}
+
+	int32 FModalReverb::GetBandDecimation(const float FMax) const
+	{
+		//Each stage halves the rate, so the next stage has a passband edge at half of the current one
+		int32 Decimation = 1;
+		while(Decimation < MaxBandDecimation && FMax <= FHalfBandFilter::PassbandRatio * SamplingRate / Decimation)
+			Decimation *= 2;
+		return Decimation;
 	}
 
-	void FModalReverb::InitBufferBand(const float FMin, const float FMax, const int32 NumModals,
-		const float BufferIndex, const float GainScale)
+	void FModalReverb::InitBand(FModalReverbBand& Band, const int32 DecimationFactor, const float FMin, const float FMax,
+								const int32 NumModals, const float GainScale)
 	{
+		Band.DecimationFactor = DecimationFactor;
+		Band.TimeStep = TimeStep * DecimationFactor;
+		Band.LastInAudioSample = 0.f;
+		
+		//Make sure NumModals is a multiplier of Vector register so all modals can run in SIMD when synthesizing
+		Band.MaxNumModals = FMath::DivideAndRoundUp(NumModals, AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER) * AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
+		Band.CurrentNumModals = Band.MaxNumModals;
+		
+		//Padded modals have zero gain so they stay silent
+		Band.FreqBuffer.SetNumZeroed(Band.MaxNumModals);
+		Band.PhaseBuffer.SetNumZeroed(Band.MaxNumModals);
+		Band.GainBuffer.SetNumZeroed(Band.MaxNumModals);
+		Band.TwoDecayCosBuffer.SetNumZeroed(Band.MaxNumModals);
+		Band.DecaySqrBuffer.SetNumZeroed(Band.MaxNumModals);
+		Band.Activation1DBuffer.SetNumZeroed(Band.MaxNumModals);
+		Band.ActivationBuffer.SetNumZeroed(Band.MaxNumModals);
+		Band.OutL1Buffer.SetNumZeroed(Band.MaxNumModals);
+		Band.OutL2Buffer.SetNumZeroed(Band.MaxNumModals);
+
+		const int32 NumStages = FMath::FloorLog2(static_cast<uint32>(DecimationFactor));
+		Band.Decimators.SetNum(NumStages);
+		Band.Interpolators.SetNum(NumStages);
+		//Cover the samples a decimator may hold back so a full block can always be mixed
+		Band.NumPendingFrames = DecimationFactor - 1;
+		Band.PendingBuffer.SetNumZeroed(Band.NumPendingFrames);
+		
 		const float ErbMin = UResidualData::Freq2Erb(FMin);
 		const float ErbMax = UResidualData::Freq2Erb(FMax);
 		const float ErbStep = (ErbMax - ErbMin) / (FMath::Max(1, NumModals - 1));
 		
-		const float PiTime = UE_TWO_PI * TimeStep;
-		const int32 EndIdx = NumModals + BufferIndex;
-		for(int i = BufferIndex, step = 0; i < EndIdx; i++, step++)
+		const float PiTime = UE_TWO_PI * Band.TimeStep;
+		//A resonator at a lower rate sees fewer excitation samples, so its gain is scaled up by the same factor
+		const float BandGainScale = GainScale * DecimationFactor;
+		for(int i = 0; i < NumModals; i++)
 		{
-			const float Freq = UResidualData::Erb2Freq(step * ErbStep + ErbMin);
+			const float Freq = UResidualData::Erb2Freq(i * ErbStep + ErbMin);
 			const float FreqScale = Freq / 1000.f;
 			const float FreqScaleSqr = FreqScale * FreqScale;
 			const float Decay = GetDecayFromFreqScale(FreqScale, FreqScaleSqr);
-			const float Amp = GetAmpFromFreqScale(FreqScale, FreqScaleSqr) * GainScale;
+			const float Amp = GetAmpFromFreqScale(FreqScale, FreqScaleSqr) * BandGainScale;
 
 			const float Angle = PiTime * Freq;
 			
 			// const float Phi = FMath::FRand() * UE_TWO_PI;
 			const float Phi = Freq * PiTime * 2.0f;
 			
-			const float DecayRate = FMath::Exp(-Decay * TimeStep);
-			FreqBuffer[i] = Freq;
-			PhaseBuffer[i] = Phi;
-			TwoDecayCosBuffer[i] = 2.f * DecayRate * FMath::Cos(Angle);
-			GainBuffer[i] = Amp;
-			DecaySqrBuffer[i] = DecayRate * DecayRate;
-			Activation1DBuffer[i] = Amp * DecayRate * FMath::Sin(Angle - Phi);
-			ActivationBuffer[i] = Amp * FMath::Sin(Phi);
+			const float DecayRate = FMath::Exp(-Decay * Band.TimeStep);
+			Band.FreqBuffer[i] = Freq;
+			Band.PhaseBuffer[i] = Phi;
+			Band.TwoDecayCosBuffer[i] = 2.f * DecayRate * FMath::Cos(Angle);
+			Band.GainBuffer[i] = Amp;
+			Band.DecaySqrBuffer[i] = DecayRate * DecayRate;
+			Band.Activation1DBuffer[i] = Amp * DecayRate * FMath::Sin(Angle - Phi);
+			Band.ActivationBuffer[i] = Amp * FMath::Sin(Phi);
 		}
 	}
 
@@ -118,7 +140,7 @@ namespace LBSImpactSFXSynth
 									const float InAbsorption, const float InRoomSize, const float InOpenRoomFactor,
 									const float InGain, bool bIsInAudioStop)
 	{
-		if(OutL1Buffer.Num() <= 0 || InAudio.Num() <= 0)
+		if(InAudio.Num() <= 0)
 			return true;
 
 		if(InAbsorption >= NoReverbAbsorption)
@@ -137,11 +159,18 @@ namespace LBSImpactSFXSynth
 			return bIsInAudioStop;
 
 		SetEnvCoefs(InAbsorption, InRoomSize, InOpenRoomFactor, InGain);
-		ScatterFreqAndPhase();
-		GetNumUsedModals(bIsInAudioStop);
-		if(CurrentNumModals <= 0)
+		int32 TotalNumModals = 0;
+		for(FModalReverbBand& Band : Bands)
 		{
-			LastInAudioSample = 0.f;
+			ScatterFreqAndPhase(Band);
+			GetNumUsedModals(Band, bIsInAudioStop);
+			TotalNumModals += Band.CurrentNumModals;
+		}
+		
+		if(TotalNumModals <= 0)
+		{
+			for(FModalReverbBand& Band : Bands)
+				Band.LastInAudioSample = 0.f;
 			return true;
 		}
 		
@@ -149,14 +178,14 @@ namespace LBSImpactSFXSynth
 		return false;
 	}
 
-	void FModalReverb::GetNumUsedModals(const bool bIsForceStop)
+	void FModalReverb::GetNumUsedModals(FModalReverbBand& Band, const bool bIsForceStop)
 	{
 		if(bIsForceStop)
 		{
-			const float* OutL1BufferPtr = OutL1Buffer.GetData();
-			const float* OutL2BufferPtr = OutL2Buffer.GetData();
+			const float* OutL1BufferPtr = Band.OutL1Buffer.GetData();
+			const float* OutL2BufferPtr = Band.OutL2Buffer.GetData();
 
-			int32 j = CurrentNumModals - AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
+			int32 j = Band.CurrentNumModals - AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
 			for(; j > -1; j -= AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
 			{
 				VectorRegister4Float y1 = VectorLoadAligned(&OutL1BufferPtr[j]);
@@ -169,74 +198,139 @@ namespace LBSImpactSFXSynth
 				if(SampleSum > STRENGTH_MIN)
 					break;
 			}
-			CurrentNumModals = j + AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
+			Band.CurrentNumModals = j + AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
 			return;
 		}
 		
-		CurrentNumModals = TwoDecayCosBuffer.Num(); 
+		Band.CurrentNumModals = Band.MaxNumModals; 
 	}
 
-	void FModalReverb::ScatterFreqAndPhase()
+	void FModalReverb::ScatterFreqAndPhase(FModalReverbBand& Band)
 	{
-		const float PiTime = UE_TWO_PI * TimeStep;
-		for(int i = 0; i < CurrentNumModals; i += 1)
+		const float PiTime = UE_TWO_PI * Band.TimeStep;
+		for(int i = 0; i < Band.CurrentNumModals; i += 1)
 		{
-			const float F0 = FreqBuffer[i];
+			const float F0 = Band.FreqBuffer[i];
 			const float Freq = F0 * (1.0f + (FMath::FRand() - 0.5f) * ReverbParams.FreqScatterScale);
 			const float FreqScale = Freq / 1000.f;
 			const float FreqScaleSqr = FreqScale * FreqScale;
 			const float Decay = GetDecayFromFreqScale(FreqScale, FreqScaleSqr);
-			const float Phi = PhaseBuffer[i] + FMath::FRand() * UE_PI * ReverbParams.PhaseScatterScale;
+			const float Phi = Band.PhaseBuffer[i] + FMath::FRand() * UE_PI * ReverbParams.PhaseScatterScale;
 			const float Angle = PiTime * Freq;
-			const float DecayRate = FMath::Exp(-Decay * TimeStep);
+			const float DecayRate = FMath::Exp(-Decay * Band.TimeStep);
 
-			TwoDecayCosBuffer[i] = 2.0f * DecayRate * FMath::Cos(Angle);
-			Activation1DBuffer[i] = GainBuffer[i] * DecayRate * FMath::Sin(Angle - Phi);
-			ActivationBuffer[i] = GainBuffer[i] * FMath::Sin(Phi);
-			DecaySqrBuffer[i] = DecayRate * DecayRate;
+			Band.TwoDecayCosBuffer[i] = 2.0f * DecayRate * FMath::Cos(Angle);
+			Band.Activation1DBuffer[i] = Band.GainBuffer[i] * DecayRate * FMath::Sin(Angle - Phi);
+			Band.ActivationBuffer[i] = Band.GainBuffer[i] * FMath::Sin(Phi);
+			Band.DecaySqrBuffer[i] = DecayRate * DecayRate;
 		}
 	}
 
 	void FModalReverb::ProcessAudio(TArrayView<float>& OutAudio, const TArrayView<const float>& InAudio,
 	                                     const int32 NumOutputFrames)
 	{
-		const float* TwoRCosData = TwoDecayCosBuffer.GetData();
-		const float* R2Data = DecaySqrBuffer.GetData();
-		const float* GainFData = Activation1DBuffer.GetData();
-		const float* GainCData = ActivationBuffer.GetData();
-		float* OutL1BufferPtr = OutL1Buffer.GetData();
-		float* OutL2BufferPtr = OutL2Buffer.GetData();
+		TArrayView<float> OutView = OutAudio.Slice(0, NumOutputFrames);
+		TArrayView<const float> InView = InAudio.Slice(0, NumOutputFrames);
+		FMemory::Memzero(OutView.GetData(), NumOutputFrames * sizeof(float));
+		
+		for(FModalReverbBand& Band : Bands)
+		{
+			if(Band.MaxNumModals > 0)
+				ProcessBand(Band, OutView, InView);
+		}
+	}
+
+	void FModalReverb::ProcessBand(FModalReverbBand& Band, TArrayView<float> OutAudio, TArrayView<const float> InAudio)
+	{
+		const int32 NumOutputFrames = OutAudio.Num();
+		Band.OutBuffer.SetNumUninitialized(NumOutputFrames, EAllowShrinking::No);
+		if(Band.DecimationFactor <= 1)
+		{
+			TArrayView<float> BandOut = TArrayView<float>(Band.OutBuffer.GetData(), NumOutputFrames);
+			ProcessModals(Band, BandOut, InAudio);
+			Audio::ArrayAddInPlace(BandOut, OutAudio);
+			return;
+		}
+
+		ResampleBuffers[0].SetNumUninitialized(NumOutputFrames, EAllowShrinking::No);
+		ResampleBuffers[1].SetNumUninitialized(NumOutputFrames, EAllowShrinking::No);
+		
+		TArrayView<const float> StageIn = InAudio;
+		for(int32 i = 0; i < Band.Decimators.Num(); i++)
+		{
+			FAlignedFloatBuffer& StageBuffer = ResampleBuffers[i % 2];
+			const int32 NumStageOut = Band.Decimators[i].ProcessAudio(StageIn, StageBuffer);
+			StageIn = TArrayView<const float>(StageBuffer.GetData(), NumStageOut);
+		}
+
+		const int32 NumBandFrames = StageIn.Num();
+		TArrayView<float> BandOut = TArrayView<float>(Band.OutBuffer.GetData(), NumBandFrames);
+		ProcessModals(Band, BandOut, StageIn);
+
+		//The last stage writes straight after the samples which are still pending
+		const int32 NumNewFrames = NumBandFrames * Band.DecimationFactor;
+		Band.PendingBuffer.SetNumUninitialized(Band.NumPendingFrames + NumNewFrames, EAllowShrinking::No);
+		TArrayView<const float> UpIn = BandOut;
+		const int32 LastStage = Band.Interpolators.Num() - 1;
+		for(int32 i = 0; i <= LastStage; i++)
+		{
+			const int32 NumStageOut = UpIn.Num() * 2;
+			float* StageData = i == LastStage ? Band.PendingBuffer.GetData() + Band.NumPendingFrames : ResampleBuffers[i % 2].GetData();
+			Band.Interpolators[i].ProcessAudio(UpIn, TArrayView<float>(StageData, NumStageOut));
+			UpIn = TArrayView<const float>(StageData, NumStageOut);
+		}
+		Band.NumPendingFrames += NumNewFrames;
+
+		const int32 NumMixFrames = FMath::Min(NumOutputFrames, Band.NumPendingFrames);
+		Audio::ArrayAddInPlace(TArrayView<const float>(Band.PendingBuffer.GetData(), NumMixFrames), OutAudio.Slice(0, NumMixFrames));
+		Band.NumPendingFrames -= NumMixFrames;
+		FMemory::Memmove(Band.PendingBuffer.GetData(), Band.PendingBuffer.GetData() + NumMixFrames, Band.NumPendingFrames * sizeof(float));
+	}
+
+	void FModalReverb::ProcessModals(FModalReverbBand& Band, TArrayView<float> OutAudio, TArrayView<const float> InAudio) const
+	{
+		const int32 NumFrames = InAudio.Num();
+		if(NumFrames <= 0)
+			return;
+		
+		const float* TwoRCosData = Band.TwoDecayCosBuffer.GetData();
+		const float* R2Data = Band.DecaySqrBuffer.GetData();
+		const float* GainFData = Band.Activation1DBuffer.GetData();
+		const float* GainCData = Band.ActivationBuffer.GetData();
+		float* OutL1BufferPtr = Band.OutL1Buffer.GetData();
+		float* OutL2BufferPtr = Band.OutL2Buffer.GetData();
+		const int32 NumModals = Band.CurrentNumModals;
 
 		const VectorRegister4Float ThresholdReg = VectorSet(1e-5f, 1e-5f, 1e-5f, 1e-5f);
-		const float NewLastSample = InAudio[NumOutputFrames - 1];
+		const float NewLastSample = InAudio[NumFrames - 1];
 		
 		{ // First frame need to use the last in audio sample
-			const VectorRegister4Float InAudio1DReg = VectorLoadFloat1(&LastInAudioSample);
+			const VectorRegister4Float InAudio1DReg = VectorLoadFloat1(&Band.LastInAudioSample);
 			const VectorRegister4Float InAudioReg = VectorLoadFloat1(&InAudio[0]);
 			OutAudio[0] = ProcessOneSample(TwoRCosData, R2Data, GainFData, GainCData,
-											OutL1BufferPtr, OutL2BufferPtr, ThresholdReg,
+											OutL1BufferPtr, OutL2BufferPtr, NumModals, ThresholdReg,
 											InAudio1DReg, InAudioReg);
 		}
 		
-		for(int i = 1; i < NumOutputFrames; i++)
+		for(int i = 1; i < NumFrames; i++)
 		{
 			const VectorRegister4Float InAudio1DReg = VectorLoadFloat1(&InAudio[i-1]);
 			const VectorRegister4Float InAudioReg = VectorLoadFloat1(&InAudio[i]);
 			OutAudio[i] = ProcessOneSample(TwoRCosData, R2Data, GainFData, GainCData,
-											OutL1BufferPtr, OutL2BufferPtr, ThresholdReg,
+											OutL1BufferPtr, OutL2BufferPtr, NumModals, ThresholdReg,
 											InAudio1DReg, InAudioReg);
 		}
 		
-		LastInAudioSample = NewLastSample;
+		Band.LastInAudioSample = NewLastSample;
 	}
 
 	float FModalReverb::ProcessOneSample(const float* TwoRCosData, const float* R2Data, const float* GainFData,
-										const float* GainCData, float* OutL1BufferPtr, float* OutL2BufferPtr,
+										const float* GainCData, float* OutL1BufferPtr, float* OutL2BufferPtr, const int32 NumModals,
 										const VectorRegister4Float& ThresholdReg, const VectorRegister4Float& InAudio1DReg,
 										const VectorRegister4Float& InAudioReg) const
 	{
 		VectorRegister4Float SumModalVector = VectorZeroFloat();
-		for(int j = 0; j < CurrentNumModals; j += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
+		for(int j = 0; j < NumModals; j += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
 		{
 			VectorRegister4Float y1 = VectorLoadAligned(&OutL1BufferPtr[j]);
 			VectorRegister4Float y2 = VectorLoadAligned(&OutL2BufferPtr[j]);
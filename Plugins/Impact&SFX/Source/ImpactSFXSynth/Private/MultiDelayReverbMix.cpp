@@ -8,33 +8,32 @@ namespace LBSImpactSFXSynth
 {
 	
 	FMultiDelayReverbMix::FMultiDelayReverbMix(float InSamplingRate, float InGain, float InMinDelay, float InMaxDelay)
-	: SamplingRate(InSamplingRate)
+	: SamplingRate(InSamplingRate), WriteIndex(0), IndexMask(0)
+	{
+		Init(InGain, InMinDelay, InMaxDelay);
+	}
+
+	void FMultiDelayReverbMix::Init(float InGain, float InMinDelay, float InMaxDelay)
 	{
 		SetDecayGain(InGain);
-		const int32 MinDelaySample = FMath::FloorToInt32(InMinDelay * InSamplingRate);
-		const int32 MaxDelaySample = FMath::CeilToInt32(InMaxDelay * InSamplingRate);
+		const int32 MinDelaySample = FMath::Max(1, FMath::FloorToInt32(InMinDelay * SamplingRate));
+		const int32 MaxDelaySample = FMath::Max(MinDelaySample, FMath::CeilToInt32(InMaxDelay * SamplingRate));
 		const int32 DelayStep = (MaxDelaySample - MinDelaySample) / NumChannels;
-		ChannelDelaySample.Empty(NumChannels);
-		DelayBuffers.Empty(NumChannels);
-		ChannelWriteIndex.Empty(NumChannels);
-		
-		ChannelDelaySample.Add(MinDelaySample);
-		FAlignedFloatBuffer FirstBuffer = FAlignedFloatBuffer();
-		FirstBuffer.SetNumUninitialized(MinDelaySample);
-		DelayBuffers.Emplace(FirstBuffer);
-		ChannelWriteIndex.SetNumUninitialized(NumChannels);
 		
+		ChannelDelaySample[0] = MinDelaySample;
+		int32 LongestDelay = MinDelaySample;
 		for (int i = 1; i < NumChannels; i++)
 		{
 			const int32 CurDelaySample = DelayStep * i + MinDelaySample;
-			const int32 DelaySample = FMath::RandRange(CurDelaySample, CurDelaySample + DelayStep);
-
-			ChannelDelaySample.Add(DelaySample);
-			FAlignedFloatBuffer Buffer = FAlignedFloatBuffer();
-			Buffer.SetNumUninitialized(DelaySample);
-			DelayBuffers.Emplace(Buffer);
+			ChannelDelaySample[i] = FMath::RandRange(CurDelaySample, CurDelaySample + DelayStep);
+			LongestDelay = FMath::Max(LongestDelay, ChannelDelaySample[i]);
 		}
 
+		//Must be longer than the longest delay so a read never aliases the write of the same sample
+		const uint32 NumPositions = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(LongestDelay) + 1u);
+		IndexMask = NumPositions - 1u;
+		DelayBuffer.SetNumUninitialized(NumPositions * NumChannels, EAllowShrinking::No);
+
 		ResetBuffers();
 	}
 
@@ -45,12 +44,8 @@ namespace LBSImpactSFXSynth
 
 	void FMultiDelayReverbMix::ResetBuffers()
 	{
-		for(int i = 0; i < NumChannels; i++)
-		{
-			const int32 DelayS = ChannelDelaySample[i];
-			FMemory::Memzero(DelayBuffers[i].GetData(), DelayS * sizeof(float));
-			ChannelWriteIndex[i] = 0;
-		}
+		FMemory::Memzero(DelayBuffer.GetData(), (IndexMask + 1u) * NumChannels * sizeof(float));
+		WriteIndex = 0;
 	}
 	
 	void FMultiDelayReverbMix::ProcessAudio(TArrayView<float>& OutAudio, const TArrayView<const float>& InAudio, const float FeedbackGain)
@@ -63,35 +58,34 @@ namespace LBSImpactSFXSynth
 		
 		const int32 NumOutFrame = FMath::Min(OutAudio.Num(), InAudio.Num());
 		SetDecayGain(FeedbackGain);
+
+		float* DelayData = DelayBuffer.GetData();
+		float* OutData = OutAudio.GetData();
+		const float* InData = InAudio.GetData();
+		const uint32 Delay0 = ChannelDelaySample[0];
+		const uint32 Delay1 = ChannelDelaySample[1];
+		const uint32 Delay2 = ChannelDelaySample[2];
+		const uint32 Delay3 = ChannelDelaySample[3];
+		
+		const VectorRegister4Float GainReg = VectorSetFloat1(DecayGain);
+		const VectorRegister4Float TwoReg = VectorSetFloat1(2.f);
 		for(int i = 0; i < NumOutFrame; i++)
 		{
-			const float InSample = InAudio[i];
-			ProcessOneSample(OutAudio, i, InSample);
-		}
-	}
-
-	void FMultiDelayReverbMix::ProcessOneSample(TArrayView<float>& OutAudio, int i,const float InSample)
-	{
-		float FirstChannel = DelayBuffers[0][ChannelWriteIndex[0]];
-		float SecondChannel = DelayBuffers[1][ChannelWriteIndex[1]];
-		float ThirdChannel = DelayBuffers[2][ChannelWriteIndex[2]];
-		float FourthChannel = DelayBuffers[3][ChannelWriteIndex[3]];
+			const float FirstChannel = DelayData[((WriteIndex - Delay0) & IndexMask) * NumChannels];
+			const float SecondChannel = DelayData[((WriteIndex - Delay1) & IndexMask) * NumChannels + 1];
+			const float ThirdChannel = DelayData[((WriteIndex - Delay2) & IndexMask) * NumChannels + 2];
+			const float FourthChannel = DelayData[((WriteIndex - Delay3) & IndexMask) * NumChannels + 3];
+			const float Sum = FirstChannel + SecondChannel + ThirdChannel + FourthChannel;
 			
-		OutAudio[i] = (FirstChannel + SecondChannel + ThirdChannel + FourthChannel) / 4.f;
-			
-		FirstChannel = FirstChannel * DecayGain;
-		SecondChannel = SecondChannel * DecayGain;
-		ThirdChannel = ThirdChannel * DecayGain;
-		FourthChannel = FourthChannel * DecayGain;
-			
-		DelayBuffers[0][ChannelWriteIndex[0]] = FirstChannel - SecondChannel - ThirdChannel - FourthChannel + InSample;
-		DelayBuffers[1][ChannelWriteIndex[1]] = -FirstChannel + SecondChannel - ThirdChannel - FourthChannel + InSample;
-		DelayBuffers[2][ChannelWriteIndex[2]] = -FirstChannel - SecondChannel + ThirdChannel - FourthChannel + InSample;
-		DelayBuffers[3][ChannelWriteIndex[3]] = -FirstChannel - SecondChannel - ThirdChannel + FourthChannel + InSample;
+			OutData[i] = Sum / 4.f;
 
-		ChannelWriteIndex[0] = (ChannelWriteIndex[0] + 1) % ChannelDelaySample[0];
-		ChannelWriteIndex[1] = (ChannelWriteIndex[1] + 1) % ChannelDelaySample[1];
-		ChannelWriteIndex[2] = (ChannelWriteIndex[2] + 1) % ChannelDelaySample[2];
-		ChannelWriteIndex[3] = (ChannelWriteIndex[3] + 1) % ChannelDelaySample[3];
+			//Householder mix: each channel keeps itself and subtracts the others, which is 2 * X - Sum
+			const VectorRegister4Float TapReg = MakeVectorRegisterFloat(FirstChannel, SecondChannel, ThirdChannel, FourthChannel);
+			VectorRegister4Float MixReg = VectorSubtract(VectorMultiply(TapReg, TwoReg), VectorSetFloat1(Sum));
+			MixReg = VectorMultiplyAdd(MixReg, GainReg, VectorSetFloat1(InData[i]));
+			VectorStore(MixReg, &DelayData[WriteIndex * NumChannels]);
+			
+			WriteIndex = (WriteIndex + 1u) & IndexMask;
+		}
 	}
 }
@@ -61,7 +61,8 @@ namespace LBSImpactSFXSynth
 		GlobalResidualSpeedScale = InGlobalResidualSpeedScale;
 		GlobalModalPitchShift = InGlobalModalPitchShift;
 		GlobalResidualPitchShift = InGlobalResidualPitchShift;
-		
+
+		BlockCounters = FSynthBlockCounters();
 		const bool bIsStopSpawningNewImpact = SpawningNewImpacts(NumFramesToGenerate, SpawnParams);
 		
 		// For modal synth, only synth one channel since all channels have the same data
@@ -74,6 +75,7 @@ namespace LBSImpactSFXSynth
 			{
 				const bool bIsFinished = ModalSynths[i]->Synthesize(FirstChannelBuffer, MultiImpactProxy->GetModalProxy(), true, false);
 				NumActiveModalSynths += !bIsFinished;
+				BlockCounters.NumActiveModals += ModalSynths[i]->GetNumActiveModals();
 			}
 		}
 		
@@ -94,6 +96,7 @@ namespace LBSImpactSFXSynth
 			{
 				const bool bIsFinished = ResidualSynths[i]->Synthesize(OutAudioView, true, false);
 				NumActiveResidualSynths += !bIsFinished;
+				BlockCounters.NumResidualFrames += ResidualSynths[i]->GetNumLastSynthesizedFrames();
 			}
 		}
 
@@ -102,6 +105,8 @@ namespace LBSImpactSFXSynth
 			for(int32 Channel = 0; Channel < NumChannels; Channel++)
 				Audio::ArrayClampInPlace(OutAudioView[Channel], -1.f, 1.f);			
 		}
+
+		BlockCounters.NumActiveVoices = FMath::Max(NumActiveModalSynths, NumActiveResidualSynths);
 		
 		const bool bIsStopSpawningImpact = SpawnParams.ImpactSpawnDuration >= 0 ? (NextFrameTime >= SpawnParams.ImpactSpawnDuration) : bIsStopSpawningNewImpact;
 		if(NumActiveModalSynths == 0 && NumActiveResidualSynths == 0 && bIsStopSpawningImpact)
@@ -219,6 +224,7 @@ namespace LBSImpactSFXSynth
 																NumUsedModals,AmpScale,
 																DecayScale, PitchScale, ImpactStrength,
 																SpawnInfo->DampingRatio, DelayStartTime, bIsRandomlyGetModal));
+					BlockCounters.NumVoiceCreations++;
 				}
 			}
 				
@@ -247,6 +253,7 @@ namespace LBSImpactSFXSynth
 																	   ResidualDataProxy.ToSharedRef(), PlaySpeed, AmpScale, PitchScale,
 																	   -1, SpawnInfo->ResidualStartTime, SpawnInfo->ResidualDuration, false,
 																	   ImpactStrength, false, DelayStartTime));
+					BlockCounters.NumVoiceCreations++;
 				}
 			}
 				
@@ -318,6 +325,7 @@ namespace LBSImpactSFXSynth
 		const int32 NumRemainModalSynths = MaxNumImpacts - NumActiveModalSynths;
 		const int32 NumModalSynthToStop = NumImpactToSpawn - NumRemainModalSynths;
 		TArray<int32> Indexes;
+		int32 NumModalStopped = 0;
 		if(NumModalSynthToStop > 0)
 		{
 			Indexes.Empty(NumActiveModalSynths);
@@ -332,13 +340,14 @@ namespace LBSImpactSFXSynth
 				return ModalSynths[A]->GetCurrentMaxAmplitude() < ModalSynths[B]->GetCurrentMaxAmplitude();
 			});
 
-			const int32 NumStop = FMath::Min(NumModalSynthToStop, Indexes.Num());
-			for(int i = 0; i < NumStop; i++)
+			NumModalStopped = FMath::Min(NumModalSynthToStop, Indexes.Num());
+			for(int i = 0; i < NumModalStopped; i++)
 				ModalSynths[Indexes[i]]->ForceStop();
 		}
 			
 		const int32 NumRemainResidualSynths = MaxNumImpacts - NumActiveResidualSynths;
 		const int32 NumResidualSynthToStop = NumImpactToSpawn - NumRemainResidualSynths;
+		int32 NumResidualStopped = 0;
 		if(NumRemainResidualSynths < NumImpactToSpawn)
 		{
 			Indexes.Empty(NumActiveResidualSynths);
@@ -353,10 +362,13 @@ namespace LBSImpactSFXSynth
 				return ResidualSynths[A]->GetCurrentFrameEnergy() < ResidualSynths[B]->GetCurrentFrameEnergy();
 			});
 
-			const int32 NumStop = FMath::Min(NumResidualSynthToStop, Indexes.Num());
-			for(int i = 0; i < NumStop; i++)
+			NumResidualStopped = FMath::Min(NumResidualSynthToStop, Indexes.Num());
+			for(int i = 0; i < NumResidualStopped; i++)
 				ResidualSynths[Indexes[i]]->ForceStop();
 		}
+
+		//An impact owns both a modal and a residual voice so only count the larger side as stolen
+		BlockCounters.NumVoicesStolen += FMath::Max(NumModalStopped, NumResidualStopped);
 	}
 
 	void FMultiImpactSynth::StopAllSynthesizers()
@@ -85,6 +85,7 @@ namespace LBSImpactSFXSynth
 	{
 		FOperatorSettings Settings;
 		TArray<FOutputDataVertex> OutputAudioVertices;
+		FName NodeName;
 		
 		FTriggerReadRef PlayTrigger;
 		FTriggerReadRef StopTrigger;
@@ -122,6 +123,7 @@ namespace LBSImpactSFXSynth
 
 		FMultiImpactSynthOperator(const FMultiImpactSynthOpArgs& InArgs)
 			: OperatorSettings(InArgs.Settings)
+			, NodeTrace(InArgs.NodeName)
 			, PlayTrigger(InArgs.PlayTrigger)
 			, StopTrigger(InArgs.StopTrigger)
 			, MultiImpactData(InArgs.MultiImpactData)
@@ -287,6 +289,7 @@ namespace LBSImpactSFXSynth
 		void Execute()
 		{
 			METASOUND_TRACE_CPUPROFILER_EVENT_SCOPE(Metasound::FImpactSynthOperator::Execute);
+			IMPACTSFX_TRACE_NODE_SCOPE(NodeTrace);
 
 			SCOPE_CYCLE_COUNTER(STAT_MultiImpactSynth);
 			
@@ -297,6 +300,13 @@ namespace LBSImpactSFXSynth
 				FMemory::Memzero(OutputBuffer->GetData(), OperatorSettings.GetNumFramesPerBlock() * sizeof(float));
 			
 			ExecuteSubBlocks();
+
+			if(!bIsPlaying)
+			{
+				BlockCounters.NumActiveVoices = 0;
+				BlockCounters.NumActiveModals = 0;
+			}
+			NodeTrace.Publish(BlockCounters);
 		}
 		
 #if ENGINE_MINOR_VERSION > 2
@@ -398,6 +408,7 @@ namespace LBSImpactSFXSynth
 				MultiImpactSynth = MakeUnique<FMultiImpactSynth>(MultImpactProxy.ToSharedRef(), GetMaxNumImpactsClamped(), SamplingRate,
 											   OperatorSettings.GetNumFramesPerBlock(), OutputAudioView.Num(), bIsStopSpawningOnMax, 
 											   Seed, *VariationSpawnType);
+				BlockCounters.NumVoiceCreations++;
 				*OutSeed = MultiImpactSynth->GetSeed();
 			}
 			
@@ -434,6 +445,7 @@ namespace LBSImpactSFXSynth
 				bIsStop = MultiImpactSynth->Synthesize(BufferToGenerate, SpawnParams,
 													  *ModalDecayScale, *ResidualSpeedScale,
 													  *ModalPitchShift, *ResidualPitchShift, bClamp);
+				BlockCounters.Merge(MultiImpactSynth->GetBlockCounters());
 			}
 			
 			if(bIsStop)
@@ -454,6 +466,8 @@ namespace LBSImpactSFXSynth
 		}
 		
 		const FOperatorSettings OperatorSettings;
+		FSynthNodeTrace NodeTrace;
+		FSynthBlockCounters BlockCounters;
 		
 		FTriggerReadRef PlayTrigger;
 		FTriggerReadRef StopTrigger;
@@ -516,6 +530,7 @@ namespace LBSImpactSFXSynth
 			{
 				InParams.OperatorSettings,
 				OutputAudioVertices,
+				InParams.Node.GetInstanceName(),
 				
 				Inputs.GetOrConstructDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputTriggerPlay), InParams.OperatorSettings),
 				Inputs.GetOrConstructDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputTriggerStop), InParams.OperatorSettings),
@@ -19,6 +19,11 @@ void UResidualData::SetResidualObj(UResidualObj* InObj)
 		SamplingRate = InObj->GetSamplingRate();
 	}
 }
+
+FResidualDataAssetProxyPtr UResidualData::CreatePreviewProxyData(UResidualObj* InResidualObjSnapshot) const
+{
+	return MakeShared<FResidualDataAssetProxy, ESPMode::ThreadSafe>(this, InResidualObjSnapshot, PreviewPlaySpeed, PreviewSeed, PreviewStartTime, PreviewDuration, PreviewPitchShift);
+}
 #endif
 
 TSharedPtr<Audio::IProxyData, ESPMode::ThreadSafe> UResidualData::CreateProxyData(
@@ -214,8 +219,14 @@ int32 UResidualData::GetNumCurves() const
 
 FResidualDataAssetProxy::FResidualDataAssetProxy(const UResidualData* InResidualData, const float PlaySpeed,
 												const int32 Seed, const float StartTime, const float Duration, const float PitchShift)
+	: FResidualDataAssetProxy(InResidualData, InResidualData->ResidualObj, PlaySpeed, Seed, StartTime, Duration, PitchShift)
+{
+}
+
+FResidualDataAssetProxy::FResidualDataAssetProxy(const UResidualData* InResidualData, UResidualObj* InResidualObj, const float PlaySpeed,
+												const int32 Seed, const float StartTime, const float Duration, const float PitchShift)
 {
-	ResidualObj = InResidualData->ResidualObj;
+	ResidualObj = InResidualObj;
 	PhaseEffect = InResidualData->GetPhaseEffect();
 	
 	InitSynthCurveBasedOnSource(InResidualData->AmplitudeOverTimeCurve, ScaleAmplitudeCurve);
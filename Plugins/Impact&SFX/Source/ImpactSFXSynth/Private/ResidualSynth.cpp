@@ -22,7 +22,7 @@ namespace LBSImpactSFXSynth
 	                               const float InImpactStrengthScale, const float InRandomLoop, const float InDelayTime, const float InRandomMagnitudeScale)
 	: SamplingRate(InSamplingRate), NumFramesPerBlock(InNumFramesPerBlock), NumOutChannel(InNumOutChannel)
 	, ResidualDataProxy(ResidualDataAssetProxyRef), AmplitudeScale(InAmplitudeScale * InImpactStrengthScale), PitchScale(InPitchScale)
-	, RandomMagnitudeScale(InRandomMagnitudeScale)
+	, RandomMagnitudeScale(InRandomMagnitudeScale), NumLastSynthesizedFrames(0)
 	{
 		checkf(NumOutChannel > 0 && NumOutChannel <= 2, TEXT("Not support number of channels = %d."), NumOutChannel);
 		
@@ -281,6 +281,7 @@ namespace LBSImpactSFXSynth
 	{
 		SCOPE_CYCLE_COUNTER(STAT_ResidualSynth);
 
+		NumLastSynthesizedFrames = 0;
 		if(CurrentState == ESynthesizerState::Finished)
 			return true;
 
@@ -410,6 +411,8 @@ namespace LBSImpactSFXSynth
 
 	void FResidualSynth::SynthesizeOneFrame(const UResidualObj* ResidualObj)
 	{
+		NumLastSynthesizedFrames++;
+		
 		GetErbDataByInterpolatingFrames(ResidualObj);
 		PutFrameDataToBuffers();
 		CalNewPhaseIndex();
@@ -497,8 +500,8 @@ namespace LBSImpactSFXSynth
 		const int32 NumPoints = ConjBuffers[0].Num();
 		for(int i = 0; i < NumPoints; i++)
 		{
-			ConjBuffers[0][i] = FResidualStats::SinCycle[(PhaseIndexes[i] + FResidualStats::CosShift) % FResidualStats::NumSinPoint];
-			ConjBuffers[1][i] = FResidualStats::SinCycle[PhaseIndexes[i]];
+			ConjBuffers[0][i] = FResidualStats::Cos(PhaseIndexes[i]);
+			ConjBuffers[1][i] = FResidualStats::Sin(PhaseIndexes[i]);
 		}
 		
 		Audio::ArrayMultiplyInPlace(MagBuffer, ConjBuffers[0]);
@@ -574,8 +577,8 @@ namespace LBSImpactSFXSynth
 					for(int i = 0; i < NumInterPoint; i++)
 					{
 						ErbFrameBuffer[i] = ErbInterpolateBuffer[FFTInterpolateIdxs[i]] *  ResidualDataProxy->GetAmplitudeScale(CurrentTime);
-						ConjBuffers[0][i] = FResidualStats::SinCycle[(PhaseIndexes[i] + FResidualStats::CosShift) % FResidualStats::NumSinPoint];
-						ConjBuffers[1][i] = FResidualStats::SinCycle[PhaseIndexes[i]];
+						ConjBuffers[0][i] = FResidualStats::Cos(PhaseIndexes[i]);
+						ConjBuffers[1][i] = FResidualStats::Sin(PhaseIndexes[i]);
 					}
 				}
 				else
@@ -586,8 +589,8 @@ namespace LBSImpactSFXSynth
 					{
 						const float RandScale = GetRandRange(RandomStream, MinRandScale, RandRange); 
 						ErbFrameBuffer[i] = ErbInterpolateBuffer[FFTInterpolateIdxs[i]] * ResidualDataProxy->GetAmplitudeScale(CurrentTime) * RandScale;
-						ConjBuffers[0][i] = FResidualStats::SinCycle[(PhaseIndexes[i] + FResidualStats::CosShift) % FResidualStats::NumSinPoint];
-						ConjBuffers[1][i] = FResidualStats::SinCycle[PhaseIndexes[i]];
+						ConjBuffers[0][i] = FResidualStats::Cos(PhaseIndexes[i]);
+						ConjBuffers[1][i] = FResidualStats::Sin(PhaseIndexes[i]);
 					}
 				}
 			}
@@ -598,8 +601,8 @@ namespace LBSImpactSFXSynth
 					for(int i = 0; i < NumInterPoint; i++)
 					{				 
 						ErbFrameBuffer[i] = ErbInterpolateBuffer[FFTInterpolateIdxs[i]];
-						ConjBuffers[0][i] = FResidualStats::SinCycle[(PhaseIndexes[i] + FResidualStats::CosShift) % FResidualStats::NumSinPoint];
-						ConjBuffers[1][i] = FResidualStats::SinCycle[PhaseIndexes[i]];
+						ConjBuffers[0][i] = FResidualStats::Cos(PhaseIndexes[i]);
+						ConjBuffers[1][i] = FResidualStats::Sin(PhaseIndexes[i]);
 					}
 				}
 				else
@@ -610,8 +613,8 @@ namespace LBSImpactSFXSynth
 					{
 						const float RandScale = GetRandRange(RandomStream, MinRandScale, RandRange); 
 						ErbFrameBuffer[i] = ErbInterpolateBuffer[FFTInterpolateIdxs[i]] * RandScale;
-						ConjBuffers[0][i] = FResidualStats::SinCycle[(PhaseIndexes[i] + FResidualStats::CosShift) % FResidualStats::NumSinPoint];
-						ConjBuffers[1][i] = FResidualStats::SinCycle[PhaseIndexes[i]];
+						ConjBuffers[0][i] = FResidualStats::Cos(PhaseIndexes[i]);
+						ConjBuffers[1][i] = FResidualStats::Sin(PhaseIndexes[i]);
 					}
 				}
 			}
@@ -626,8 +629,8 @@ namespace LBSImpactSFXSynth
 					for(int i = 0; i < NumInterPoint; i++)
 					{
 						ErbFrameBuffer[i] = ErbInterpolateBuffer[PositiveMod(FFTInterpolateIdxs[i] + CircularShift, NumErb)] * ResidualDataProxy->GetAmplitudeScale(CurrentTime);
-						ConjBuffers[0][i] = FResidualStats::SinCycle[(PhaseIndexes[i] + FResidualStats::CosShift) % FResidualStats::NumSinPoint];
-						ConjBuffers[1][i] = FResidualStats::SinCycle[PhaseIndexes[i]];
+						ConjBuffers[0][i] = FResidualStats::Cos(PhaseIndexes[i]);
+						ConjBuffers[1][i] = FResidualStats::Sin(PhaseIndexes[i]);
 					}
 				}
 				else
@@ -639,8 +642,8 @@ namespace LBSImpactSFXSynth
 						const float RandScale = GetRandRange(RandomStream, MinRandScale, RandRange); 
 						ErbFrameBuffer[i] = ErbInterpolateBuffer[PositiveMod(FFTInterpolateIdxs[i] + CircularShift, NumErb)] * ResidualDataProxy->GetAmplitudeScale(CurrentTime);
 						ErbFrameBuffer[i] *=  RandScale;
-						ConjBuffers[0][i] = FResidualStats::SinCycle[(PhaseIndexes[i] + FResidualStats::CosShift) % FResidualStats::NumSinPoint];
-						ConjBuffers[1][i] = FResidualStats::SinCycle[PhaseIndexes[i]];
+						ConjBuffers[0][i] = FResidualStats::Cos(PhaseIndexes[i]);
+						ConjBuffers[1][i] = FResidualStats::Sin(PhaseIndexes[i]);
 					}
 				}
 			}
@@ -651,8 +654,8 @@ namespace LBSImpactSFXSynth
 					for(int i = 0; i < NumInterPoint; i++)
 					{
 						ErbFrameBuffer[i] = ErbInterpolateBuffer[PositiveMod(FFTInterpolateIdxs[i] + CircularShift, NumErb)];
-						ConjBuffers[0][i] = FResidualStats::SinCycle[(PhaseIndexes[i] + FResidualStats::CosShift) % FResidualStats::NumSinPoint];
-						ConjBuffers[1][i] = FResidualStats::SinCycle[PhaseIndexes[i]];
+						ConjBuffers[0][i] = FResidualStats::Cos(PhaseIndexes[i]);
+						ConjBuffers[1][i] = FResidualStats::Sin(PhaseIndexes[i]);
 					}
 				}
 				else
@@ -663,8 +666,8 @@ namespace LBSImpactSFXSynth
 					{
 						const float RandScale = GetRandRange(RandomStream, MinRandScale, RandRange); 
 						ErbFrameBuffer[i] = ErbInterpolateBuffer[PositiveMod(FFTInterpolateIdxs[i] + CircularShift, NumErb)] * RandScale;
-						ConjBuffers[0][i] = FResidualStats::SinCycle[(PhaseIndexes[i] + FResidualStats::CosShift) % FResidualStats::NumSinPoint];
-						ConjBuffers[1][i] = FResidualStats::SinCycle[PhaseIndexes[i]];
+						ConjBuffers[0][i] = FResidualStats::Cos(PhaseIndexes[i]);
+						ConjBuffers[1][i] = FResidualStats::Sin(PhaseIndexes[i]);
 					}
 				}
 			}
@@ -778,8 +781,8 @@ namespace LBSImpactSFXSynth
 				const float PhiSpeed = (ResidualDataProxy->GetResidualData()->GetNumFFT() / (SamplingRate * FResidualStats::SinStep)) * UE_PI * PhaseEffect.EffectScale;
 				for(int i = 0; i < NumPhase; i++)
 				{
-					const int32 Idx =  PhaseIndexes[i] + FMath::RoundToInt32(PhiSpeed * Freqs[i]);
-					PhaseIndexes[i] = Idx % FResidualStats::NumSinPoint;
+					const uint32 Idx = PhaseIndexes[i] + static_cast<uint32>(FMath::RoundToInt32(PhiSpeed * Freqs[i]));
+					PhaseIndexes[i] = Idx & FResidualStats::MaxSinIdx;
 				}
 			}
 			break;
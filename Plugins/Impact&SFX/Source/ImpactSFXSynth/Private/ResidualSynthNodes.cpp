@@ -16,6 +16,7 @@
 #include "MetasoundTrigger.h"
 #include "MetasoundVertex.h"
 #include "ResidualSynth.h"
+#include "CustomStatGroup.h"
 #include "ImpactSFXSynth/Public/Utils.h"
 
 #define LOCTEXT_NAMESPACE "LBSImpactSFXSynthNodes_ResidualSynthNodes"
@@ -53,6 +54,7 @@ namespace LBSImpactSFXSynth
 	{
 		FOperatorSettings Settings;
 		TArray<FOutputDataVertex> OutputAudioVertices;
+		FName NodeName;
 		
 		FTriggerReadRef PlayTrigger;
 		FTriggerReadRef StopTrigger;
@@ -76,6 +78,7 @@ namespace LBSImpactSFXSynth
 
 		FResidualSynthOperator(const FResidualSynthOpArgs& InArgs)
 			: OperatorSettings(InArgs.Settings)
+			, NodeTrace(InArgs.NodeName)
 			, PlayTrigger(InArgs.PlayTrigger)
 			, StopTrigger(InArgs.StopTrigger)
 			, ResidualData(InArgs.ResidualData)
@@ -195,6 +198,7 @@ namespace LBSImpactSFXSynth
 		void Execute()
 		{
 			METASOUND_TRACE_CPUPROFILER_EVENT_SCOPE(Metasound::FResidualSynthOperator::Execute);
+			IMPACTSFX_TRACE_NODE_SCOPE(NodeTrace);
 			
 			TriggerOnDone->AdvanceBlock();
 
@@ -203,6 +207,9 @@ namespace LBSImpactSFXSynth
 				FMemory::Memzero(OutputBuffer->GetData(), OperatorSettings.GetNumFramesPerBlock() * sizeof(float));
 			
 			ExecuteSubBlocks();
+
+			BlockCounters.NumActiveVoices = bIsPlaying ? 1 : 0;
+			NodeTrace.Publish(BlockCounters);
 		}
 
 #if ENGINE_MINOR_VERSION > 2
@@ -327,6 +334,7 @@ namespace LBSImpactSFXSynth
 														   ResidualDataProxy.ToSharedRef(), PlaySpeed, *ResidualAmplitudeScale, PitchScale,
 														   Seed, StartTime, Duration, *bIsLoop, 1.0f,
 														   RandomLoop->GetSeconds(), 0.f, *RandomMagnitude);
+				BlockCounters.NumVoiceCreations++;
 			}
 
 			bIsPlaying = ResidualSynth.IsValid();
@@ -350,6 +358,7 @@ namespace LBSImpactSFXSynth
 			if(ResidualSynth.IsValid())
 			{
 				bIsResidualStop = ResidualSynth->Synthesize(BufferToGenerate, false, true);
+				BlockCounters.NumResidualFrames += ResidualSynth->GetNumLastSynthesizedFrames();
 			}
 			
 			if(bIsResidualStop)
@@ -361,6 +370,8 @@ namespace LBSImpactSFXSynth
 		}
 		
 		const FOperatorSettings OperatorSettings;
+		FSynthNodeTrace NodeTrace;
+		FSynthBlockCounters BlockCounters;
 		
 		FTriggerReadRef PlayTrigger;
 		FTriggerReadRef StopTrigger;
@@ -409,6 +420,7 @@ namespace LBSImpactSFXSynth
 			{
 				InParams.OperatorSettings,
 				OutputAudioVertices,
+				InParams.Node.GetInstanceName(),
 				Inputs.GetOrConstructDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputTriggerPlay), InParams.OperatorSettings),
 				Inputs.GetOrConstructDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputTriggerStop), InParams.OperatorSettings),
 				Inputs.GetOrConstructDataReadReference<FResidualData>(METASOUND_GET_PARAM_NAME(InputResidualData)),
@@ -18,7 +18,8 @@ namespace LBSImpactSFXSynth
 		const float ResidualPlaySpeed, const float ResidualAmplitudeScale, const float ResidualPitchScale,
 		const float ResidualStartTime, const float ResidualDuration)
 	: SamplingRate(InSamplingRate), NumOutChannel(InNumOutChannel),
-	  NumFFT(1024), CurrentSynthBufferIndex(0), CurrentFrame(0), LastImpactSpawnTime(0.f), bIsFinalFrameSynth(false)
+	  NumFFT(1024), CurrentSynthBufferIndex(0), CurrentFrame(0), LastImpactSpawnTime(0.f), bIsFinalFrameSynth(false),
+	  ImpactHead(0), NumImpacts(0), ActiveImpactMask(0), UsedImpactModsMask(0)
 	{	
 		if(InSeed > -1)
 			Seed = InSeed;
@@ -177,9 +178,9 @@ namespace LBSImpactSFXSynth
 		const int32 NumPoints = ConjBuffers[0].Num();
 		for(int i = 0; i < NumPoints; i++)
 		{
-			const int32 PhaseIndex = FMath::RandHelper(FResidualStats::NumSinPoint);
-			ConjBuffers[0][i] = FResidualStats::SinCycle[(PhaseIndex + FResidualStats::CosShift) % FResidualStats::NumSinPoint];
-			ConjBuffers[1][i] = FResidualStats::SinCycle[PhaseIndex];
+			const uint32 PhaseIndex = FMath::RandHelper(FResidualStats::NumSinPoint);
+			ConjBuffers[0][i] = FResidualStats::Cos(PhaseIndex);
+			ConjBuffers[1][i] = FResidualStats::Sin(PhaseIndex);
 		}
 		
 		Audio::ArrayMultiplyInPlace(MagBuffer, ConjBuffers[0]);
@@ -209,7 +210,7 @@ namespace LBSImpactSFXSynth
 		
 		CurrentFrame++;
 
-		if(!bCanStillSpawn && ImpactInfos.Num() <= 0)
+		if(!bCanStillSpawn && NumImpacts <= 0)
 			return true;
 		else
 			return false;
@@ -233,7 +234,9 @@ namespace LBSImpactSFXSynth
 					LastImpactSpawnTime = CurrentTime + TimeStep;
 					if((CurrentFrame == 0) || (ImpactRandomStream.FRand() <= SpawnChance))
 					{
-						FScratchImpactInfo Info;
+						const int32 ImpactIndex = AddImpact();
+						FScratchImpactInfo& Info = ImpactInfos[ImpactIndex];
+						Info = FScratchImpactInfo();
 						const int32 RandFrame = ImpactRandomStream.RandRange(SpawnParams.FrameStartMin, SpawnParams.FrameStartMax);
 						Info.Frame = CurrentFrame - FMath::Max(0, RandFrame);
 						Info.bResidualEnable = ResidualSynth.IsValid();
@@ -241,16 +244,20 @@ namespace LBSImpactSFXSynth
 						Info.bExciteModalEnable = ExciteModalsParams.IsValid();
 						Info.bResonModalEnable = ResonModalsParams.IsValid();
 						
-						Info.ExciteModalMods = ExciteModalMods;
-						Info.ResonModalMods = ResonModalMods;
+						Info.ModsIndex = FindOrAddImpactMods(ExciteModalMods, ResonModalMods);
 
 						float Gain = GainMin + SpawnParams.GainRange * ImpactRandomStream.FRand();
 						const int32 Count = static_cast<int32>(Info.bResidualEnable) + static_cast<int32>(Info.bExciteModalEnable) + static_cast<int32>(Info.bResonModalEnable);
 						Gain = Gain / FMath::Max(1.0f, Count);
 						Info.AmpScale = Gain * (1.0 + 0.1f * (ImpactRandomStream.FRand() - 0.5f));
-						Info.ExciteModalMods.AmplitudeScale *= Gain * (1.0 + 0.1f * (ImpactRandomStream.FRand() - 0.5f));
-						Info.ResonModalMods.AmplitudeScale *= Gain * (1.0 + 0.1f * (ImpactRandomStream.FRand() - 0.5f));
-						ImpactInfos.Emplace(Info);
+						Info.ExciteAmpScale = Gain * (1.0 + 0.1f * (ImpactRandomStream.FRand() - 0.5f));
+						Info.ResonAmpScale = Gain * (1.0 + 0.1f * (ImpactRandomStream.FRand() - 0.5f));
+						ActiveImpactMask |= 1u << ImpactIndex;
+
+						if(Info.bExciteModalEnable)
+							UpdateModalFFTTable(ExciteModalsParams, ExciteModalMods, ExciteFFTTables[Info.ModsIndex]);
+						if(Info.bResonModalEnable)
+							UpdateModalFFTTable(ResonModalsParams, ResonModalMods, ResonFFTTables[Info.ModsIndex]);
 					}
 				}
 			}
@@ -262,78 +269,160 @@ namespace LBSImpactSFXSynth
 	void FScratchingSynth::SynthesizeCurrentImpacts(const FImpactModalObjAssetProxyPtr& ExciteModalsParams, const FImpactModalObjAssetProxyPtr& ResonModalsParams)
 	{
 		FMemory::Memzero(MagBuffer.GetData(), MagBuffer.Num() * sizeof(float));
-		if(ResidualSynth.IsValid())
+		
+		const bool bIsExciteChanged = ExciteModalsParams.IsValid() && ExciteModalsParams->IsParamChanged();
+		const bool bIsResonChanged = ResonModalsParams.IsValid() && ResonModalsParams->IsParamChanged();
+		if(bIsExciteChanged || bIsResonChanged)
 		{
-			for(int i = 0; i < ImpactInfos.Num(); i++)
+			//Tables of free slots are only invalidated, they are rebuilt when a slot is used again
+			for(int32 i = 0; i < MaxNumImpacts; i++)
 			{
-				FScratchImpactInfo* Info = &ImpactInfos[i];
-				const int32 DeltaFrame = CurrentFrame - ImpactInfos[i].Frame;
-
-				if(Info->bResidualEnable)
-					Info->bResidualEnable = ResidualSynth->GetFFTMagAtFrame(DeltaFrame, MagBuffer, Info->AmpScale, Info->ResidualPitchScale);					
-				
-				if(Info->bExciteModalEnable && ExciteModalsParams.IsValid())
-				{
-					Info->bExciteModalEnable = !FModalFFT::GetFFTMag(ExciteModalsParams->GetParams(),
-																	SamplingRate, NumFFT, HopSize, MagBuffer,
-																	DeltaFrame, Info->ExciteModalMods);
-				}
-				
-				if(Info->bResonModalEnable && ResonModalsParams.IsValid())
+				const bool bIsSlotUsed = (UsedImpactModsMask & (1u << i)) != 0;
+				if(bIsExciteChanged && ExciteFFTTables[i].IsValid())
 				{
-					Info->bResonModalEnable = !FModalFFT::GetFFTMag(ResonModalsParams->GetParams(),
-																   SamplingRate, NumFFT, HopSize, MagBuffer,
-																   DeltaFrame, Info->ResonModalMods);
+					if(bIsSlotUsed)
+						FModalFFT::BuildTable(ExciteModalsParams->GetParams(), SamplingRate, NumFFT, MagBuffer.Num(), ExciteFFTTables[i].Mods, ExciteFFTTables[i]);
+					else
+						ExciteFFTTables[i].Reset();
 				}
-				
-				if(i >= MaxNumImpacts)
+				if(bIsResonChanged && ResonFFTTables[i].IsValid())
 				{
-					ImpactInfos.RemoveAt(0);
-					break;
+					if(bIsSlotUsed)
+						FModalFFT::BuildTable(ResonModalsParams->GetParams(), SamplingRate, NumFFT, MagBuffer.Num(), ResonFFTTables[i].Mods, ResonFFTTables[i]);
+					else
+						ResonFFTTables[i].Reset();
 				}
 			}
+		}
 
-			ResidualSynth->DoIFFT(MagBuffer);
+		for(int32 i = 0; i < NumImpacts; i++)
+		{
+			const int32 ImpactIndex = (ImpactHead + i) % MaxNumImpacts;
+			if((ActiveImpactMask & (1u << ImpactIndex)) == 0)
+				continue;
+			
+			FScratchImpactInfo& Info = ImpactInfos[ImpactIndex];
+			const FScratchImpactMods& Mods = ImpactMods[Info.ModsIndex];
+			const int32 DeltaFrame = CurrentFrame - Info.Frame;
+
+			if(Info.bResidualEnable && ResidualSynth.IsValid())
+				Info.bResidualEnable = ResidualSynth->GetFFTMagAtFrame(DeltaFrame, MagBuffer, Info.AmpScale, Info.ResidualPitchScale);
+			
+			if(Info.bExciteModalEnable && ExciteModalsParams.IsValid())
+				Info.bExciteModalEnable = !GetModalFFTMag(ExciteModalsParams, Mods.ExciteModalMods, Info.ExciteAmpScale, ExciteFFTTables[Info.ModsIndex], DeltaFrame);
+			
+			if(Info.bResonModalEnable && ResonModalsParams.IsValid())
+				Info.bResonModalEnable = !GetModalFFTMag(ResonModalsParams, Mods.ResonModalMods, Info.ResonAmpScale, ResonFFTTables[Info.ModsIndex], DeltaFrame);
+
+			if(!Info.IsActive())
+				ActiveImpactMask &= ~(1u << ImpactIndex);
 		}
+
+		if(ResidualSynth.IsValid())
+			ResidualSynth->DoIFFT(MagBuffer);
 		else
+			DoIFFT();
+
+		while(NumImpacts > 0 && (ActiveImpactMask & (1u << ImpactHead)) == 0)
 		{
-			for(int i = 0; i < ImpactInfos.Num(); i++)
-			{
-				FScratchImpactInfo* Info = &ImpactInfos[i];
-				const int32 DeltaFrame = CurrentFrame - ImpactInfos[i].Frame;
+			ImpactHead = (ImpactHead + 1) % MaxNumImpacts;
+			NumImpacts--;
+		}
+	}
 
-				if(Info->bExciteModalEnable && ExciteModalsParams.IsValid())
-				{
-					Info->bExciteModalEnable = !FModalFFT::GetFFTMag(ExciteModalsParams->GetParams(),
-																	SamplingRate, NumFFT, HopSize, MagBuffer,
-																	DeltaFrame, Info->ExciteModalMods);
-				}
-				
-				if(Info->bResonModalEnable && ResonModalsParams.IsValid())
-				{
-					Info->bResonModalEnable = !FModalFFT::GetFFTMag(ResonModalsParams->GetParams(),
-																   SamplingRate, NumFFT, HopSize, MagBuffer,
-																   DeltaFrame, Info->ResonModalMods);
-				}
+	int32 FScratchingSynth::AddImpact()
+	{
+		if(NumImpacts >= MaxNumImpacts)
+			CompactImpacts();
+		
+		if(NumImpacts >= MaxNumImpacts)
+		{
+			//Drop the oldest impact
+			ActiveImpactMask &= ~(1u << ImpactHead);
+			ImpactHead = (ImpactHead + 1) % MaxNumImpacts;
+			NumImpacts--;
+		}
 
-				if(i >= MaxNumImpacts)
-				{
-					ImpactInfos.RemoveAt(0);
-					break;
-				}
-			}
+		const int32 ImpactIndex = (ImpactHead + NumImpacts) % MaxNumImpacts;
+		NumImpacts++;
+		return ImpactIndex;
+	}
 
-			DoIFFT();
+	void FScratchingSynth::CompactImpacts()
+	{
+		int32 NumKept = 0;
+		uint32 NewMask = 0;
+		for(int32 i = 0; i < NumImpacts; i++)
+		{
+			const int32 SrcIndex = (ImpactHead + i) % MaxNumImpacts;
+			if((ActiveImpactMask & (1u << SrcIndex)) == 0)
+				continue;
+
+			const int32 DstIndex = (ImpactHead + NumKept) % MaxNumImpacts;
+			if(DstIndex != SrcIndex)
+				ImpactInfos[DstIndex] = ImpactInfos[SrcIndex];
+			NewMask |= 1u << DstIndex;
+			NumKept++;
 		}
+		
+		NumImpacts = NumKept;
+		ActiveImpactMask = NewMask;
+	}
 
-		int i = 0;
-		while (i < ImpactInfos.Num())
+	int32 FScratchingSynth::FindOrAddImpactMods(const FModalMods& ExciteModalMods, const FModalMods& ResonModalMods)
+	{
+		auto IsSameMods = [](const FModalMods& A, const FModalMods& B)
 		{
-			const FScratchImpactInfo* Info = &ImpactInfos[i];
-			if(!Info->bResidualEnable && !Info->bExciteModalEnable && !Info->bResonModalEnable)
-				ImpactInfos.RemoveAt(i);			
-			else
-				i++;
+			return A.NumModals == B.NumModals && A.AmplitudeScale == B.AmplitudeScale
+					&& A.DecayScale == B.DecayScale && A.FreqScale == B.FreqScale;
+		};
+		
+		uint32 UsedMask = 0;
+		for(int32 i = 0; i < MaxNumImpacts; i++)
+		{
+			if(ActiveImpactMask & (1u << i))
+				UsedMask |= 1u << ImpactInfos[i].ModsIndex;
+		}
+		UsedImpactModsMask &= UsedMask;
+
+		int32 FreeIndex = INDEX_NONE;
+		for(int32 i = 0; i < MaxNumImpacts; i++)
+		{
+			if(UsedImpactModsMask & (1u << i))
+			{
+				const FScratchImpactMods& Mods = ImpactMods[i];
+				if(IsSameMods(Mods.ExciteModalMods, ExciteModalMods) && IsSameMods(Mods.ResonModalMods, ResonModalMods))
+					return i;
+			}
+			else if(FreeIndex == INDEX_NONE)
+				FreeIndex = i;
 		}
+
+		//At most MaxNumImpacts - 1 other impacts are active here so there is always a free slot
+		check(FreeIndex != INDEX_NONE);
+		ImpactMods[FreeIndex].ExciteModalMods = ExciteModalMods;
+		ImpactMods[FreeIndex].ResonModalMods = ResonModalMods;
+		UsedImpactModsMask |= 1u << FreeIndex;
+		return FreeIndex;
+	}
+
+	void FScratchingSynth::UpdateModalFFTTable(const FImpactModalObjAssetProxyPtr& ModalsParams, const FModalMods& InMods, FModalFFTTable& Table) const
+	{
+		const TArrayView<const float> Params = ModalsParams->GetParams();
+		if(!Table.IsBuiltFor(Params, InMods) || ModalsParams->IsParamChanged())
+			FModalFFT::BuildTable(Params, SamplingRate, NumFFT, MagBuffer.Num(), InMods, Table);
+	}
+
+	bool FScratchingSynth::GetModalFFTMag(const FImpactModalObjAssetProxyPtr& ModalsParams, const FModalMods& InMods, const float AmpScale,
+										  FModalFFTTable& Table, const int32 DeltaFrame)
+	{
+		const TArrayView<const float> Params = ModalsParams->GetParams();
+		if(Table.IsBuiltFor(Params, InMods))
+			return FModalFFT::GetFFTMag(Table, InMods.AmplitudeScale * AmpScale, DeltaFrame * HopSize / SamplingRate, MagBuffer);
+
+		//Only when the proxy was swapped after this impact spawned
+		FModalMods ScaledMods = InMods;
+		ScaledMods.AmplitudeScale *= AmpScale;
+		return FModalFFT::GetFFTMag(Params, SamplingRate, NumFFT, HopSize, MagBuffer, DeltaFrame, ScaledMods);
 	}
 }
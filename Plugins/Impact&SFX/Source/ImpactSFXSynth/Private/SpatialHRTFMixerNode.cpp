@@ -0,0 +1,394 @@
+﻿// Copyright 2023-2024, Le Binh Son, All Rights Reserved.
+
+#include "DSP/Dsp.h"
+#include "MetasoundAudioBuffer.h"
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundDataTypeRegistrationMacro.h"
+#include "MetasoundParamHelper.h"
+#include "MetasoundPrimitives.h"
+#include "MetasoundTrigger.h"
+#include "MetasoundVertex.h"
+#include "ImpactSynthEngineNodesName.h"
+#include "MetasoundStandardNodesCategories.h"
+#include "HRTFModal.h"
+
+#define LOCTEXT_NAMESPACE "LBSImpactSFXSynthNodes_ModalHRTFMixerNode"
+
+namespace LBSImpactSFXSynth
+{
+	using namespace Metasound;
+	
+	namespace ModalHRTFMixerVertexNames
+	{
+		METASOUND_PARAM(InputIsClamp, "Is Clamp", "Clamp the mixed output inside the range [-1, 1] or not.")
+		METASOUND_PARAM(InputAudio0, "In Audio 0", "The input audio of source 0.")
+		METASOUND_PARAM(InputIsInAudioStop0, "Is In Audio Stop 0", "True if the input audio of source 0 has finished/stopped. The source is removed once its output decays to zero.")
+		METASOUND_PARAM(InputAzimuth0, "Azimuth 0", "The azimuth of source 0 in degrees. 0 degrees is in front, -90 degrees is to the left, -180 or 180 degrees are behind, 90 degrees is to the right.")
+		METASOUND_PARAM(InputElevation0, "Elevation 0", "The elevation of source 0 in degrees. 0 degrees is at the ear level. -90 degrees is at bottom of the head. 90 degrees is at the top at the head.")
+		METASOUND_PARAM(InputGain0, "Gain 0", "The gain of source 0.")
+		METASOUND_PARAM(InputAudio1, "In Audio 1", "The input audio of source 1.")
+		METASOUND_PARAM(InputIsInAudioStop1, "Is In Audio Stop 1", "True if the input audio of source 1 has finished/stopped. The source is removed once its output decays to zero.")
+		METASOUND_PARAM(InputAzimuth1, "Azimuth 1", "The azimuth of source 1 in degrees. 0 degrees is in front, -90 degrees is to the left, -180 or 180 degrees are behind, 90 degrees is to the right.")
+		METASOUND_PARAM(InputElevation1, "Elevation 1", "The elevation of source 1 in degrees. 0 degrees is at the ear level. -90 degrees is at bottom of the head. 90 degrees is at the top at the head.")
+		METASOUND_PARAM(InputGain1, "Gain 1", "The gain of source 1.")
+		METASOUND_PARAM(InputAudio2, "In Audio 2", "The input audio of source 2.")
+		METASOUND_PARAM(InputIsInAudioStop2, "Is In Audio Stop 2", "True if the input audio of source 2 has finished/stopped. The source is removed once its output decays to zero.")
+		METASOUND_PARAM(InputAzimuth2, "Azimuth 2", "The azimuth of source 2 in degrees. 0 degrees is in front, -90 degrees is to the left, -180 or 180 degrees are behind, 90 degrees is to the right.")
+		METASOUND_PARAM(InputElevation2, "Elevation 2", "The elevation of source 2 in degrees. 0 degrees is at the ear level. -90 degrees is at bottom of the head. 90 degrees is at the top at the head.")
+		METASOUND_PARAM(InputGain2, "Gain 2", "The gain of source 2.")
+		METASOUND_PARAM(InputAudio3, "In Audio 3", "The input audio of source 3.")
+		METASOUND_PARAM(InputIsInAudioStop3, "Is In Audio Stop 3", "True if the input audio of source 3 has finished/stopped. The source is removed once its output decays to zero.")
+		METASOUND_PARAM(InputAzimuth3, "Azimuth 3", "The azimuth of source 3 in degrees. 0 degrees is in front, -90 degrees is to the left, -180 or 180 degrees are behind, 90 degrees is to the right.")
+		METASOUND_PARAM(InputElevation3, "Elevation 3", "The elevation of source 3 in degrees. 0 degrees is at the ear level. -90 degrees is at bottom of the head. 90 degrees is at the top at the head.")
+		METASOUND_PARAM(InputGain3, "Gain 3", "The gain of source 3.")
+
+		METASOUND_PARAM(OutputTriggerOnDone, "On Finished", "Triggers when all sources are stopped and their outputs decay to zero.")
+		METASOUND_PARAM(OutputAudioLeft, "Out Left", "Left channel audio output of all sources.")
+		METASOUND_PARAM(OutputAudioRight, "Out Right", "Right channel audio output of all sources.")
+	}
+
+	/// Spatialize several sources with HRTF modals and mix them into one stereo output.
+	/// All sources are processed by one FHRTFModalBank so their resonators run in a single SIMD loop.
+	class FModalHRTFMixerOperator : public TExecutableOperator<FModalHRTFMixerOperator>
+	{
+	public:
+		static constexpr int32 NumSources = 4;
+		
+		static const FNodeClassMetadata& GetNodeInfo();
+		static const FVertexInterface& GetVertexInterface();
+		static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults);
+		
+		FModalHRTFMixerOperator(const FOperatorSettings& InSettings,
+								const FBoolReadRef& InIsClamp,
+								const TArray<FAudioBufferReadRef>& InAudioInputs,
+								const TArray<bool>& InIsAudioBounds,
+								const TArray<FBoolReadRef>& InIsInAudioStops,
+								const TArray<FFloatReadRef>& InAzimuths,
+								const TArray<FFloatReadRef>& InElevations,
+								const TArray<FFloatReadRef>& InGains);
+
+		virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override;
+		virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override;
+		virtual FDataReferenceCollection GetInputs() const override;
+		virtual FDataReferenceCollection GetOutputs() const override;
+		void Reset(const IOperator::FResetParams& InParams);
+		void Execute();
+
+	private:
+		static const FVertexName& GetAudioName(int32 Index);
+		static const FVertexName& GetIsInAudioStopName(int32 Index);
+		static const FVertexName& GetAzimuthName(int32 Index);
+		static const FVertexName& GetElevationName(int32 Index);
+		static const FVertexName& GetGainName(int32 Index);
+
+		void OnFinish();
+		
+	private:
+		FBoolReadRef bClamp;
+		TArray<FAudioBufferReadRef> AudioInputs;
+		TArray<FBoolReadRef> bInAudioStops;
+		TArray<FFloatReadRef> Azimuths;
+		TArray<FFloatReadRef> Elevations;
+		TArray<FFloatReadRef> Gains;
+
+		FTriggerWriteRef TriggerOnDone;
+		FAudioBufferWriteRef AudioLeftOutput;
+		FAudioBufferWriteRef AudioRightOutput;
+
+		float SamplingRate;
+		int32 NumFramesPerBlock;
+
+		Audio::FMultichannelBufferView OutputAudioView;
+		TUniquePtr<FHRTFModalBank> HRTFBank;
+		int32 SourceIds[NumSources];
+		bool bIsAudioBounds[NumSources];
+		bool bIsPlaying;
+		bool bFinish;
+	};
+
+	FModalHRTFMixerOperator::FModalHRTFMixerOperator(const FOperatorSettings& InSettings,
+													 const FBoolReadRef& InIsClamp,
+													 const TArray<FAudioBufferReadRef>& InAudioInputs,
+													 const TArray<bool>& InIsAudioBounds,
+													 const TArray<FBoolReadRef>& InIsInAudioStops,
+													 const TArray<FFloatReadRef>& InAzimuths,
+													 const TArray<FFloatReadRef>& InElevations,
+													 const TArray<FFloatReadRef>& InGains)
+		: bClamp(InIsClamp)
+		, AudioInputs(InAudioInputs)
+		, bInAudioStops(InIsInAudioStops)
+		, Azimuths(InAzimuths)
+		, Elevations(InElevations)
+		, Gains(InGains)
+		, TriggerOnDone(FTriggerWriteRef::CreateNew(InSettings))
+		, AudioLeftOutput(FAudioBufferWriteRef::CreateNew(InSettings))
+		, AudioRightOutput(FAudioBufferWriteRef::CreateNew(InSettings))
+	{
+		SamplingRate = InSettings.GetSampleRate();
+		NumFramesPerBlock = InSettings.GetNumFramesPerBlock();
+		
+		OutputAudioView.Empty(2);
+		OutputAudioView.Emplace(AudioLeftOutput->GetData(), AudioLeftOutput->Num());
+		OutputAudioView.Emplace(AudioRightOutput->GetData(), AudioRightOutput->Num());
+
+		for(int32 i = 0; i < NumSources; i++)
+		{
+			SourceIds[i] = INDEX_NONE;
+			bIsAudioBounds[i] = InIsAudioBounds[i];
+		}
+		
+		bIsPlaying = false;
+		bFinish = false;
+	}
+
+	const FVertexName& FModalHRTFMixerOperator::GetAudioName(const int32 Index)
+	{
+		using namespace ModalHRTFMixerVertexNames;
+		static const FVertexName Names[NumSources] = { METASOUND_GET_PARAM_NAME(InputAudio0), METASOUND_GET_PARAM_NAME(InputAudio1), METASOUND_GET_PARAM_NAME(InputAudio2), METASOUND_GET_PARAM_NAME(InputAudio3) };
+		return Names[Index];
+	}
+
+	const FVertexName& FModalHRTFMixerOperator::GetIsInAudioStopName(const int32 Index)
+	{
+		using namespace ModalHRTFMixerVertexNames;
+		static const FVertexName Names[NumSources] = { METASOUND_GET_PARAM_NAME(InputIsInAudioStop0), METASOUND_GET_PARAM_NAME(InputIsInAudioStop1), METASOUND_GET_PARAM_NAME(InputIsInAudioStop2), METASOUND_GET_PARAM_NAME(InputIsInAudioStop3) };
+		return Names[Index];
+	}
+
+	const FVertexName& FModalHRTFMixerOperator::GetAzimuthName(const int32 Index)
+	{
+		using namespace ModalHRTFMixerVertexNames;
+		static const FVertexName Names[NumSources] = { METASOUND_GET_PARAM_NAME(InputAzimuth0), METASOUND_GET_PARAM_NAME(InputAzimuth1), METASOUND_GET_PARAM_NAME(InputAzimuth2), METASOUND_GET_PARAM_NAME(InputAzimuth3) };
+		return Names[Index];
+	}
+
+	const FVertexName& FModalHRTFMixerOperator::GetElevationName(const int32 Index)
+	{
+		using namespace ModalHRTFMixerVertexNames;
+		static const FVertexName Names[NumSources] = { METASOUND_GET_PARAM_NAME(InputElevation0), METASOUND_GET_PARAM_NAME(InputElevation1), METASOUND_GET_PARAM_NAME(InputElevation2), METASOUND_GET_PARAM_NAME(InputElevation3) };
+		return Names[Index];
+	}
+
+	const FVertexName& FModalHRTFMixerOperator::GetGainName(const int32 Index)
+	{
+		using namespace ModalHRTFMixerVertexNames;
+		static const FVertexName Names[NumSources] = { METASOUND_GET_PARAM_NAME(InputGain0), METASOUND_GET_PARAM_NAME(InputGain1), METASOUND_GET_PARAM_NAME(InputGain2), METASOUND_GET_PARAM_NAME(InputGain3) };
+		return Names[Index];
+	}
+
+	void FModalHRTFMixerOperator::BindInputs(FInputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace ModalHRTFMixerVertexNames;
+
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputIsClamp), bClamp);
+		for(int32 i = 0; i < NumSources; i++)
+		{
+			bIsAudioBounds[i] = InOutVertexData.IsVertexBound(GetAudioName(i));
+			InOutVertexData.BindReadVertex(GetAudioName(i), AudioInputs[i]);
+			InOutVertexData.BindReadVertex(GetIsInAudioStopName(i), bInAudioStops[i]);
+			InOutVertexData.BindReadVertex(GetAzimuthName(i), Azimuths[i]);
+			InOutVertexData.BindReadVertex(GetElevationName(i), Elevations[i]);
+			InOutVertexData.BindReadVertex(GetGainName(i), Gains[i]);
+		}
+	}
+
+	void FModalHRTFMixerOperator::BindOutputs(FOutputVertexInterfaceData& InOutVertexData)
+	{
+		using namespace ModalHRTFMixerVertexNames;
+		
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTriggerOnDone), TriggerOnDone);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputAudioLeft), AudioLeftOutput);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputAudioRight), AudioRightOutput);
+	}
+
+	FDataReferenceCollection FModalHRTFMixerOperator::GetInputs() const
+	{
+		// This should never be called. Bind(...) is called instead. This method
+		// exists as a stop-gap until the API can be deprecated and removed.
+		checkNoEntry();
+		return {};
+	}
+
+	FDataReferenceCollection FModalHRTFMixerOperator::GetOutputs() const
+	{
+		// This should never be called. Bind(...) is called instead. This method
+		// exists as a stop-gap until the API can be deprecated and removed.
+		checkNoEntry();
+		return {};
+	}
+	
+	void FModalHRTFMixerOperator::Reset(const IOperator::FResetParams& InParams)
+	{
+		TriggerOnDone->Reset();
+
+		AudioLeftOutput->Zero();
+		AudioRightOutput->Zero();
+
+		HRTFBank.Reset();
+		for(int32 i = 0; i < NumSources; i++)
+			SourceIds[i] = INDEX_NONE;
+		
+		bIsPlaying = false;
+		bFinish = false;
+	}
+
+	void FModalHRTFMixerOperator::Execute()
+	{
+		TriggerOnDone->AdvanceBlock();
+		
+		//Always clear output to zero
+		for (const TArrayView<float>& OutputBuffer : OutputAudioView)
+			FMemory::Memzero(OutputBuffer.GetData(), NumFramesPerBlock * sizeof(float));
+
+		if(bFinish)
+			return;
+		
+		if(!bIsPlaying)
+		{
+			//Sources without a connected input audio are treated as stopped and never added
+			HRTFBank = MakeUnique<FHRTFModalBank>(SamplingRate, NumFramesPerBlock, NumSources);
+			for(int32 i = 0; i < NumSources; i++)
+				SourceIds[i] = bIsAudioBounds[i] ? HRTFBank->AddSource() : INDEX_NONE;
+			bIsPlaying = true;
+		}
+
+		//A source is removed from the bank once it is stopped and rung out. The bank feeds silence to the others.
+		bool bHasSource = false;
+		for(int32 i = 0; i < NumSources; i++)
+		{
+			if(SourceIds[i] == INDEX_NONE)
+				continue;
+
+			const TArrayView<const float> InAudioView = TArrayView<const float>(AudioInputs[i]->GetData(), AudioInputs[i]->Num());
+			const bool bIsSourceDone = HRTFBank->SetSourceInput(SourceIds[i], InAudioView, *Azimuths[i], *Elevations[i],
+																*Gains[i], *bInAudioStops[i]);
+			if(bIsSourceDone)
+			{
+				HRTFBank->RemoveSource(SourceIds[i]);
+				SourceIds[i] = INDEX_NONE;
+			}
+			else
+				bHasSource = true;
+		}
+
+		if(!bHasSource)
+		{
+			bFinish = true;
+			OnFinish();
+			return;
+		}
+		
+		HRTFBank->ProcessBlock(OutputAudioView, *bClamp);
+	}
+
+	void FModalHRTFMixerOperator::OnFinish()
+	{
+		HRTFBank.Reset();
+		TriggerOnDone->TriggerFrame(NumFramesPerBlock - 1);
+	}
+	
+	const FVertexInterface& FModalHRTFMixerOperator::GetVertexInterface()
+	{
+		using namespace ModalHRTFMixerVertexNames;
+		
+		static const FVertexInterface Interface(
+			FInputVertexInterface(
+				TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputIsClamp), false),
+				TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputAudio0)),
+				TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputIsInAudioStop0), false),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputAzimuth0), 0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputElevation0), 0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGain0), 1.0f),
+				TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputAudio1)),
+				TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputIsInAudioStop1), false),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputAzimuth1), 0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputElevation1), 0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGain1), 1.0f),
+				TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputAudio2)),
+				TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputIsInAudioStop2), false),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputAzimuth2), 0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputElevation2), 0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGain2), 1.0f),
+				TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputAudio3)),
+				TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputIsInAudioStop3), false),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputAzimuth3), 0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputElevation3), 0.0f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGain3), 1.0f)
+			),
+			FOutputVertexInterface(
+				TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputTriggerOnDone)),
+				TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputAudioLeft)),
+				TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputAudioRight))
+			)
+		);
+
+		return Interface;
+	}
+
+	const FNodeClassMetadata& FModalHRTFMixerOperator::GetNodeInfo()
+	{
+		auto InitNodeInfo = []() -> FNodeClassMetadata
+		{
+			FNodeClassMetadata Info;
+			Info.ClassName = { ImpactSFXSynthEngineNodes::Namespace, TEXT("Modal HRTF Mixer"), TEXT("") };
+			Info.MajorVersion = 1;
+			Info.MinorVersion = 0;
+			Info.DisplayName = METASOUND_LOCTEXT("Metasound_ModalHRTFMixerDisplayName", "Modal HRTF Mixer");
+			Info.Description = METASOUND_LOCTEXT("Metasound_ModalHRTFMixerNodeDescription", "Apply HRTF on up to 4 input audio signals by using modal approximation and mix them into one stereo output. Cheaper than using one Modal HRTF node per source. Sources without a connected input audio are ignored.");
+			Info.Author = TEXT("Le Binh Son");
+			Info.PromptIfMissing = PluginNodeMissingPrompt;
+			Info.DefaultInterface = GetVertexInterface();
+			Info.CategoryHierarchy.Emplace(NodeCategories::Spatialization);
+			Info.Keywords = { };
+			return Info;
+		};
+
+		static const FNodeClassMetadata Info = InitNodeInfo();
+
+		return Info;
+	}
+
+	TUniquePtr<IOperator> FModalHRTFMixerOperator::CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+	{
+		const FInputVertexInterfaceData& InputData = InParams.InputData;
+		const FOperatorSettings& Settings = InParams.OperatorSettings;
+
+		using namespace ModalHRTFMixerVertexNames;
+		FBoolReadRef InIsClamp = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputIsClamp), Settings);
+
+		TArray<FAudioBufferReadRef> InAudios;
+		TArray<bool> InIsAudioBounds;
+		TArray<FBoolReadRef> InIsInAudioStops;
+		TArray<FFloatReadRef> InAzimuths;
+		TArray<FFloatReadRef> InElevations;
+		TArray<FFloatReadRef> InGains;
+		for(int32 i = 0; i < NumSources; i++)
+		{
+			InAudios.Emplace(InputData.GetOrConstructDataReadReference<FAudioBuffer>(GetAudioName(i), Settings));
+			InIsAudioBounds.Emplace(InputData.IsVertexBound(GetAudioName(i)));
+			InIsInAudioStops.Emplace(InputData.GetOrCreateDefaultDataReadReference<bool>(GetIsInAudioStopName(i), Settings));
+			InAzimuths.Emplace(InputData.GetOrCreateDefaultDataReadReference<float>(GetAzimuthName(i), Settings));
+			InElevations.Emplace(InputData.GetOrCreateDefaultDataReadReference<float>(GetElevationName(i), Settings));
+			InGains.Emplace(InputData.GetOrCreateDefaultDataReadReference<float>(GetGainName(i), Settings));
+		}
+
+		return MakeUnique<FModalHRTFMixerOperator>(Settings, InIsClamp, InAudios, InIsAudioBounds, InIsInAudioStops, InAzimuths, InElevations, InGains);
+	}
+
+	class FModalHRTFMixerNode : public FNodeFacade
+	{
+	public:
+		/**
+		 * Constructor used by the Metasound Frontend.
+		 */
+		FModalHRTFMixerNode(const FNodeInitData& InitData)
+			: FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FModalHRTFMixerOperator>())
+		{
+		}
+	};
+
+	METASOUND_REGISTER_NODE(FModalHRTFMixerNode)
+}
+
+#undef LOCTEXT_NAMESPACE
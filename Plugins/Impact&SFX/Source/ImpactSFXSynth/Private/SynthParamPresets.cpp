@@ -5,71 +5,4 @@
 namespace LBSImpactSFXSynth
 {
 	using namespace Metasound;
-
-	 Audio::FAlignedFloatBuffer FResidualStats::SinCycle {0.f,
-		0.006135884672403336f, 0.012271538376808167f, 0.018406730145215988f, 0.024541229009628296f, 0.030674804002046585f, 0.03680722415447235f, 0.04293825849890709f, 0.049067676067352295f, 0.055195245891809464f, 0.06132074072957039f, 0.06744392216205597f, 0.0735645666718483f, 0.07968243956565857f, 0.08579731732606888f, 0.09190895408391953f, 0.0980171412229538f, 
-		0.10412164032459259f, 0.11022220551967621f, 0.11631863564252853f, 0.12241067737340927f, 0.1284981220960617f, 0.13458071649074554f, 0.14065824449062347f, 0.1467304676771164f, 0.15279719233512878f, 0.15885815024375916f, 0.1649131327867508f, 0.1709619015455246f, 0.17700421810150146f, 0.18303988873958588f, 0.18906866014003754f, 0.19509032368659973f, 
-		0.20110464096069336f, 0.2071113884449005f, 0.2131103277206421f, 0.21910123527050018f, 0.22508391737937927f, 0.23105812072753906f, 0.23702360689640045f, 0.2429801970720291f, 0.24892760813236237f, 0.2548656761646271f, 0.26079413294792175f, 0.2667127847671509f, 0.27262136340141296f, 0.2785196900367737f, 0.2844075560569763f, 0.290284663438797f, 
-		0.29615089297294617f, 0.30200594663619995f, 0.3078496754169464f, 0.3136817514896393f, 0.3195020258426666f, 0.3253103196620941f, 0.3311063051223755f, 0.3368898630142212f, 0.34266072511672974f, 0.3484186828136444f, 0.3541635274887085f, 0.3598950505256653f, 0.36561301350593567f, 0.37131720781326294f, 0.3770074248313904f, 0.3826834559440613f, 
-		0.38834503293037415f, 0.3939920663833618f, 0.39962419867515564f, 0.40524134039878845f, 0.4108431935310364f, 0.4164295792579651f, 0.42200028896331787f, 0.4275550842285156f, 0.4330938458442688f, 0.43861624598503113f, 0.44412216544151306f, 0.4496113359928131f, 0.45508357882499695f, 0.46053871512413025f, 0.4659765064716339f, 0.4713967442512512f, 
-		0.47679924964904785f, 0.4821837842464447f, 0.48755016922950745f, 0.49289822578430176f, 0.49822765588760376f, 0.5035383701324463f, 0.508830189704895f, 0.5141027569770813f, 0.5193560123443604f, 0.5245897173881531f, 0.5298036336898804f, 0.5349976420402527f, 0.5401715040206909f, 0.545324981212616f, 0.5504580140113831f, 0.5555702447891235f, 
-		0.5606616139411926f, 0.5657318234443665f, 0.5707807540893555f, 0.5758082270622253f, 0.580814003944397f, 0.585797905921936f, 0.5907596945762634f, 0.5956993103027344f, 0.6006165146827698f, 0.6055110096931458f, 0.6103827953338623f, 0.6152316331863403f, 0.620057225227356f, 0.6248595118522644f, 0.6296382546424866f, 0.6343933343887329f, 
-		0.6391244530677795f, 0.6438315510749817f, 0.648514449596405f, 0.6531728506088257f, 0.6578066945075989f, 0.6624158024787903f, 0.6669999361038208f, 0.6715589761734009f, 0.6760927438735962f, 0.6806010007858276f, 0.6850836873054504f, 0.6895405650138855f, 0.6939715147018433f, 0.6983762979507446f, 0.7027547359466553f, 0.7071067690849304f, 
-		0.7114322185516357f, 0.7157308459281921f, 0.7200025320053101f, 0.7242471575737f, 0.7284644246101379f, 0.7326542735099792f, 0.7368165850639343f, 0.7409511804580688f, 0.7450577616691589f, 0.7491364479064941f, 0.753186821937561f, 0.7572088837623596f, 0.7612023949623108f, 0.7651672959327698f, 0.7691034078598022f, 0.7730104327201843f, 
-		0.7768884897232056f, 0.7807372808456421f, 0.7845566272735596f, 0.7883464694023132f, 0.7921066284179688f, 0.7958369255065918f, 0.7995373010635376f, 0.8032075762748718f, 0.8068475723266602f, 0.8104572296142578f, 0.8140363693237305f, 0.8175848126411438f, 0.8211025595664978f, 0.8245893120765686f, 0.8280450701713562f, 0.8314696550369263f, 
-		0.8348628878593445f, 0.8382247090339661f, 0.8415549993515015f, 0.8448535799980164f, 0.8481203317642212f, 0.8513551950454712f, 0.8545580506324768f, 0.8577286601066589f, 0.8608669638633728f, 0.8639728426933289f, 0.8670462369918823f, 0.8700870275497437f, 0.8730949759483337f, 0.8760701417922974f, 0.8790122270584106f, 0.8819212913513184f, 
-		0.8847970962524414f, 0.8876396417617798f, 0.8904487490653992f, 0.89322429895401f, 0.8959662914276123f, 0.898674488067627f, 0.901348888874054f, 0.9039892554283142f, 0.9065957069396973f, 0.909168004989624f, 0.9117060303688049f, 0.91420978307724f, 0.9166790843009949f, 0.9191138744354248f, 0.9215140342712402f, 0.9238795042037964f, 
-		0.9262102246284485f, 0.928506076335907f, 0.9307669997215271f, 0.9329928159713745f, 0.9351835250854492f, 0.9373390078544617f, 0.9394592046737671f, 0.9415440559387207f, 0.943593442440033f, 0.9456073641777039f, 0.9475855827331543f, 0.9495282173156738f, 0.9514350295066833f, 0.9533060193061829f, 0.9551411867141724f, 0.9569403529167175f, 
-		0.9587034583091736f, 0.9604305624961853f, 0.9621214270591736f, 0.9637760519981384f, 0.9653944373130798f, 0.9669764637947083f, 0.9685221314430237f, 0.9700312614440918f, 0.9715039134025574f, 0.9729399681091309f, 0.9743393659591675f, 0.9757021069526672f, 0.9770281314849854f, 0.978317379951477f, 0.9795697927474976f, 0.9807853102684021f, 
-		0.9819638729095459f, 0.983105480670929f, 0.9842100739479065f, 0.9852776527404785f, 0.9863080978393555f, 0.9873014092445374f, 0.9882575869560242f, 0.9891765117645264f, 0.990058183670044f, 0.9909026622772217f, 0.9917097687721252f, 0.9924795627593994f, 0.9932119846343994f, 0.9939069747924805f, 0.9945645928382874f, 0.9951847195625305f, 
-		0.9957674145698547f, 0.9963126182556152f, 0.996820330619812f, 0.9972904324531555f, 0.9977231025695801f, 0.9981181025505066f, 0.9984755516052246f, 0.9987954497337341f, 0.9990777373313904f, 0.9993224143981934f, 0.9995294213294983f, 0.99969881772995f, 0.9998306035995483f, 0.9999247193336487f, 0.999981164932251f, 1.0f, 
-		0.999981164932251f, 0.9999247193336487f, 0.9998306035995483f, 0.99969881772995f, 0.9995294213294983f, 0.9993223547935486f, 0.9990777373313904f, 0.9987954497337341f, 0.9984755516052246f, 0.9981181025505066f, 0.9977230429649353f, 0.9972904324531555f, 0.9968202710151672f, 0.9963126182556152f, 0.9957674145698547f, 0.9951847195625305f, 
-		0.9945645332336426f, 0.9939069747924805f, 0.9932119250297546f, 0.9924795031547546f, 0.9917097687721252f, 0.9909026026725769f, 0.990058183670044f, 0.9891765117645264f, 0.9882575869560242f, 0.9873014092445374f, 0.9863080978393555f, 0.9852776527404785f, 0.9842100739479065f, 0.983105480670929f, 0.9819638729095459f, 0.9807852506637573f, 
-		0.9795697331428528f, 0.978317379951477f, 0.9770281314849854f, 0.9757021069526672f, 0.9743393659591675f, 0.9729399085044861f, 0.9715039134025574f, 0.9700312614440918f, 0.9685220718383789f, 0.9669764637947083f, 0.9653944373130798f, 0.9637760519981384f, 0.9621214270591736f, 0.9604305028915405f, 0.9587034583091736f, 0.9569403529167175f, 
-		0.9551411271095276f, 0.9533060193061829f, 0.9514349699020386f, 0.9495282173156738f, 0.9475855827331543f, 0.9456073045730591f, 0.943593442440033f, 0.9415440559387207f, 0.9394592046737671f, 0.9373390078544617f, 0.9351835250854492f, 0.9329928159713745f, 0.9307669401168823f, 0.928506076335907f, 0.9262102246284485f, 0.9238795042037964f, 
-		0.9215139746665955f, 0.9191138744354248f, 0.9166790246963501f, 0.9142097234725952f, 0.9117060303688049f, 0.909168004989624f, 0.9065957069396973f, 0.903989315032959f, 0.9013488292694092f, 0.8986744284629822f, 0.8959662318229675f, 0.89322429895401f, 0.8904486894607544f, 0.887639582157135f, 0.8847970366477966f, 0.8819212317466736f, 
-		0.8790121674537659f, 0.8760700225830078f, 0.8730948567390442f, 0.8700870275497437f, 0.8670462369918823f, 0.8639728426933289f, 0.860866904258728f, 0.8577286005020142f, 0.8545579314231873f, 0.8513551354408264f, 0.8481203317642212f, 0.8448535203933716f, 0.8415548801422119f, 0.8382246494293213f, 0.8348627686500549f, 0.8314695358276367f, 
-		0.8280450701713562f, 0.8245893120765686f, 0.821102499961853f, 0.8175848126411438f, 0.8140363097190857f, 0.810457170009613f, 0.8068475127220154f, 0.8032074570655823f, 0.799537181854248f, 0.7958368062973022f, 0.7921065092086792f, 0.7883463501930237f, 0.78455650806427f, 0.7807371020317078f, 0.7768884897232056f, 0.7730104327201843f, 
-		0.7691033482551575f, 0.765167236328125f, 0.761202335357666f, 0.7572088241577148f, 0.7531867623329163f, 0.7491363286972046f, 0.7450577020645142f, 0.7409510612487793f, 0.7368164658546448f, 0.7326541543006897f, 0.7284643054008484f, 0.7242469787597656f, 0.7200025320053101f, 0.7157308459281921f, 0.7114322185516357f, 0.7071067690849304f, 
-		0.7027547359466553f, 0.6983762383460999f, 0.6939714550971985f, 0.6895405054092407f, 0.6850836277008057f, 0.6806009411811829f, 0.6760926246643066f, 0.6715588569641113f, 0.6669998168945312f, 0.6624156832695007f, 0.6578067541122437f, 0.6531728506088257f, 0.648514449596405f, 0.6438315510749817f, 0.6391244530677795f, 0.6343932747840881f, 
-		0.6296381950378418f, 0.6248594522476196f, 0.6200571656227112f, 0.6152315139770508f, 0.6103827357292175f, 0.605510950088501f, 0.6006163358688354f, 0.5956991910934448f, 0.5907597541809082f, 0.585797905921936f, 0.580814003944397f, 0.5758082270622253f, 0.5707807540893555f, 0.5657317638397217f, 0.5606615543365479f, 0.5555701851844788f, 
-		0.5504578948020935f, 0.5453249216079712f, 0.5401713848114014f, 0.5349975228309631f, 0.5298035144805908f, 0.5245895385742188f, 0.5193560123443604f, 0.5141027569770813f, 0.508830189704895f, 0.5035383701324463f, 0.49822765588760376f, 0.492898166179657f, 0.48755010962486267f, 0.4821837246417999f, 0.4767991304397583f, 0.47139662504196167f, 
-		0.465976357460022f, 0.4605385661125183f, 0.455083429813385f, 0.4496113657951355f, 0.44412216544151306f, 0.43861624598503113f, 0.4330938160419464f, 0.42755505442619324f, 0.4220002293586731f, 0.4164294898509979f, 0.4108431041240692f, 0.4052412211894989f, 0.3996241092681885f, 0.3939919173717499f, 0.3883449137210846f, 0.38268327713012695f, 
-		0.37700724601745605f, 0.3713172376155853f, 0.36561301350593567f, 0.3598950505256653f, 0.3541634976863861f, 0.348418653011322f, 0.34266066551208496f, 0.3368898034095764f, 0.3311062157154083f, 0.32531020045280457f, 0.3195019066333771f, 0.31368160247802734f, 0.3078494966030121f, 0.302005797624588f, 0.29615071415901184f, 0.2902846932411194f, 
-		0.2844075560569763f, 0.2785196900367737f, 0.2726213335990906f, 0.2667127251625061f, 0.260794073343277f, 0.2548655867576599f, 0.2489275187253952f, 0.24298007786273956f, 0.2370234876871109f, 0.23105797171592712f, 0.22508375346660614f, 0.21910107135772705f, 0.21311013400554657f, 0.2071114033460617f, 0.20110464096069336f, 0.19509030878543854f, 
-		0.18906863033771515f, 0.1830398440361023f, 0.1770041584968567f, 0.17096181213855743f, 0.16491302847862244f, 0.1588580310344696f, 0.15279705822467804f, 0.14673033356666565f, 0.14065808057785034f, 0.13458052277565002f, 0.128497913479805f, 0.12241069227457047f, 0.11631863564252853f, 0.11022219061851501f, 0.1041216030716896f, 0.09801708906888962f, 
-		0.09190888702869415f, 0.08579722791910172f, 0.07968233525753021f, 0.07356444746255875f, 0.06744378060102463f, 0.06132058799266815f, 0.05519507825374603f, 0.04906748980283737f, 0.042938053607940674f, 0.03680724278092384f, 0.030674802139401436f, 0.024541210383176804f, 0.018406694754958153f, 0.012271485291421413f, 0.006135814357548952f, -8.742277657347586e-08f, 
-		-0.00613598944619298f, -0.012271660380065441f, -0.01840686984360218f, -0.02454138547182083f, -0.030674977228045464f, -0.03680741414427757f, -0.0429382249712944f, -0.0490676611661911f, -0.05519524961709976f, -0.06132075935602188f, -0.06744395941495895f, -0.07356462627649307f, -0.07968251407146454f, -0.08579740673303604f, -0.09190906584262848f, -0.09801726788282394f, 
-		-0.10412178188562393f, -0.11022236943244934f, -0.11631881445646286f, -0.12241087108850479f, -0.12849809229373932f, -0.13458070158958435f, -0.14065825939178467f, -0.14673049747943878f, -0.15279723703861237f, -0.15885820984840393f, -0.16491320729255676f, -0.17096199095249176f, -0.17700433731079102f, -0.18304002285003662f, -0.18906880915164948f, -0.19509048759937286f, 
-		-0.20110481977462769f, -0.20711158215999603f, -0.2131102979183197f, -0.21910123527050018f, -0.22508393228054047f, -0.23105813562870026f, -0.23702365159988403f, -0.2429802417755127f, -0.24892769753932953f, -0.25486576557159424f, -0.2607942223548889f, -0.26671290397644043f, -0.2726215124130249f, -0.278519868850708f, -0.28440773487091064f, -0.2902848720550537f, 
-		-0.2961508631706238f, -0.30200594663619995f, -0.3078496754169464f, -0.31368178129196167f, -0.3195020854473114f, -0.3253103494644165f, -0.33110639452934265f, -0.33688995242118835f, -0.3426608443260193f, -0.34841880202293396f, -0.35416367650032043f, -0.3598951995372772f, -0.36561319231987f, -0.37131738662719727f, -0.377007395029068f, -0.3826834559440613f, 
-		-0.38834506273269653f, -0.3939920663833618f, -0.3996242582798004f, -0.4052414000034332f, -0.41084325313568115f, -0.41642966866493225f, -0.42200037837028503f, -0.42755523324012756f, -0.43309396505355835f, -0.43861639499664307f, -0.444122314453125f, -0.44961151480674744f, -0.45508357882499695f, -0.46053871512413025f, -0.4659765362739563f, -0.4713967740535736f, 
-		-0.47679927945137024f, -0.4821838140487671f, -0.4875502288341522f, -0.49289828538894653f, -0.4982277750968933f, -0.5035384893417358f, -0.5088302493095398f, -0.5141028761863708f, -0.5193561315536499f, -0.5245896577835083f, -0.5298035740852356f, -0.5349976420402527f, -0.5401715040206909f, -0.545324981212616f, -0.5504580140113831f, -0.5555703043937683f, 
-		-0.5606616139411926f, -0.5657318830490112f, -0.5707808136940002f, -0.5758082866668701f, -0.5808140635490417f, -0.5857979655265808f, -0.5907598733901978f, -0.5956992506980896f, -0.600616455078125f, -0.6055110096931458f, -0.6103827953338623f, -0.6152316331863403f, -0.620057225227356f, -0.6248595118522644f, -0.6296383142471313f, -0.6343933939933777f, 
-		-0.6391245126724243f, -0.6438316702842712f, -0.6485145092010498f, -0.6531729698181152f, -0.6578068137168884f, -0.6624157428741455f, -0.666999876499176f, -0.6715589761734009f, -0.6760927438735962f, -0.6806010007858276f, -0.6850836873054504f, -0.6895406246185303f, -0.6939715147018433f, -0.6983762979507446f, -0.7027548551559448f, -0.70710688829422f, 
-		-0.7114323377609253f, -0.7157309651374817f, -0.7200026512145996f, -0.7242470979690552f, -0.7284643650054932f, -0.7326542735099792f, -0.7368165850639343f, -0.7409511804580688f, -0.7450578212738037f, -0.7491364479064941f, -0.7531868815422058f, -0.7572087645530701f, -0.761202335357666f, -0.765167236328125f, -0.7691032886505127f, -0.7730104327201843f, 
-		-0.7768884301185608f, -0.7807372212409973f, -0.7845566272735596f, -0.7883464694023132f, -0.7921066284179688f, -0.7958369255065918f, -0.7995373010635376f, -0.8032075762748718f, -0.8068476319313049f, -0.8104572892189026f, -0.8140364289283752f, -0.8175849318504333f, -0.8211026191711426f, -0.8245894312858582f, -0.8280451893806458f, -0.831469714641571f, 
-		-0.834863007068634f, -0.8382248282432556f, -0.841555118560791f, -0.8448536992073059f, -0.8481205105781555f, -0.8513553738594055f, -0.8545579314231873f, -0.8577285408973694f, -0.860866904258728f, -0.8639728426933289f, -0.8670462369918823f, -0.8700869679450989f, -0.8730949759483337f, -0.8760700821876526f, -0.8790122270584106f, -0.8819212913513184f, 
-		-0.8847970962524414f, -0.8876396417617798f, -0.8904487490653992f, -0.8932243585586548f, -0.8959662914276123f, -0.8986745476722717f, -0.901348888874054f, -0.9039893746376038f, -0.906595766544342f, -0.9091680645942688f, -0.9117061495780945f, -0.9142098426818848f, -0.9166791439056396f, -0.9191139340400696f, -0.9215141534805298f, -0.9238796234130859f, 
-		-0.926210343837738f, -0.9285060167312622f, -0.9307669401168823f, -0.9329927563667297f, -0.9351834654808044f, -0.9373390078544617f, -0.9394592046737671f, -0.9415440559387207f, -0.943593442440033f, -0.9456073045730591f, -0.9475855827331543f, -0.9495282173156738f, -0.9514350295066833f, -0.9533060789108276f, -0.9551411867141724f, -0.9569403529167175f, 
-		-0.9587035179138184f, -0.9604305624961853f, -0.9621214270591736f, -0.9637761116027832f, -0.9653944969177246f, -0.966976523399353f, -0.9685221314430237f, -0.9700313210487366f, -0.9715039730072021f, -0.9729400277137756f, -0.9743394255638123f, -0.9757022261619568f, -0.9770281910896301f, -0.9783173203468323f, -0.9795697331428528f, -0.9807852506637573f, 
-		-0.9819638729095459f, -0.983105480670929f, -0.9842100739479065f, -0.9852776527404785f, -0.9863080978393555f, -0.9873014092445374f, -0.9882575869560242f, -0.9891765117645264f, -0.9900582432746887f, -0.9909026622772217f, -0.9917097687721252f, -0.9924795627593994f, -0.9932119846343994f, -0.9939069747924805f, -0.9945645928382874f, -0.9951847195625305f, 
-		-0.9957674145698547f, -0.9963126182556152f, -0.996820330619812f, -0.9972904920578003f, -0.9977231025695801f, -0.9981181025505066f, -0.9984756112098694f, -0.9987954497337341f, -0.9990777373313904f, -0.9993223547935486f, -0.9995294213294983f, -0.99969881772995f, -0.9998306035995483f, -0.9999247193336487f, -0.999981164932251f, -1.0f, 
-		-0.999981164932251f, -0.9999247193336487f, -0.9998306035995483f, -0.99969881772995f, -0.9995294213294983f, -0.9993223547935486f, -0.9990777373313904f, -0.9987954497337341f, -0.9984755516052246f, -0.9981181025505066f, -0.9977230429649353f, -0.9972904324531555f, -0.9968202710151672f, -0.9963126182556152f, -0.9957674145698547f, -0.9951847195625305f, 
-		-0.9945645332336426f, -0.9939069151878357f, -0.9932119250297546f, -0.9924795031547546f, -0.9917097687721252f, -0.9909026622772217f, -0.9900582432746887f, -0.9891765117645264f, -0.9882575869560242f, -0.9873014092445374f, -0.9863080978393555f, -0.9852776527404785f, -0.9842100739479065f, -0.983105480670929f, -0.9819638729095459f, -0.9807852506637573f, 
-		-0.9795697331428528f, -0.9783173203468323f, -0.9770281314849854f, -0.9757021069526672f, -0.9743393659591675f, -0.9729399085044861f, -0.9715038537979126f, -0.970031201839447f, -0.9685220122337341f, -0.9669764041900635f, -0.9653943777084351f, -0.9637759923934937f, -0.962121307849884f, -0.9604304432868958f, -0.9587033987045288f, -0.956940233707428f, 
-		-0.9551411867141724f, -0.9533060789108276f, -0.9514350295066833f, -0.9495282173156738f, -0.9475855827331543f, -0.9456073045730591f, -0.943593442440033f, -0.9415440559387207f, -0.9394592046737671f, -0.9373390078544617f, -0.9351834654808044f, -0.9329927563667297f, -0.9307669401168823f, -0.9285060167312622f, -0.9262101650238037f, -0.9238794445991516f, 
-		-0.9215139746665955f, -0.9191137552261353f, -0.9166789650917053f, -0.9142096638679504f, -0.9117059111595154f, -0.9091678857803345f, -0.9065955877304077f, -0.9039891958236694f, -0.9013487100601196f, -0.8986743092536926f, -0.895966112613678f, -0.8932241201400757f, -0.8904487490653992f, -0.8876396417617798f, -0.8847970962524414f, -0.8819212913513184f, 
-		-0.8790122270584106f, -0.8760700821876526f, -0.8730949759483337f, -0.8700869679450989f, -0.8670462369918823f, -0.8639728426933289f, -0.860866904258728f, -0.8577285408973694f, -0.8545579314231873f, -0.8513551354408264f, -0.8481202721595764f, -0.8448534607887268f, -0.8415548801422119f, -0.8382245898246765f, -0.8348627686500549f, -0.8314694762229919f, 
-		-0.8280448913574219f, -0.8245891332626343f, -0.8211023211479187f, -0.8175846338272095f, -0.8140361309051514f, -0.8104569911956787f, -0.806847333908081f, -0.8032075762748718f, -0.7995373010635376f, -0.7958369255065918f, -0.7921066284179688f, -0.7883464694023132f, -0.7845566272735596f, -0.7807372212409973f, -0.7768884301185608f, -0.7730104327201843f, 
-		-0.7691032886505127f, -0.765167236328125f, -0.761202335357666f, -0.7572087645530701f, -0.7531867027282715f, -0.7491363286972046f, -0.7450577020645142f, -0.7409510016441345f, -0.7368164658546448f, -0.7326540946960449f, -0.7284642457962036f, -0.7242469191551208f, -0.7200023531913757f, -0.715730607509613f, -0.7114319801330566f, -0.7071065306663513f, 
-		-0.7027544975280762f, -0.6983759999275208f, -0.6939711570739746f, -0.6895406246185303f, -0.6850836873054504f, -0.6806010007858276f, -0.6760927438735962f, -0.6715589761734009f, -0.666999876499176f, -0.6624157428741455f, -0.6578066349029541f, -0.6531727910041809f, -0.6485143303871155f, -0.6438314914703369f, -0.63912433385849f, -0.6343931555747986f, 
-		-0.629638135433197f, -0.6248593330383301f, -0.6200570464134216f, -0.615231454372406f, -0.610382616519928f, -0.6055108308792114f, -0.6006162762641907f, -0.5956990718841553f, -0.5907594561576843f, -0.5857976078987122f, -0.5808137059211731f, -0.5758079290390015f, -0.5707804560661316f, -0.5657315254211426f, -0.560661256313324f, -0.5555703043937683f, 
-		-0.5504580140113831f, -0.545324981212616f, -0.5401715040206909f, -0.5349976420402527f, -0.5298035740852356f, -0.5245896577835083f, -0.5193559527397156f, -0.5141026973724365f, -0.5088300704956055f, -0.5035383105278015f, -0.4982275664806366f, -0.4928980767726898f, -0.4875500202178955f, -0.4821836054325104f, -0.4767990708351135f, -0.4713965356349945f, 
-		-0.4659762978553772f, -0.46053847670555115f, -0.45508334040641785f, -0.4496110677719116f, -0.4441218674182892f, -0.43861594796180725f, -0.43309351801872253f, -0.42755475640296936f, -0.4219999313354492f, -0.41642919182777405f, -0.41084322333335876f, -0.40524137020111084f, -0.399624228477478f, -0.3939920663833618f, -0.38834503293037415f, -0.3826834261417389f, 
-		-0.3770073652267456f, -0.37131714820861816f, -0.3656129240989685f, -0.3598949611186981f, -0.35416343808174133f, -0.34841856360435486f, -0.3426605761051178f, -0.33688971400260925f, -0.33110612630844116f, -0.3253101110458374f, -0.3195018172264099f, -0.3136815130710602f, -0.3078494071960449f, -0.30200570821762085f, -0.2961506247520447f, -0.2902843952178955f, 
-		-0.28440722823143005f, -0.2785193622112274f, -0.2726210057735443f, -0.26671239733695984f, -0.2607937455177307f, -0.25486525893211365f, -0.24892766773700714f, -0.2429802119731903f, -0.23702362179756165f, -0.23105812072753906f, -0.22508390247821808f, -0.2191012054681778f, -0.21311026811599731f, -0.20711131393909454f, -0.2011045515537262f, -0.19509021937847137f, 
-		-0.18906855583190918f, -0.18303975462913513f, -0.17700406908988953f, -0.17096172273159027f, -0.16491293907165527f, -0.15885794162750244f, -0.15279696881771088f, -0.1467302441596985f, -0.14065799117088318f, -0.13458043336868286f, -0.12849782407283783f, -0.1224103793501854f, -0.11631831526756287f, -0.11022187769412994f, -0.10412128269672394f, -0.09801676869392395f, 
-		-0.09190857410430908f, -0.08579690754413605f, -0.07968249171972275f, -0.07356460392475128f, -0.06744393706321716f, -0.06132073700428009f, -0.05519522726535797f, -0.04906763881444931f, -0.04293820261955261f, -0.03680715337395668f, -0.030674714595079422f, -0.02454112283885479f, -0.01840660721063614f, -0.0122713977470994f, -0.0061357272788882256f
-	};
 }
\ No newline at end of file
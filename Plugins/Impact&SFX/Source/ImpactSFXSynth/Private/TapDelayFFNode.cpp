@@ -155,7 +155,6 @@ namespace LBSImpactSFXSynth
 	{
 		TriggerOnDone->Reset();
 		AudioOutput->Zero();
-		TapDelayFF.Reset();
 		
 		bIsPlaying = false;
 		bFinish = false;
@@ -207,9 +206,11 @@ namespace LBSImpactSFXSynth
 
 	void FTapDelayFFOperator::InitSynthesizers()
 	{
-		TapDelayFF.Reset();
-		
-		TapDelayFF = MakeUnique<FMultiDelayReverbMix>(SamplingRate, *FeedbackGain, *MinDelay, *MaxDelay);
+		//Reuse the delay lines of the previous play so retriggering doesn't allocate
+		if(TapDelayFF.IsValid())
+			TapDelayFF->Init(*FeedbackGain, *MinDelay, *MaxDelay);
+		else
+			TapDelayFF = MakeUnique<FMultiDelayReverbMix>(SamplingRate, *FeedbackGain, *MinDelay, *MaxDelay);
 		bIsPlaying = TapDelayFF.IsValid();
 	}
 
@@ -234,7 +235,6 @@ namespace LBSImpactSFXSynth
 			StopTimer -= TimeStep * NumFramesToGenerate;
 			if(StopTimer <= 0.f)
 			{
-				TapDelayFF.Reset();
 				bIsPlaying = false;
 				TriggerOnDone->TriggerFrame(EndFrame);
 			}
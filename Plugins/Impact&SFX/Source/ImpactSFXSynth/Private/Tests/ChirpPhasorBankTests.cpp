@@ -0,0 +1,134 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "ChirpPhasorBank.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LBSImpactSFXSynth
+{
+	namespace SynthTests
+	{
+		struct FChirpTestModal
+		{
+			EChirpPhaseMode Mode;
+			float Amp;
+			float Decay;
+			float F0;
+			float ChirpRate;
+			float FreqRange;
+		};
+
+		/** Closed form chirp, evaluated per sample in double. These are the formulas of the per sample chirp kernels the bank replaced. */
+		static double GetChirpOracle(const FChirpTestModal& Modal, const double Time, const double StartTime)
+		{
+			double Phase;
+			switch (Modal.Mode)
+			{
+			case EChirpPhaseMode::Sigmoid:
+				Phase = UE_DOUBLE_TWO_PI * Time * (Modal.F0 + Modal.FreqRange * (2.0 / (1.0 + FMath::Exp(-Time * Modal.ChirpRate)) - 1.0));
+				break;
+			case EChirpPhaseMode::Exponent:
+				Phase = UE_DOUBLE_TWO_PI * (Modal.F0 - Modal.FreqRange) * Time
+						+ UE_DOUBLE_TWO_PI * 2.0 * Modal.FreqRange / Modal.ChirpRate * FMath::Loge(FMath::Exp(Time * Modal.ChirpRate) + 1.0);
+				break;
+			default:
+				Phase = UE_DOUBLE_TWO_PI * Time * (Modal.F0 + Modal.ChirpRate * Time);
+				break;
+			}
+			return Modal.Amp * FMath::Exp(Modal.Decay * (Time - StartTime)) * FMath::Sin(Phase);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChirpPhasorBankOracleTest, "ImpactSFXSynth.ChirpPhasorBank.MatchesClosedForm",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FChirpPhasorBankOracleTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	//Two modals per mode so the bank also pads a partial register
+	//Chirp rates of the sigmoid and exponent modals are in the range ChirpSynth derives from its ramp durations
+	const FChirpTestModal Modals[] = {
+		{ EChirpPhaseMode::Linear, 0.5f, -3.f, 440.f, 300.f, 0.f },
+		{ EChirpPhaseMode::Linear, 0.5f, -10.f, 2000.f, -1500.f, 0.f },
+		{ EChirpPhaseMode::Sigmoid, 0.5f, -3.f, 500.f, 10.f, 1500.f },
+		{ EChirpPhaseMode::Sigmoid, 0.5f, -10.f, 3000.f, 25.f, -2000.f },
+		{ EChirpPhaseMode::Exponent, 0.5f, -3.f, 500.f, 10.f, 1500.f },
+		{ EChirpPhaseMode::Exponent, 0.5f, -10.f, 3000.f, 25.f, -2000.f },
+	};
+	const TCHAR* ModeNames[] = { TEXT("Linear"), TEXT("Sigmoid"), TEXT("Exponent") };
+
+	//A quarter second starting at a non zero time covers many renorm periods and a partial last period
+	constexpr float SamplingRate = 48000.f;
+	constexpr int32 NumFrames = 12000 + FChirpPhasorBank::NumRenormSamples / 2;
+	constexpr float StartTime = 0.05f;
+	constexpr double MaxErrorRatio = 5e-3;
+	constexpr double MinSNR = 55.0;
+
+	TArray<float> TimeValues;
+	TimeValues.SetNumUninitialized(NumFrames);
+	for(int32 i = 0; i < NumFrames; i++)
+		TimeValues[i] = StartTime + i / SamplingRate;
+
+	FChirpPhasorBank PhasorBank;
+	PhasorBank.Init(UE_ARRAY_COUNT(Modals), SamplingRate);
+	TArray<float> Output;
+	Output.SetNumUninitialized(NumFrames);
+	for(int32 ModeIndex = 0; ModeIndex < UE_ARRAY_COUNT(ModeNames); ModeIndex++)
+	{
+		const EChirpPhaseMode Mode = static_cast<EChirpPhaseMode>(ModeIndex);
+		PhasorBank.Reset();
+		double TotalAmp = 0.0;
+		for(const FChirpTestModal& Modal : Modals)
+		{
+			if(Modal.Mode != Mode)
+				continue;
+			PhasorBank.AddModal(Modal.Mode, Modal.Amp, Modal.Decay, Modal.F0, Modal.ChirpRate, Modal.FreqRange);
+			TotalAmp += Modal.Amp;
+		}
+
+		FMemory::Memzero(Output.GetData(), NumFrames * sizeof(float));
+		PhasorBank.Synthesize(TimeValues, Output);
+
+		double MaxError = 0.0;
+		double SignalEnergy = 0.0;
+		double ErrorEnergy = 0.0;
+		for(int32 i = 0; i < NumFrames; i++)
+		{
+			double Expected = 0.0;
+			for(const FChirpTestModal& Modal : Modals)
+			{
+				if(Modal.Mode == Mode)
+					Expected += GetChirpOracle(Modal, TimeValues[i], TimeValues[0]);
+			}
+			const double Error = Output[i] - Expected;
+			MaxError = FMath::Max(MaxError, FMath::Abs(Error));
+			SignalEnergy += Expected * Expected;
+			ErrorEnergy += Error * Error;
+		}
+
+		const double SNR = 10.0 * FMath::LogX(10.0, SignalEnergy / FMath::Max(ErrorEnergy, UE_DOUBLE_SMALL_NUMBER));
+		TestTrue(FString::Printf(TEXT("%s max error %g of amplitude %g"), ModeNames[ModeIndex], MaxError, TotalAmp), MaxError <= MaxErrorRatio * TotalAmp);
+		TestTrue(FString::Printf(TEXT("%s SNR %.1f dB"), ModeNames[ModeIndex], SNR), SNR >= MinSNR);
+	}
+
+	//Output is accumulated, not overwritten
+	PhasorBank.Reset();
+	PhasorBank.AddModal(EChirpPhaseMode::Linear, 0.5f, 0.f, 440.f, 0.f, 0.f);
+	const TArrayView<float> ShortOutput = MakeArrayView(Output.GetData(), FChirpPhasorBank::NumRenormSamples);
+	for(float& Value : ShortOutput)
+		Value = 1.f;
+	PhasorBank.Synthesize(TimeValues, ShortOutput);
+	const FChirpTestModal ConstModal = { EChirpPhaseMode::Linear, 0.5f, 0.f, 440.f, 0.f, 0.f };
+	double MaxAddError = 0.0;
+	for(int32 i = 0; i < ShortOutput.Num(); i++)
+		MaxAddError = FMath::Max(MaxAddError, FMath::Abs(ShortOutput[i] - 1.0 - GetChirpOracle(ConstModal, TimeValues[i], TimeValues[0])));
+	TestTrue(FString::Printf(TEXT("Synthesize adds to the output, max error %g"), MaxAddError), MaxAddError <= MaxErrorRatio * ConstModal.Amp);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,101 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "CirBufferCustom.h"
+#include "Async/Async.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCirBufferCustomSPSCTest, "ImpactSFXSynth.CirBufferCustom.SPSCStress",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCirBufferCustomSPSCTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+
+	//A small, non power of two capacity so the ring is full or wraps on most calls
+	constexpr uint32 NumSamples = 1u << 22;
+	constexpr int32 MaxChunk = 173;
+	constexpr double TimeoutSeconds = 60.0;
+	TCircularAudioBufferCustom<uint32> Buffer(100);
+	TestEqual(TEXT("Capacity is rounded up to a power of two"), Buffer.GetCapacity(), 128u);
+
+	std::atomic<bool> bIsTimedOut(false);
+	const double StartTime = FPlatformTime::Seconds();
+
+	//Producer pushes an increasing sequence in random chunk sizes, single samples included
+	TFuture<void> Producer = Async(EAsyncExecution::Thread, [&Buffer, &bIsTimedOut]()
+	{
+		FRandomStream RandomStream(46);
+		uint32 Chunk[MaxChunk];
+		uint32 NextValue = 0;
+		while(NextValue < NumSamples && !bIsTimedOut.load(std::memory_order_relaxed))
+		{
+			const int32 ChunkSize = FMath::Min<int32>(RandomStream.RandRange(1, MaxChunk), NumSamples - NextValue);
+			if(ChunkSize == 1)
+			{
+				if(Buffer.Push(NextValue))
+					NextValue++;
+				else
+					FPlatformProcess::Yield();
+				continue;
+			}
+
+			for(int32 i = 0; i < ChunkSize; i++)
+				Chunk[i] = NextValue + i;
+			const int32 NumPushed = Buffer.Push(Chunk, ChunkSize);
+			NextValue += NumPushed;
+			if(NumPushed < ChunkSize)
+				FPlatformProcess::Yield();
+		}
+	});
+
+	//Consumer alternates between copying pops and zero-copy views
+	FRandomStream RandomStream(146);
+	uint32 ExpectedValue = 0;
+	uint32 NumErrors = 0;
+	uint32 Chunk[MaxChunk];
+	while(ExpectedValue < NumSamples)
+	{
+		if(FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+		{
+			bIsTimedOut = true;
+			break;
+		}
+
+		const int32 ChunkSize = RandomStream.RandRange(1, MaxChunk);
+		int32 NumRead = 0;
+		if(RandomStream.FRand() < 0.5f)
+		{
+			NumRead = Buffer.Pop(Chunk, ChunkSize);
+			for(int32 i = 0; i < NumRead; i++)
+				NumErrors += Chunk[i] != ExpectedValue + i;
+		}
+		else
+		{
+			TArrayView<const uint32> FirstView;
+			TArrayView<const uint32> SecondView;
+			NumRead = Buffer.PeekContiguous(0, ChunkSize, FirstView, SecondView);
+			for(int32 i = 0; i < FirstView.Num(); i++)
+				NumErrors += FirstView[i] != ExpectedValue + i;
+			for(int32 i = 0; i < SecondView.Num(); i++)
+				NumErrors += SecondView[i] != ExpectedValue + FirstView.Num() + i;
+			NumErrors += FirstView.Num() + SecondView.Num() != NumRead;
+			Buffer.CommitRead(NumRead);
+		}
+
+		ExpectedValue += NumRead;
+		if(NumRead == 0)
+			FPlatformProcess::Yield();
+	}
+	Producer.Wait();
+
+	TestFalse(TEXT("Finished before the timeout"), bIsTimedOut.load());
+	TestEqual(TEXT("Every pushed sample was popped"), ExpectedValue, NumSamples);
+	TestEqual(TEXT("Samples out of order or corrupted"), NumErrors, 0u);
+	TestEqual(TEXT("Buffer is empty"), Buffer.Num(), 0u);
+	return true;
+}
+
+#endif
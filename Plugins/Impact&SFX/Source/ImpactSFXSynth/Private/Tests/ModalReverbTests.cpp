@@ -0,0 +1,130 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "ModalReverb.h"
+#include "DSP/FFTAlgorithm.h"
+#include "DSP/FloatArrayMath.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LBSImpactSFXSynth
+{
+	namespace SynthTests
+	{
+		static constexpr int32 NumThirdOctaveBands = 23;
+
+		/** Energy of third octave bands centered from 100 Hz to 16 kHz, from a Welch average of Hann windowed frames. */
+		static void GetThirdOctaveEnergies(const TArray<float>& Signal, const float SamplingRate, TArray<double>& OutEnergies)
+		{
+			constexpr int32 NumFFT = 4096;
+			FFFTSettings FFTSettings;
+			FFTSettings.Log2Size = Audio::CeilLog2(NumFFT);
+			FFTSettings.bArrays128BitAligned = true;
+			FFTSettings.bEnableHardwareAcceleration = false;
+			const TUniquePtr<IFFTAlgorithm> FFT = FFFTFactory::NewFFTAlgorithm(FFTSettings);
+			check(FFT.IsValid());
+
+			FAlignedFloatBuffer InReal;
+			FAlignedFloatBuffer OutComplex;
+			FAlignedFloatBuffer OutPower;
+			InReal.SetNumUninitialized(FFT->NumInputFloats());
+			OutComplex.SetNumUninitialized(FFT->NumOutputFloats());
+			OutPower.SetNumUninitialized(FFT->NumOutputFloats() / 2);
+
+			TArray<double> BinPowers;
+			BinPowers.SetNumZeroed(OutPower.Num());
+			for(int32 Start = 0; Start + NumFFT <= Signal.Num(); Start += NumFFT / 2)
+			{
+				for(int32 i = 0; i < NumFFT; i++)
+					InReal[i] = Signal[Start + i] * 0.5f * (1.f - FMath::Cos(UE_TWO_PI * i / NumFFT));
+				FFT->ForwardRealToComplex(InReal.GetData(), OutComplex.GetData());
+				Audio::ArrayComplexToPower(OutComplex, OutPower);
+				for(int32 Bin = 0; Bin < OutPower.Num(); Bin++)
+					BinPowers[Bin] += OutPower[Bin];
+			}
+
+			OutEnergies.SetNumZeroed(NumThirdOctaveBands);
+			const float BinWidth = SamplingRate / NumFFT;
+			for(int32 Band = 0; Band < NumThirdOctaveBands; Band++)
+			{
+				const float Center = 100.f * FMath::Pow(2.f, Band / 3.f);
+				const int32 StartBin = FMath::CeilToInt32(Center * FMath::Pow(2.f, -1.f / 6.f) / BinWidth);
+				const int32 EndBin = FMath::Min(BinPowers.Num(), FMath::CeilToInt32(Center * FMath::Pow(2.f, 1.f / 6.f) / BinWidth));
+				for(int32 Bin = StartBin; Bin < EndBin; Bin++)
+					OutEnergies[Band] += BinPowers[Bin];
+			}
+		}
+
+		/** Render a reverb of one second of white noise plus one second of tail. Scattering draws from FMath::FRand, seeded here. */
+		static double RenderReverb(const bool bIsMultirate, const float SamplingRate, const int32 BlockSize, const TArray<float>& Input,
+								   TArray<float>& OutAudio)
+		{
+			FMath::RandInit(45);
+			FModalReverb ModalReverb(SamplingRate, FModalReverbParams(), 32, 128, 96, FModalReverb::DefaultAbsorption, 1.f, 1.f, 1.f, bIsMultirate);
+			OutAudio.SetNumZeroed(Input.Num());
+
+			const double StartTime = FPlatformTime::Seconds();
+			for(int32 Start = 0; Start < Input.Num(); Start += BlockSize)
+			{
+				TArrayView<float> OutView = TArrayView<float>(OutAudio).Slice(Start, BlockSize);
+				ModalReverb.CreateReverb(OutView, TArrayView<const float>(Input).Slice(Start, BlockSize),
+										 FModalReverb::DefaultAbsorption, 1.f, 1.f, 1.f, false);
+			}
+			return FPlatformTime::Seconds() - StartTime;
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModalReverbMultirateTest, "ImpactSFXSynth.ModalReverb.MultirateSpectralError",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FModalReverbMultirateTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	constexpr int32 BlockSize = 512;
+
+	//At 24 kHz the mid band reaches past the passband of a half-band stage, so only the low band is decimated
+	for(const float SamplingRate : { 48000.f, 24000.f })
+	{
+		const int32 NumBlocks = FMath::CeilToInt32(2.f * SamplingRate / BlockSize);
+
+		FRandomStream RandomStream(45);
+		TArray<float> Input;
+		Input.SetNumZeroed(NumBlocks * BlockSize);
+		for(int32 i = 0; i < Input.Num() / 2; i++)
+			Input[i] = RandomStream.FRandRange(-0.5f, 0.5f);
+
+		TArray<float> FullRateOut;
+		TArray<float> MultirateOut;
+		const double FullRateSeconds = RenderReverb(false, SamplingRate, BlockSize, Input, FullRateOut);
+		const double MultirateSeconds = RenderReverb(true, SamplingRate, BlockSize, Input, MultirateOut);
+
+		TArray<double> FullRateEnergies;
+		TArray<double> MultirateEnergies;
+		GetThirdOctaveEnergies(FullRateOut, SamplingRate, FullRateEnergies);
+		GetThirdOctaveEnergies(MultirateOut, SamplingRate, MultirateEnergies);
+
+		//Decimated bands stay within the passband of their half-band chains, which are flat within 0.01 dB,
+		//so the bands should match well within 1 dB
+		const float SamplingRateKHz = SamplingRate / 1000.f;
+		double MaxErrorDb = 0.0;
+		for(int32 Band = 0; Band < NumThirdOctaveBands; Band++)
+		{
+			const double ErrorDb = 10.0 * FMath::LogX(10.0, FMath::Max(MultirateEnergies[Band], UE_DOUBLE_SMALL_NUMBER)
+															/ FMath::Max(FullRateEnergies[Band], UE_DOUBLE_SMALL_NUMBER));
+			MaxErrorDb = FMath::Max(MaxErrorDb, FMath::Abs(ErrorDb));
+			TestTrue(FString::Printf(TEXT("%.0f kHz band %.0f Hz: error %.3f dB"), SamplingRateKHz, 100.f * FMath::Pow(2.f, Band / 3.f), ErrorDb),
+					 FMath::Abs(ErrorDb) <= 1.0);
+		}
+
+		const double AudioSeconds = Input.Num() / SamplingRate;
+		AddInfo(FString::Printf(TEXT("Max third octave error %.3f dB. CPU per instance at %.0f kHz: full rate %.2f%%, multirate %.2f%%"), MaxErrorDb,
+								SamplingRateKHz, 100.0 * FullRateSeconds / AudioSeconds, 100.0 * MultirateSeconds / AudioSeconds));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,136 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "MultiDelayReverbMix.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LBSImpactSFXSynth
+{
+	namespace SynthTests
+	{
+		/** The per line, per sample delay mix FMultiDelayReverbMix replaced. Delays are drawn from FMath::RandRange in the same order. */
+		class FDelayReverbMixScalar
+		{
+		public:
+			static constexpr int32 NumChannels = FMultiDelayReverbMix::NumChannels;
+
+			FDelayReverbMixScalar(const float SamplingRate, const float MinDelay, const float MaxDelay)
+			{
+				const int32 MinDelaySample = FMath::Max(1, FMath::FloorToInt32(MinDelay * SamplingRate));
+				const int32 MaxDelaySample = FMath::Max(MinDelaySample, FMath::CeilToInt32(MaxDelay * SamplingRate));
+				const int32 DelayStep = (MaxDelaySample - MinDelaySample) / NumChannels;
+				for(int32 i = 0; i < NumChannels; i++)
+				{
+					const int32 CurDelaySample = DelayStep * i + MinDelaySample;
+					const int32 DelaySample = i == 0 ? MinDelaySample : FMath::RandRange(CurDelaySample, CurDelaySample + DelayStep);
+					DelayBuffers[i].SetNumZeroed(DelaySample);
+					WriteIndexes[i] = 0;
+				}
+			}
+
+			void ProcessAudio(TArrayView<float> OutAudio, TArrayView<const float> InAudio, const float FeedbackGain)
+			{
+				const float DecayGain = FMath::Min(FeedbackGain / 2.0f, 0.49f);
+				for(int32 i = 0; i < OutAudio.Num(); i++)
+				{
+					float Taps[NumChannels];
+					float Sum = 0.f;
+					for(int32 j = 0; j < NumChannels; j++)
+					{
+						Taps[j] = DelayBuffers[j][WriteIndexes[j]];
+						Sum += Taps[j];
+					}
+					OutAudio[i] = Sum / 4.f;
+
+					for(int32 j = 0; j < NumChannels; j++)
+					{
+						float Mix = InAudio[i];
+						for(int32 k = 0; k < NumChannels; k++)
+							Mix += (j == k ? Taps[k] : -Taps[k]) * DecayGain;
+						DelayBuffers[j][WriteIndexes[j]] = Mix;
+						WriteIndexes[j] = (WriteIndexes[j] + 1) % DelayBuffers[j].Num();
+					}
+				}
+			}
+
+		private:
+			TArray<float> DelayBuffers[NumChannels];
+			int32 WriteIndexes[NumChannels];
+		};
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMultiDelayReverbMixGoldenTest, "ImpactSFXSynth.MultiDelayReverbMix.MatchesScalarMix",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMultiDelayReverbMixGoldenTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	constexpr float SamplingRate = 48000.f;
+	//Odd block size so blocks don't line up with the delays
+	constexpr int32 BlockSize = 509;
+	constexpr int32 NumBlocks = 200;
+	constexpr int32 Seed = 43;
+
+	//An impulse followed by short noise bursts, so the tail of each burst runs through the feedback loop many times
+	FRandomStream RandomStream(Seed);
+	TArray<float> Input;
+	Input.SetNumZeroed(BlockSize * NumBlocks);
+	Input[0] = 1.f;
+	for(int32 i = 0; i < Input.Num(); i++)
+	{
+		if(i % 24000 < 480)
+			Input[i] += RandomStream.FRandRange(-0.5f, 0.5f);
+	}
+
+	//Default delays of the TapDelayFF node, then a retrigger with longer ones which reuses the instance
+	const FVector2f DelayRanges[] = { { 0.1f, 0.2f }, { 0.15f, 0.45f }, { 0.01f, 0.02f } };
+	constexpr int32 NumTriggers = UE_ARRAY_COUNT(DelayRanges);
+	FMath::RandInit(Seed);
+	FMultiDelayReverbMix DelayMix(SamplingRate, 0.9f, DelayRanges[0].X, DelayRanges[0].Y);
+	for(int32 Trigger = 0; Trigger < NumTriggers; Trigger++)
+	{
+		const FVector2f& DelayRange = DelayRanges[Trigger];
+		if(Trigger > 0)
+		{
+			FMath::RandInit(Seed + Trigger);
+			DelayMix.Init(0.9f, DelayRange.X, DelayRange.Y);
+		}
+		FMath::RandInit(Seed + Trigger);
+		FDelayReverbMixScalar ScalarMix(SamplingRate, DelayRange.X, DelayRange.Y);
+
+		TArray<float> Expected;
+		Expected.SetNumZeroed(Input.Num());
+		TArray<float> Actual;
+		Actual.SetNumZeroed(Input.Num());
+		for(int32 Block = 0; Block < NumBlocks; Block++)
+		{
+			const TArrayView<const float> InView = TArrayView<const float>(Input).Slice(Block * BlockSize, BlockSize);
+			//Sweep the feedback gain across its clamp
+			const float FeedbackGain = 0.6f + 0.5f * Block / NumBlocks;
+			ScalarMix.ProcessAudio(TArrayView<float>(Expected).Slice(Block * BlockSize, BlockSize), InView, FeedbackGain);
+			TArrayView<float> OutView = TArrayView<float>(Actual).Slice(Block * BlockSize, BlockSize);
+			DelayMix.ProcessAudio(OutView, InView, FeedbackGain);
+		}
+
+		float MaxDiff = 0.f;
+		float MaxExpected = 0.f;
+		for(int32 i = 0; i < Input.Num(); i++)
+		{
+			MaxDiff = FMath::Max(MaxDiff, FMath::Abs(Expected[i] - Actual[i]));
+			MaxExpected = FMath::Max(MaxExpected, FMath::Abs(Expected[i]));
+		}
+
+		//Only the rounding of 2 * X - Sum against X - Y - Z - W differs
+		TestTrue(FString::Printf(TEXT("Delays %g to %g s: output is not silent"), DelayRange.X, DelayRange.Y), MaxExpected > 0.1f);
+		TestTrue(FString::Printf(TEXT("Delays %g to %g s: max error %g"), DelayRange.X, DelayRange.Y, MaxDiff), MaxDiff <= 1e-5f * MaxExpected);
+	}
+
+	return true;
+}
+
+#endif
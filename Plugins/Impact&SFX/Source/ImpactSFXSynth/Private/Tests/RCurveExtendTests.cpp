@@ -0,0 +1,101 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "Extend/RCurveExtend.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LBSImpactSFXSynth
+{
+	namespace SynthTests
+	{
+		/** A cyclic curve over [0, 1] whose last key repeats the first one. */
+		static URCurveExtend* MakeCyclicCurve(const int32 NumCycleData, const int32 Seed)
+		{
+			URCurveExtend* CurveExtend = NewObject<URCurveExtend>(GetTransientPackage());
+			FRandomStream RandomStream(Seed);
+			CurveExtend->Data.SetNumUninitialized(NumCycleData + 1);
+			for(int32 i = 0; i < NumCycleData; i++)
+				CurveExtend->Data[i] = RandomStream.FRandRange(-1.f, 1.f);
+			CurveExtend->Data[NumCycleData] = CurveExtend->Data[0];
+			CurveExtend->NumDataPoints = NumCycleData + 1;
+			CurveExtend->MinTime = 0.f;
+			CurveExtend->MaxTime = 1.f;
+			CurveExtend->TimeStep = 1.f / NumCycleData;
+			return CurveExtend;
+		}
+
+		/** The scalar loop GetArrayByTimeCyclicInterp replaced, with a double accumulator so it doesn't drift over long outputs. */
+		static void CyclicInterpScalar(TArrayView<const float> Data, const float Step, const float StartX, const float XStep, TArray<float>& OutArray)
+		{
+			const int32 NumData = Data.Num() - 1;
+			double Bin = static_cast<double>(StartX) / Step;
+			const double BinStep = static_cast<double>(XStep) / Step;
+			for(int32 i = 0; i < OutArray.Num(); i++)
+			{
+				const double LeftBin = FMath::Floor(Bin);
+				const float Percent = static_cast<float>(Bin - LeftBin);
+				const int32 LeftIndex = static_cast<int32>(static_cast<int64>(LeftBin) % NumData);
+				const int32 RightIndex = (LeftIndex + 1) % NumData;
+				OutArray[i] = Data[LeftIndex] * (1.0f - Percent) + Data[RightIndex] * Percent;
+				Bin += BinStep;
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRCurveExtendCyclicInterpTest, "ImpactSFXSynth.RCurveExtend.CyclicInterp",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRCurveExtendCyclicInterpTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	//Odd output length so the scalar tail after the 4-wide loop is covered
+	constexpr int32 NumSamples = 1003;
+	//Step ratios in units of one curve bin. The last ones wrap more than a whole cycle per sample
+	const float BinSteps[] = { 0.013f, 0.37f, 1.f, 1.5f, 7.25f };
+	const float CycleSteps[] = { 0.73f, 1.25f };
+	
+	//Power of two cyclic lengths take the mask path, the others the compare path
+	for(const int32 NumCycleData : { 64, 100, 4096 })
+	{
+		const TStrongObjectPtr<URCurveExtend> CurveExtend(MakeCyclicCurve(NumCycleData, NumCycleData));
+		const FRCurveExtendAssetProxy Proxy(CurveExtend.Get());
+		const float Step = CurveExtend->TimeStep;
+
+		TArray<float> XSteps;
+		for(const float BinStep : BinSteps)
+			XSteps.Add(BinStep * Step);
+		for(const float CycleStep : CycleSteps)
+			XSteps.Add(CycleStep * NumCycleData * Step);
+
+		for(const float XStep : XSteps)
+		{
+			for(const float StartX : { 0.f, 0.4f * Step, 0.37f })
+			{
+				TArray<float> Expected;
+				Expected.SetNumUninitialized(NumSamples);
+				CyclicInterpScalar(CurveExtend->GetDataView(), Step, StartX, XStep, Expected);
+
+				TArray<float> Actual;
+				Actual.SetNumUninitialized(NumSamples);
+				TArrayView<float> ActualView(Actual);
+				Proxy.GetArrayByTimeCyclicInterp(StartX, XStep, ActualView);
+
+				float MaxDiff = 0.f;
+				for(int32 i = 0; i < NumSamples; i++)
+					MaxDiff = FMath::Max(MaxDiff, FMath::Abs(Expected[i] - Actual[i]));
+
+				TestTrue(FString::Printf(TEXT("Length %d, start %g, step %g: max error %g"), NumCycleData, StartX, XStep, MaxDiff), MaxDiff <= 1e-5f);
+			}
+		}
+	}
+	
+	return true;
+}
+
+#endif
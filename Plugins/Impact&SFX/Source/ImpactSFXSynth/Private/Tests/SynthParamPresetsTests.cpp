@@ -0,0 +1,34 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "SynthParamPresets.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FResidualStatsSinTableTest, "ImpactSFXSynth.ResidualStats.SinTable",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FResidualStatsSinTableTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+
+	constexpr uint32 NumSinPoint = FResidualStats::NumSinPoint;
+	double MaxSinError = 0.0;
+	double MaxCosError = 0.0;
+	//Phase accumulators wrap around uint32, so also check indexes close to the top of the range
+	for(const uint32 Offset : { 0u, 7u * NumSinPoint, 0u - NumSinPoint })
+	{
+		for(uint32 i = 0; i < NumSinPoint; i++)
+		{
+			const double Angle = UE_DOUBLE_TWO_PI * i / NumSinPoint;
+			MaxSinError = FMath::Max(MaxSinError, FMath::Abs(FResidualStats::Sin(Offset + i) - FMath::Sin(Angle)));
+			MaxCosError = FMath::Max(MaxCosError, FMath::Abs(FResidualStats::Cos(Offset + i) - FMath::Cos(Angle)));
+		}
+	}
+
+	TestTrue(FString::Printf(TEXT("Sin max error %g"), MaxSinError), MaxSinError <= 1e-6);
+	TestTrue(FString::Printf(TEXT("Cos max error %g"), MaxCosError), MaxCosError <= 1e-6);
+	return true;
+}
+
+#endif
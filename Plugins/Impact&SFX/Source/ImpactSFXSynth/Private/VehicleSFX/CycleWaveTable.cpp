@@ -0,0 +1,157 @@
+﻿// Copyright 2023-2024, Le Binh Son, All Rights Reserved.
+
+#include "VehicleSFX/CycleWaveTable.h"
+#include "HalfBandResampler.h"
+
+namespace LBSImpactSFXSynth
+{
+	FCycleWaveTable::FCycleWaveTable()
+		: NumLevels(0)
+	{
+		Levels.SetNum(MaxNumLevels);
+		for(int32 i = 0; i < MaxNumLevels; i++)
+			Levels[i].Reserve(MaxTableLength >> i);
+	}
+
+	void FCycleWaveTable::Build(const FRCurveExtendAssetProxy& InCurve)
+	{
+		NumLevels = 0;
+
+		//Last key is redundant for a cyclic curve
+		const int32 NumCycleData = InCurve.GetNumValues() - 1;
+		if(NumCycleData < 1)
+			return;
+
+		//Never shorter than the curve so this step only interpolates and can't alias
+		const int32 ResampleLength = FMath::Max(MinTableLength, static_cast<int32>(FMath::RoundUpToPowerOfTwo(NumCycleData)));
+		const float XStep = (InCurve.GetXEnd() - InCurve.GetXStart()) / ResampleLength;
+		if(ResampleLength <= MaxTableLength)
+		{
+			Levels[0].SetNumUninitialized(ResampleLength, EAllowShrinking::No);
+			TArrayView<float> BaseView = TArrayView<float>(Levels[0]);
+			InCurve.GetArrayByTimeCyclicInterp(InCurve.GetXStart(), XStep, BaseView);
+		}
+		else
+		{
+			ScratchBuffers[0].SetNumUninitialized(ResampleLength, EAllowShrinking::No);
+			TArrayView<float> ResampleView = TArrayView<float>(ScratchBuffers[0]);
+			InCurve.GetArrayByTimeCyclicInterp(InCurve.GetXStart(), XStep, ResampleView);
+
+			int32 SrcIndex = 0;
+			for(int32 Length = ResampleLength / 2; Length > MaxTableLength; Length /= 2)
+			{
+				FAlignedFloatBuffer& Lower = ScratchBuffers[1 - SrcIndex];
+				Lower.SetNumUninitialized(Length, EAllowShrinking::No);
+				DecimateCyclic(ScratchBuffers[SrcIndex], Lower);
+				SrcIndex = 1 - SrcIndex;
+			}
+			
+			Levels[0].SetNumUninitialized(MaxTableLength, EAllowShrinking::No);
+			DecimateCyclic(ScratchBuffers[SrcIndex], Levels[0]);
+		}
+
+		NumLevels = 1;
+		for(int32 Length = Levels[0].Num() / 2; Length >= MinTableLength; Length /= 2)
+		{
+			Levels[NumLevels].SetNumUninitialized(Length, EAllowShrinking::No);
+			DecimateCyclic(Levels[NumLevels - 1], Levels[NumLevels]);
+			NumLevels++;
+		}
+	}
+
+	void FCycleWaveTable::DecimateCyclic(TArrayView<const float> Upper, TArrayView<float> Lower)
+	{
+		const int32 UpperMask = Upper.Num() - 1;
+		const int32 NumLower = Lower.Num();
+		check(NumLower * 2 == Upper.Num());
+		
+		//Zero phase half-band: the center tap is 0.5 and the other non-zero taps are at odd offsets from it
+		const float* EvenTaps = FHalfBandFilter::GetEvenTaps();
+		for(int32 i = 0; i < NumLower; i++)
+		{
+			const int32 Center = 2 * i;
+			float Sum = 0.5f * Upper[Center];
+			for(int32 j = 0; j < FHalfBandFilter::NumEvenTaps; j++)
+				Sum += EvenTaps[j] * Upper[(Center + FHalfBandFilter::CenterTap - 2 * j) & UpperMask];
+			Lower[i] = Sum;
+		}
+	}
+
+	int32 FCycleWaveTable::GetLevel(const float PercentStep) const
+	{
+		//Pick the largest table which is read at most one table sample per output sample
+		const float BaseStep = FMath::Abs(PercentStep) * Levels[0].Num();
+		if(BaseStep <= 1.f)
+			return 0;
+		
+		return FMath::Min(NumLevels - 1, FMath::CeilToInt32(FMath::Log2(BaseStep)));
+	}
+
+	void FCycleWaveTable::Read(float StartPercent, const float PercentStep, TArrayView<float> OutArray) const
+	{
+		const int32 NumSamples = OutArray.Num();
+		if(NumLevels <= 0 || StartPercent < 0.f)
+		{
+			FMemory::Memzero(OutArray.GetData(), NumSamples * sizeof(float));
+			return;
+		}
+		
+		const FAlignedFloatBuffer& Table = Levels[GetLevel(PercentStep)];
+		const float* TableData = Table.GetData();
+		const int32 Length = Table.Num();
+		const float LengthF = static_cast<float>(Length);
+		const int32 Mask = Length - 1;
+		
+		const float Step = PercentStep * Length;
+		float Phase = (StartPercent - FMath::FloorToFloat(StartPercent)) * Length;
+		float* OutData = OutArray.GetData();
+		
+		const int32 NumToSimd = NumSamples & ~(AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER - 1);
+		const float BlockStep = Step * AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER;
+		const VectorRegister4Float LaneOffset = MakeVectorRegisterFloat(0.f, Step, 2.f * Step, 3.f * Step);
+		const VectorRegister4Int MaskVector = VectorIntSet1(Mask);
+		const VectorRegister4Int OneIntVector = VectorIntSet1(1);
+		
+		alignas(16) int32 LeftIndices[AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER];
+		alignas(16) int32 RightIndices[AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER];
+		alignas(16) float LeftValues[AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER];
+		alignas(16) float RightValues[AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER];
+		for(int32 i = 0; i < NumToSimd; i += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
+		{
+			const VectorRegister4Float PhaseVector = VectorAdd(VectorSetFloat1(Phase), LaneOffset);
+			const VectorRegister4Float FloorVector = VectorFloor(PhaseVector);
+			const VectorRegister4Float FracVector = VectorSubtract(PhaseVector, FloorVector);
+			
+			//Table lengths are power of 2 so wrapping is a mask
+			const VectorRegister4Int IndexVector = VectorFloatToInt(FloorVector);
+			VectorIntStoreAligned(VectorIntAnd(IndexVector, MaskVector), LeftIndices);
+			VectorIntStoreAligned(VectorIntAnd(VectorIntAdd(IndexVector, OneIntVector), MaskVector), RightIndices);
+			for(int32 j = 0; j < AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER; j++)
+			{
+				LeftValues[j] = TableData[LeftIndices[j]];
+				RightValues[j] = TableData[RightIndices[j]];
+			}
+			
+			const VectorRegister4Float LeftVector = VectorLoadAligned(LeftValues);
+			const VectorRegister4Float RightVector = VectorLoadAligned(RightValues);
+			VectorStore(VectorMultiplyAdd(VectorSubtract(RightVector, LeftVector), FracVector, LeftVector), &OutData[i]);
+
+			Phase += BlockStep;
+			if(Phase >= LengthF)
+				Phase = FMath::Fmod(Phase, LengthF);
+		}
+
+		for(int32 i = NumToSimd; i < NumSamples; i++)
+		{
+			const int32 Index = FMath::FloorToInt32(Phase);
+			const float Percent = Phase - Index;
+			const float Left = TableData[Index & Mask];
+			const float Right = TableData[(Index + 1) & Mask];
+			OutData[i] = Left + (Right - Left) * Percent;
+			
+			Phase += Step;
+			if(Phase >= LengthF)
+				Phase = FMath::Fmod(Phase, LengthF);
+		}
+	}
+}
@@ -43,6 +43,9 @@ namespace LBSImpactSFXSynth
 			return;
 		}
 
+		UpdateWaveTable(InFirstCurve, FirstCurve, FirstWaveTable);
+		UpdateWaveTable(InSecondCurve, SecondCurve, SecondWaveTable);
+		
 		FirstStateDutyCycle = FMath::Clamp(FirstStateDutyCycle, 0.f, 1.f);
 		const float SecondStateDutyCycle = 1.f - FirstStateDutyCycle;
 		const float CyclePercentPerSample = InFreq / SamplingRate;
@@ -64,7 +67,7 @@ namespace LBSImpactSFXSynth
 				NumGenSamples = FMath::Min(NumSamplesToGen, NumSamplesFirstState - CurrentCycleIndex);
 				TArrayView<float> OutBufferView = OutAudio.Slice(CurrentOutputBufferIdx, NumGenSamples);
 				const float FirstCyclePercent = CurrentCycleIndex * FirstFreqScale / NumSamplesFirstState;
-				InFirstCurve->GetArrayByTimeCyclicInterp(FirstCyclePercent, FirstCurveStep, OutBufferView);
+				FirstWaveTable.Read(FirstCyclePercent, FirstCurveStep, OutBufferView);
 				MergeNoise(FirstStateNoiseMode, FirstStateNoiseAmp, OutBufferView);
 			}
 			else if (NumSamplesSecondState > 0)
@@ -72,7 +75,7 @@ namespace LBSImpactSFXSynth
 				NumGenSamples = FMath::Min(NumSamplesToGen, NumSamplesPerCycle - CurrentCycleIndex);
 				TArrayView<float> OutBufferView = OutAudio.Slice(CurrentOutputBufferIdx, NumGenSamples);
 				const float SecondCyclePercent = (CurrentCycleIndex - NumSamplesFirstState) * SecondFreqScale / NumSamplesSecondState;
-				InSecondCurve->GetArrayByTimeCyclicInterp(SecondCyclePercent, SecondCurveStep, OutBufferView);
+				SecondWaveTable.Read(SecondCyclePercent, SecondCurveStep, OutBufferView);
 				MergeNoise(SecondStateNoiseMode, SecondStateNoiseAmp, OutBufferView);
 			}
 			CurrentCycleIndex = (CurrentCycleIndex + NumGenSamples) % NumSamplesPerCycle;
@@ -83,6 +86,16 @@ namespace LBSImpactSFXSynth
 			ArrayMultiplyByConstantInPlace(OutAudio, InAmp);
 	}
 
+	void FTwoStatesForceGen::UpdateWaveTable(const FRCurveExtendAssetProxyPtr& InCurve, FRCurveExtendAssetProxyPtr& OutCachedCurve, FCycleWaveTable& OutWaveTable)
+	{
+		//Only bake when the curve is changed. Proxies are immutable so pointer comparison is enough
+		if(InCurve == OutCachedCurve && OutWaveTable.IsValid())
+			return;
+
+		OutCachedCurve = InCurve;
+		OutWaveTable.Build(*InCurve);
+	}
+
 	void FTwoStatesForceGen::RemapCurrentCycleIndex(const int32 NumSamplesPerCycle, const int32 NumSamplesFirstState, const int32 NumSamplesSecondState)
 	{
 		if(NumSamplesFirstState == LastNumSamplesFirstState && NumSamplesSecondState == LastNumSamplesSecondState)
@@ -2,8 +2,10 @@
 
 #include "VehicleSFX/VehicleEngineEulerSynth.h"
 
+#include "ExtendArrayMath.h"
 #include "ModalSynth.h"
 #include "ImpactSFXSynth/Public/Utils.h"
+#include "DSP/FloatArrayMath.h"
 
 #define FREQ_BASE (100.0f)
 #define AMP_THRESH (1e-5f)
@@ -14,15 +16,18 @@ namespace LBSImpactSFXSynth
 													const FImpactModalObjAssetProxyPtr& ModalsParams,
 													const int32 NumModal, const int32 NumModalNonThrottle,
 													const float InHarmonicGain, 
-													const int32 InSeed)
+													const int32 InSeed, const float InControlRate)
 		: SamplingRate(InSamplingRate), LastFreq(0.f), BaseFreq(0.f),
-	     LastHarmonicRand(0.f), 
+	     LastHarmonicRand(0.f), RampRemaining(0), bHasCoefs(false),
 		 PrevRPM(-1.f), DecelerationTimer(0.f), bIsNoThrottle(false)
 	{
 		Seed = InSeed > -1 ? InSeed : FMath::Rand();
 		RandomStream = FRandomStream(Seed);
 		TimeStep = 1.f / SamplingRate;
 		FrameTime = 0.f;
+		ControlPeriod = FMath::Max(1, FMath::RoundToInt(SamplingRate / FMath::Max(1.f, InControlRate)));
+		//Follow the RPM at the first block
+		ControlCounter = ControlPeriod;
 		
 		NumPulsePerCycle = FMath::Max(1, InNumPulsePerCycle);
 		RPMBaseLine = FREQ_BASE / NumPulsePerCycle * 60.f;
@@ -57,35 +62,52 @@ namespace LBSImpactSFXSynth
 		NumModalSynth = NumModals;
 		
 		const int32 ClearSize = NumModals * sizeof(float);
-		D2Buffer.SetNumUninitialized(NumModals);
-		D1Buffer.SetNumUninitialized(NumModals);
-		TwoRCosBuffer.SetNumUninitialized(NumModals);
+		RealBuffer.SetNumUninitialized(NumModals);
+		ImgBuffer.SetNumUninitialized(NumModals);
+		PBuffer.SetNumUninitialized(NumModals);
+		QBuffer.SetNumUninitialized(NumModals);
+		DecayBuffer.SetNumUninitialized(NumModals);
+		AngleBuffer.SetNumUninitialized(NumModals);
+		TargetPBuffer.SetNumUninitialized(NumModals);
+		TargetQBuffer.SetNumUninitialized(NumModals);
+		PDeltaBuffer.SetNumUninitialized(NumModals);
+		QDeltaBuffer.SetNumUninitialized(NumModals);
 		CurrentEnvelopeBuffer.SetNumUninitialized(NumModals);
 		TargetEnvelopBuffer.SetNumUninitialized(NumModals);
 		CurrentFreqBuffer.SetNumUninitialized(NumModals);
 		FinalAmpBuffer.SetNumUninitialized(NumModals);
 		
-		FMemory::Memzero(D1Buffer.GetData(), ClearSize);
-		FMemory::Memzero(D2Buffer.GetData(), ClearSize);
-		FMemory::Memzero(TwoRCosBuffer.GetData(), ClearSize);
+		FMemory::Memzero(RealBuffer.GetData(), ClearSize);
+		FMemory::Memzero(ImgBuffer.GetData(), ClearSize);
+		FMemory::Memzero(AngleBuffer.GetData(), ClearSize);
+		FMemory::Memzero(PDeltaBuffer.GetData(), ClearSize);
+		FMemory::Memzero(QDeltaBuffer.GetData(), ClearSize);
 		FMemory::Memzero(CurrentEnvelopeBuffer.GetData(), ClearSize);
 		FMemory::Memzero(TargetEnvelopBuffer.GetData(), ClearSize);
 		FMemory::Memzero(CurrentFreqBuffer.GetData(), ClearSize);
 		FMemory::Memzero(FinalAmpBuffer.GetData(), ClearSize);
 
+		//Harmonics never decay by themselves. Their level is set by the envelopes
+		for(int j = 0; j < NumModals; j++)
+			DecayBuffer[j] = 1.0f;
+		
 		const float PiTimeStep = UE_TWO_PI * TimeStep;
 		for(int i = 0, j = 0; i < NumUsedParams; i++, j++)
 		{
 			const float Amp = ModalsParams[i];
 			i+=2;
 			const float Freq = ModalsParams[i];
-			const float Angle = Freq * PiTimeStep;
-			
-			TwoRCosBuffer[j] = 2.f * FMath::Cos(Angle);
-			D1Buffer[j] =  Amp * FMath::Sin(Angle);
+
+			//Start at -i * Amp so the output is Amp * sin(n * Angle)
+			ImgBuffer[j] = -Amp;
+			AngleBuffer[j] = Freq * PiTimeStep;
 			CurrentFreqBuffer[j] = Freq;
 			FinalAmpBuffer[j] = 1.0f;
 		}
+
+		ExtendArrayMath::ArrayEulerRotationCoefs(AngleBuffer, DecayBuffer, -1, PBuffer, QBuffer);
+		FMemory::Memcpy(TargetPBuffer.GetData(), PBuffer.GetData(), ClearSize);
+		FMemory::Memcpy(TargetQBuffer.GetData(), QBuffer.GetData(), ClearSize);
 	}
 
 	void FVehicleEngineEulerSynth::Generate(FMultichannelBufferView& OutAudio, const FVehicleEngineParams& Params, const FImpactModalObjAssetProxyPtr& ModalsParams)
@@ -95,6 +117,7 @@ namespace LBSImpactSFXSynth
 			return;
 		
 		FrameTime = TimeStep * NumOutputFrames;
+		ControlCounter += NumOutputFrames;
 		const float FreqRPM = Params.RPM / 60.f * NumPulsePerCycle;
 		BaseFreq = FMath::Clamp(FreqRPM * Params.FreqScale, 20.0f, 20000.0f);
 		const float DeltaRPM = Params.RPM - LastFreq / NumPulsePerCycle * 60.f;
@@ -133,23 +156,31 @@ namespace LBSImpactSFXSynth
 			LastHarmonicRand += FrameTime;
 		}
 
-		UpdateFreqParams(Params, ModalData, RPMFreqRate, FreqVar);
+		//Only follow RPM at control rate. Coefficients are ramped in between so there is no zipper noise
+		if(ControlCounter >= ControlPeriod)
+			UpdateFreqParams(Params, ModalData, RPMFreqRate, FreqVar);
+		UpdateFinalAmps(Params);
 		
 		NumModalSynth = GetNumNonZeroEnvelop();
-		if(NumModalSynth <= 1)
+		
+		int32 StartFrame = 0;
+		if(RampRemaining > 0)
 		{
-			for(int i = 0; i < NumOutputFrames; i++)
+			const int32 NumRampFrames = FMath::Min(RampRemaining, NumOutputFrames);
+			RenderHarmonics(HarmonicBuffer.Slice(0, NumRampFrames), true);
+			RampRemaining -= NumRampFrames;
+			StartFrame = NumRampFrames;
+
+			//Snap to targets to remove any accumulated rounding error of the ramp
+			if(RampRemaining <= 0)
 			{
-				const float OutValue = D1Buffer[0] * TwoRCosBuffer[0] - D2Buffer[0];
-				D2Buffer[0] = D1Buffer[0];
-				D1Buffer[0] = OutValue;
-				HarmonicBuffer[i] = OutValue * FinalAmpBuffer[0];
+				FMemory::Memcpy(PBuffer.GetData(), TargetPBuffer.GetData(), PBuffer.Num() * sizeof(float));
+				FMemory::Memcpy(QBuffer.GetData(), TargetQBuffer.GetData(), QBuffer.Num() * sizeof(float));
 			}
 		}
-		else
-		{
-			VectorSynthHarmonics(HarmonicBuffer);
-		}
+		
+		if(StartFrame < NumOutputFrames)
+			RenderHarmonics(HarmonicBuffer.Slice(StartFrame, NumOutputFrames - StartFrame), false);
 
 		TArray<int32> ToRemoveKeys;
 		ToRemoveKeys.Empty(EnvelopeIdxMap.Num());
@@ -179,18 +210,43 @@ namespace LBSImpactSFXSynth
 
 	void FVehicleEngineEulerSynth::UpdateFreqParams(const FVehicleEngineParams& Params, const TArrayView<const float> ModalData, const float RPMFreqRate, const float FreqVar)
 	{
+		ControlCounter = 0;
+		
 		for(int i = 2, j = 0; i < NumUsedParams && j < NumModalSynth; i += 3, j++)
 		{
 			const float FreqScale = ModalData[i] * Params.FreqScale;
 			const float FreqRPM = GetRandFreq(Params, RPMFreqRate, FreqVar, FreqScale);
-			const float Angle =  FreqRPM * UE_TWO_PI * TimeStep;
-			TwoRCosBuffer[j] = 2.f * FMath::Cos(Angle);
-
-			const float y1D = D1Buffer[j];
-			D2Buffer[j] = y1D - (y1D - D2Buffer[j]) * FreqRPM / CurrentFreqBuffer[j];
+			AngleBuffer[j] = FreqRPM * UE_TWO_PI * TimeStep;
 			CurrentFreqBuffer[j] = FreqRPM;
-			
-			const float LowPassAmp = ConvertLowPassDbToLinear(FreqRPM, Params.CutoffFreq, Params.FallOffDb);
+		}
+
+		//A rotation keeps the magnitude of each harmonic so no state correction is needed when the frequency changes
+		ExtendArrayMath::ArrayEulerRotationCoefs(AngleBuffer, DecayBuffer, NumModalSynth, TargetPBuffer, TargetQBuffer);
+		
+		const int32 NumModals = PBuffer.Num();
+		if(!bHasCoefs)
+		{
+			//Jump to the RPM at the first update
+			bHasCoefs = true;
+			RampRemaining = 0;
+			FMemory::Memcpy(PBuffer.GetData(), TargetPBuffer.GetData(), NumModals * sizeof(float));
+			FMemory::Memcpy(QBuffer.GetData(), TargetQBuffer.GetData(), NumModals * sizeof(float));
+			return;
+		}
+
+		RampRemaining = ControlPeriod;
+		const float RampScale = 1.f / ControlPeriod;
+		Audio::ArraySubtract(TargetPBuffer, PBuffer, PDeltaBuffer);
+		Audio::ArraySubtract(TargetQBuffer, QBuffer, QDeltaBuffer);
+		Audio::ArrayMultiplyByConstantInPlace(PDeltaBuffer, RampScale);
+		Audio::ArrayMultiplyByConstantInPlace(QDeltaBuffer, RampScale);
+	}
+
+	void FVehicleEngineEulerSynth::UpdateFinalAmps(const FVehicleEngineParams& Params)
+	{
+		for(int j = 0; j < NumModalSynth && j < NumTrueModal; j++)
+		{
+			const float LowPassAmp = ConvertLowPassDbToLinear(CurrentFreqBuffer[j], Params.CutoffFreq, Params.FallOffDb);
 			if(LowPassAmp <= AMP_THRESH)
 			{
 				CurrentEnvelopeBuffer[j] = 0.f;
@@ -241,7 +297,7 @@ namespace LBSImpactSFXSynth
 		
 		if(OldNumModals < CurrentModeNumModals)
 		{
-			const int32 NumModals = FMath::Min(CurrentModeNumModals, D1Buffer.Num());
+			const int32 NumModals = FMath::Min(CurrentModeNumModals, RealBuffer.Num());
 			for(int j = OldNumModals; j < NumModals; j++)
 			{
 				AddToInterpEnv(j, Params.HarmonicGain, 2.0f);
@@ -249,7 +305,7 @@ namespace LBSImpactSFXSynth
 		}
 		else if (OldNumModals > CurrentModeNumModals)
 		{
-			const int32 NumModals = FMath::Min(OldNumModals, TwoRCosBuffer.Num());
+			const int32 NumModals = FMath::Min(OldNumModals, RealBuffer.Num());
 			for(int j = CurrentModeNumModals; j < NumModals; j++)
 			{
 				AddToInterpEnv(j, 0.f, 10.f);
@@ -270,37 +326,16 @@ namespace LBSImpactSFXSynth
 		CurrentModeNumModals = NumTrueModal;
 	}
 
-	void FVehicleEngineEulerSynth::VectorSynthHarmonics(TArrayView<float> OutBuffer)
+	void FVehicleEngineEulerSynth::RenderHarmonics(TArrayView<float> OutBuffer, const bool bIsRamping)
 	{
-		const float* TwoRCosData = TwoRCosBuffer.GetData();
-		float* OutL1BufferPtr = D1Buffer.GetData();
-		float* OutL2BufferPtr = D2Buffer.GetData();
-		float* EnvelopBufferPtr = FinalAmpBuffer.GetData();
-		
-		const int32 NumOutputFrames = OutBuffer.Num();
-		for(int i = 0; i < NumOutputFrames; i++)
+		if(bIsRamping)
 		{
-			VectorRegister4Float SumModalVector = VectorZeroFloat();
-			float SumVal[4];
-			for(int j = 0; j < NumModalSynth; j += AUDIO_NUM_FLOATS_PER_VECTOR_REGISTER)
-			{
-				VectorRegister4Float y1 = VectorLoadAligned(&OutL1BufferPtr[j]);
-				VectorRegister4Float y2 = VectorLoadAligned(&OutL2BufferPtr[j]);
-
-				VectorRegister4Float TwoRCos = VectorMultiply(VectorLoadAligned(&TwoRCosData[j]), y1);
-				
-				VectorStore(y1, &OutL2BufferPtr[j]);
-				y1 = VectorSubtract(TwoRCos, y2);
-				VectorStore(y1, &OutL1BufferPtr[j]);
-				
-				VectorRegister4Float EnvReg = VectorLoadAligned(&EnvelopBufferPtr[j]);
-				SumModalVector = VectorMultiplyAdd(EnvReg, y1, SumModalVector);
-			}
-									
-			VectorStore(SumModalVector, SumVal);
-			const float SampleSum = SumVal[0] + SumVal[1] + SumVal[2] + SumVal[3];
-			
-			OutBuffer[i] = SampleSum;
+			ExtendArrayMath::ArrayImpactModalEulerRamp(RealBuffer, ImgBuffer, PBuffer, QBuffer, PDeltaBuffer, QDeltaBuffer,
+														DecayBuffer, FinalAmpBuffer, NumModalSynth, OutBuffer);
+		}
+		else
+		{
+			ExtendArrayMath::ArrayImpactModalEuler(RealBuffer, ImgBuffer, PBuffer, QBuffer, FinalAmpBuffer, NumModalSynth, OutBuffer);
 		}
 	}
 
@@ -5,6 +5,7 @@
 #include "ExtendArrayMath.h"
 #include "ImpactSFXSynthLog.h"
 #include "ModalSynth.h"
+#include "DSP/FloatArrayMath.h"
 
 #define FREQ_BASE (100.0f)
 #define EXPONENT (2.718281828459045f)
@@ -16,15 +17,17 @@ namespace LBSImpactSFXSynth
 	FVehicleEngineSynth::FVehicleEngineSynth(const float InSamplingRate, const int32 InNumPulsePerCycle,
 													const FImpactModalObjAssetProxyPtr& ModalsParams,
 													const int32 NumModal, const float InHarmonicGain, const float InHarmonicFreqScale,
-													const int32 InSeed)
+													const int32 InSeed, const float InControlRate)
 		: SamplingRate(InSamplingRate), LastFreq(0.f), BaseFreq(0.f),
 	     LastHarmonicRand(0.f), HarmonicGain(InHarmonicGain), HarmonicFreqScale(InHarmonicFreqScale),
+		 ControlCounter(0), RampRemaining(0), bIsTargetChanged(false), bIsFreqChanged(false), bHasCoefs(false),
 		 CurrentNumModalUsed(0), PrevRPM(0.f), DecelerationTimer(0.f), bIsInDeceleration(false)
 	{
 		Seed = InSeed > -1 ? InSeed : FMath::Rand();
 		RandomStream = FRandomStream(Seed);
 		TimeStep = 1.f / SamplingRate;
 		FrameTime = 0.f;
+		ControlPeriod = FMath::Max(1, FMath::RoundToInt(SamplingRate / FMath::Max(1.f, InControlRate)));
 		
 		NumPulsePerCycle = FMath::Max(1, InNumPulsePerCycle);
 		RPMBaseLine = FREQ_BASE / NumPulsePerCycle * 60.f;
@@ -64,13 +67,23 @@ namespace LBSImpactSFXSynth
 		FMemory::Memzero(PBuffer.GetData(), ClearSize);
 
 		DecayBuffer.SetNumUninitialized(NumModals);
+		AngleBuffer.SetNumUninitialized(NumModals);
+		FMemory::Memzero(AngleBuffer.GetData(), ClearSize);
+
+		TargetPBuffer.SetNumUninitialized(NumModals);
+		TargetQBuffer.SetNumUninitialized(NumModals);
+		PDeltaBuffer.SetNumUninitialized(NumModals);
+		QDeltaBuffer.SetNumUninitialized(NumModals);
+		FMemory::Memzero(TargetPBuffer.GetData(), ClearSize);
+		FMemory::Memzero(TargetQBuffer.GetData(), ClearSize);
+		FMemory::Memzero(PDeltaBuffer.GetData(), ClearSize);
+		FMemory::Memzero(QDeltaBuffer.GetData(), ClearSize);
 		
-		for(int i = 0, j = 0; i < NumUsedParams; i+=3, j++)
-		{
-			RealBuffer[j] = ModalsParams[i] * HarmonicGain;
+		for(int j = 0; j < NumModals; j++)
 			DecayBuffer[j] = 1.0f;
-		}
 		
+		for(int i = 0, j = 0; i < NumUsedParams; i+=3, j++)
+			RealBuffer[j] = ModalsParams[i] * HarmonicGain;
 	}
 
 	void FVehicleEngineSynth::Generate(FMultichannelBufferView& OutAudio, const FVehicleEngineParams& Params, const FImpactModalObjAssetProxyPtr& ModalsParams)
@@ -99,6 +112,9 @@ namespace LBSImpactSFXSynth
 		const float FreqVar = Params.HarmonicFluctuation * RPMChangeFactor / 5.0f;
 		
 		FindRPMSlope(Params);
+		ControlCounter += NumOutputFrames;
+		bIsFreqChanged = bIsFreqChanged || BaseFreq != LastFreq;
+		
 		const float RandChance = FMath::Clamp(RPMCurve * 2.f, 0.5f, 1.f);
 		if(LastHarmonicRand > DeltaRand || ModalsParams->IsParamChanged())
 		{
@@ -118,7 +134,7 @@ namespace LBSImpactSFXSynth
 				const float RandAmp = FMath::Max(0.f, (1.0f + (RandomStream.FRand() - 0.5f) * MaxAmpRand + AmpRandRange * RandomStream.FRand()));
 				const float MaxAmp = FMath::Min(AmpMod * RandAmp, AmpMod * 1.25f);
 				
-				const float FreqRPM = GetRandFreqPerSamplingRate(Params, RPMFreqRate, FreqVar, Freq) * UE_TWO_PI;
+				AngleBuffer[j] = GetRandFreqPerSamplingRate(Params, RPMFreqRate, FreqVar, Freq) * UE_TWO_PI;
 				
 				float Decay = 1.f;
 					
@@ -142,56 +158,57 @@ namespace LBSImpactSFXSynth
 					Decay = FMath::Exp(-(5.f + RandomStream.FRand() * 5.f) / SamplingRate);
 					
 				DecayBuffer[j] = Decay;
-				PBuffer[j] = FMath::Cos(FreqRPM) * Decay;
-				QBuffer[j] = FMath::Sin(FreqRPM) * Decay;
 			}
+			bIsTargetChanged = true;
 		}
 		else
 		{
 			LastHarmonicRand += FrameTime;
 			
-			if(BaseFreq != LastFreq)
+			//Only follow RPM at control rate. Coefficients are ramped in between so there is no zipper noise
+			if(bIsFreqChanged && ControlCounter >= ControlPeriod)
 			{
 				for(int i = 2, j = 0; i < NumUsedParams; i += 3, j++)
 				{
 					const float FreqScale = (ModalData[i] * HarmonicFreqScale);
-					const float FreqRPM = GetRandFreqPerSamplingRate(Params, RPMFreqRate, FreqVar, FreqScale) * UE_TWO_PI;
-					
-					PBuffer[j] = FMath::Cos(FreqRPM) * DecayBuffer[j];
-					QBuffer[j] = FMath::Sin(FreqRPM) * DecayBuffer[j];
+					AngleBuffer[j] = GetRandFreqPerSamplingRate(Params, RPMFreqRate, FreqVar, FreqScale) * UE_TWO_PI;
 				}
+				bIsTargetChanged = true;
 			}
 		}
-		
-		if(CurrentNumModalUsed == 1)
+
+		if(bIsTargetChanged)
+			UpdateTargetCoefs();
+
+		int32 StartFrame = 0;
+		if(RampRemaining > 0)
 		{
-			for(int i = 0; i < NumOutputFrames; i++)
+			const int32 NumRampFrames = FMath::Min(RampRemaining, NumOutputFrames);
+			RenderHarmonics(HarmonicBuffer.Slice(0, NumRampFrames), true);
+			RampRemaining -= NumRampFrames;
+			StartFrame = NumRampFrames;
+
+			//Snap to targets to remove any accumulated rounding error of the ramp
+			if(RampRemaining <= 0)
 			{
-				const float Real = RealBuffer[0] * PBuffer[0] - ImgBuffer[0] * QBuffer[0];
-				const float Img = ImgBuffer[0] * PBuffer[0] + RealBuffer[0] * QBuffer[0];
-				RealBuffer[0] = Real;
-				ImgBuffer[0] = Img;
-				HarmonicBuffer[i] = Real;
+				FMemory::Memcpy(PBuffer.GetData(), TargetPBuffer.GetData(), PBuffer.Num() * sizeof(float));
+				FMemory::Memcpy(QBuffer.GetData(), TargetQBuffer.GetData(), QBuffer.Num() * sizeof(float));
 			}
 		}
-		else
-		{
-			ExtendArrayMath::ArrayImpactModalEuler(RealBuffer, ImgBuffer, PBuffer, QBuffer,
-													  CurrentNumModalUsed, HarmonicBuffer);
-		}
-			
-		for(int i = 0; i < UpwardGainModalIdx.Num(); i++)
+		
+		if(StartFrame < NumOutputFrames)
+			RenderHarmonics(HarmonicBuffer.Slice(StartFrame, NumOutputFrames - StartFrame), false);
+		
+		for(int i = UpwardGainModalIdx.Num() - 1; i >= 0; i--)
 		{
 			if(UpwardGainModalTime[i] >= GAIN_INTERP)
 			{
 				const int32 ModalIdx = UpwardGainModalIdx[i];
 
 				const float FreqScale = (ModalData[ModalIdx * FModalSynth::NumParamsPerModal + 2] * HarmonicFreqScale);
-				const float FreqRPM = GetRandFreqPerSamplingRate(Params, RPMFreqRate, FreqVar, FreqScale) * UE_TWO_PI;
-				
-				PBuffer[ModalIdx] = FMath::Cos(FreqRPM);
-				QBuffer[ModalIdx] = FMath::Sin(FreqRPM);
+				AngleBuffer[ModalIdx] = GetRandFreqPerSamplingRate(Params, RPMFreqRate, FreqVar, FreqScale) * UE_TWO_PI;
 				DecayBuffer[ModalIdx] = 1.0f;
+				bIsTargetChanged = true;
 					
 				UpwardGainModalTime.RemoveAt(i, 1, EAllowShrinking::No);
 				UpwardGainModalIdx.RemoveAt(i, 1, EAllowShrinking::No);
@@ -201,6 +218,59 @@ namespace LBSImpactSFXSynth
 		}
 	}
 
+	void FVehicleEngineSynth::UpdateTargetCoefs()
+	{
+		bIsTargetChanged = false;
+		bIsFreqChanged = false;
+		ControlCounter = 0;
+		
+		ExtendArrayMath::ArrayEulerRotationCoefs(AngleBuffer, DecayBuffer, NumTrueModal, TargetPBuffer, TargetQBuffer);
+
+		const int32 NumModals = PBuffer.Num();
+		if(!bHasCoefs)
+		{
+			//Nothing to ramp from at the first update
+			bHasCoefs = true;
+			RampRemaining = 0;
+			FMemory::Memcpy(PBuffer.GetData(), TargetPBuffer.GetData(), NumModals * sizeof(float));
+			FMemory::Memcpy(QBuffer.GetData(), TargetQBuffer.GetData(), NumModals * sizeof(float));
+			return;
+		}
+
+		RampRemaining = ControlPeriod;
+		const float RampScale = 1.f / ControlPeriod;
+		Audio::ArraySubtract(TargetPBuffer, PBuffer, PDeltaBuffer);
+		Audio::ArraySubtract(TargetQBuffer, QBuffer, QDeltaBuffer);
+		Audio::ArrayMultiplyByConstantInPlace(PDeltaBuffer, RampScale);
+		Audio::ArrayMultiplyByConstantInPlace(QDeltaBuffer, RampScale);
+	}
+
+	void FVehicleEngineSynth::RenderHarmonics(TArrayView<float> OutBuffer, const bool bIsRamping)
+	{
+		const int32 NumFrames = OutBuffer.Num();
+		if(bIsRamping)
+		{
+			ExtendArrayMath::ArrayImpactModalEulerRamp(RealBuffer, ImgBuffer, PBuffer, QBuffer, PDeltaBuffer, QDeltaBuffer,
+														DecayBuffer, CurrentNumModalUsed, OutBuffer);
+		}
+		else if(CurrentNumModalUsed == 1)
+		{
+			for(int i = 0; i < NumFrames; i++)
+			{
+				const float Real = RealBuffer[0] * PBuffer[0] - ImgBuffer[0] * QBuffer[0];
+				const float Img = ImgBuffer[0] * PBuffer[0] + RealBuffer[0] * QBuffer[0];
+				RealBuffer[0] = Real;
+				ImgBuffer[0] = Img;
+				OutBuffer[i] = Real;
+			}
+		}
+		else
+		{
+			ExtendArrayMath::ArrayImpactModalEuler(RealBuffer, ImgBuffer, PBuffer, QBuffer,
+													  CurrentNumModalUsed, OutBuffer);
+		}
+	}
+
 	float FVehicleEngineSynth::GetRandFreqPerSamplingRate(const FVehicleEngineParams& Params, const float RPMFreqRate,
 	                                                       const float FreqVar, const float Freq) const
 	{
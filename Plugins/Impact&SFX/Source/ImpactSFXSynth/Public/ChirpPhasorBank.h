@@ -0,0 +1,77 @@
+﻿// Copyright 2023-2024, Le Binh Son, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DSP/BufferVectorOperations.h"
+
+namespace LBSImpactSFXSynth
+{
+	using namespace Audio;
+
+	enum class EChirpPhaseMode : uint8
+	{
+		Linear = 0,
+		Sigmoid,
+		Exponent
+	};
+	
+	/// Synthesize all chirp modals of a chirp synth together by using complex phasor recurrences.
+	/// Phases are re-anchored with their closed form values every NumRenormSamples samples
+	/// so numerical drift can't accumulate, and in between, each phase is approximated as quadratic in time.
+	class IMPACTSFXSYNTH_API FChirpPhasorBank
+	{
+	public:
+		static constexpr int32 NumRenormSamples = 64;
+		
+		FChirpPhasorBank();
+		
+		void Init(const int32 MaxNumModals, const float InSamplingRate);
+
+		void Reset() { NumModals = 0; }
+
+		int32 GetNumModals() const { return NumModals; }
+		
+		/// Add a modal to be synthesized in the next call of Synthesize
+		/// @param Mode Chirp type. See GetPhaseDerivatives for the phase formula of each type.
+		/// @param Amp Amplitude at the first output sample
+		/// @param Decay Decay rate (<= 0) relative to the first output sample
+		/// @param F0 Start frequency
+		/// @param ChirpRate Chirp rate. Set to 0 for a modal with constant frequency.
+		/// @param FreqRange Frequency range. Not used in linear mode.
+		void AddModal(EChirpPhaseMode Mode, float Amp, float Decay, float F0, float ChirpRate, float FreqRange);
+
+		/// Output is added with the synthesized signal of all added modals
+		/// @param TimeValues The time of each output sample
+		/// @param OutAudio Out buffer
+		void Synthesize(TArrayView<const float> TimeValues, TArrayView<float> OutAudio);
+		
+	protected:
+		void AnchorPhases(const float Time, const float ElapsedTime);
+		
+		FORCEINLINE void GetPhaseDerivatives(const int32 Index, const float Time, float& OutPhase, float& OutSpeed, float& OutAccel) const;
+		
+	private:
+		float TimeResolution;
+		int32 NumModals;
+		int32 NumSimdModals;
+		
+		TArray<EChirpPhaseMode> ModeBuffer;
+		FAlignedFloatBuffer AmpBuffer;
+		FAlignedFloatBuffer DecayBuffer;
+		FAlignedFloatBuffer F0Buffer;
+		FAlignedFloatBuffer ChirpRateBuffer;
+		FAlignedFloatBuffer FreqRangeBuffer;
+		
+		FAlignedFloatBuffer PhaseBuffer;
+		FAlignedFloatBuffer SpeedBuffer;
+		FAlignedFloatBuffer AccelBuffer;
+
+		FAlignedFloatBuffer ZRealBuffer;
+		FAlignedFloatBuffer ZImgBuffer;
+		FAlignedFloatBuffer WRealBuffer;
+		FAlignedFloatBuffer WImgBuffer;
+		FAlignedFloatBuffer RRealBuffer;
+		FAlignedFloatBuffer RImgBuffer;
+	};
+}
@@ -5,6 +5,7 @@
 #include "DSP/Dsp.h"
 #include "DSP/BufferVectorOperations.h"
 #include "DSP/MultichannelBuffer.h"
+#include "ChirpPhasorBank.h"
 
 namespace LBSImpactSFXSynth
 {
@@ -97,6 +98,8 @@ namespace LBSImpactSFXSynth
 
 		Audio::FAlignedFloatBuffer LastRandAmpBuffer;
 		Audio::FAlignedFloatBuffer CurrentRandAmpBuffer;
+
+		FChirpPhasorBank PhasorBank;
 	};
 
 	class IMPACTSFXSYNTH_API FSigmoidChirpSynth : public FChirpSynth
@@ -112,8 +115,8 @@ namespace LBSImpactSFXSynth
 		virtual bool StartSynthesize(const TArrayView<float>& OutAudio, const FChirpSynthParams& Params) override;
 		
 		virtual float CalculateEffectiveFrequency(float F0, float FreqRange, float ExpFactor);
-		virtual void ArrayChirpSynthesize(const TArrayView<float>& OutAudio, float ChirpRate, float Amp, float Decay, float F0,
-										 float FreqRange, const float Bias);
+		/** Add a chirp modal to the phasor bank. All modals are synthesized together at the end of StartSynthesize. */
+		virtual void AddChirpModal(float ChirpRate, float Amp, float Decay, float F0, float FreqRange);
 		
 		virtual void UpdateModalBuffers(TArrayView<const float> ModalsParams, const FChirpSynthParams& Params) override;
 		virtual void UpdateRandBufferIfNeeded(TArrayView<const float> ModalsParams, const FChirpSynthParams& Params, int32 NumModals) override;
@@ -141,7 +144,7 @@ namespace LBSImpactSFXSynth
 	protected:
 		virtual bool IsNearlyReachTargetFrequency(float F0, float FTarget, float ExpFactor) override;
 		virtual float CalculateEffectiveFrequency(float F0, float FreqRange, float ExpFactor) override;
-		virtual void ArrayChirpSynthesize(const TArrayView<float>& OutAudio, float ChirpRate, float Amp, float Decay, float F0, float FreqRange, const float Bias) override;
+		virtual void AddChirpModal(float ChirpRate, float Amp, float Decay, float F0, float FreqRange) override;
 		virtual float CalculateChirpRate(const float ChirpRate, const float RampDuration) override;
 	};
 }
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "DSP/AlignedBuffer.h"
 
 namespace LBSImpactSFXSynth
@@ -9,8 +11,11 @@ namespace LBSImpactSFXSynth
 	/** Copy from Epic Implementation then revise to allow random access to current data instead of ReadIndex
 	 * ------------
 	 * Basic implementation of a circular buffer built for pushing and popping arbitrary amounts of data at once.
-	 * Designed to be thread safe for SPSC; However, if Push() and Pop() are both trying to access an overlapping area of the buffer,
-	 * One of the calls will be truncated. Thus, it is advised that you use a high enough capacity that the producer and consumer are never in contention.
+	 * Storage is rounded up to a power of two, so indices wrap with a mask.
+	 * Read and write counters are monotonic 32-bit values and only their difference is meaningful, which also makes wrap around of the counters safe.
+	 * Lock free for SPSC: the producer only writes WriteCounter and the consumer only writes ReadCounter.
+	 * A counter is published with release ordering after its data is copied and loaded with acquire ordering before the data is accessed,
+	 * so samples seen by the consumer are always complete.
 	 */
 	template <typename SampleType, size_t Alignment = 16>
 	class TCircularAudioBufferCustom
@@ -19,8 +24,9 @@ namespace LBSImpactSFXSynth
 
 		TArray<SampleType, TAlignedHeapAllocator<Alignment>> InternalBuffer;
 		uint32 Capacity;
-		FThreadSafeCounter ReadCounter;
-		FThreadSafeCounter WriteCounter;
+		uint32 IndexMask;
+		std::atomic<uint32> ReadCounter;
+		std::atomic<uint32> WriteCounter;
 
 	public:
 		TCircularAudioBufferCustom()
@@ -37,8 +43,9 @@ namespace LBSImpactSFXSynth
 		{
 			InternalBuffer = InOther.InternalBuffer;
 			Capacity = InOther.Capacity;
-			ReadCounter.Set(InOther.ReadCounter.GetValue());
-			WriteCounter.Set(InOther.WriteCounter.GetValue());
+			IndexMask = InOther.IndexMask;
+			ReadCounter.store(InOther.ReadCounter.load(std::memory_order_acquire), std::memory_order_relaxed);
+			WriteCounter.store(InOther.WriteCounter.load(std::memory_order_acquire), std::memory_order_release);
 
 			return *this;
 		}
@@ -56,10 +63,11 @@ namespace LBSImpactSFXSynth
 
 		void SetCapacity(uint32 InCapacity)
 		{
-			checkf(InCapacity < (uint32)TNumericLimits<int32>::Max(), TEXT("Max capacity for this buffer is 2,147,483,647 samples. Otherwise our index arithmetic will not work."));
-			Capacity = InCapacity + 1;
-			ReadCounter.Set(0);
-			WriteCounter.Set(0);
+			checkf(InCapacity <= (1u << 30), TEXT("Max capacity for this buffer is 1,073,741,824 samples. Otherwise our index arithmetic will not work."));
+			Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 1u));
+			IndexMask = Capacity - 1;
+			ReadCounter.store(0, std::memory_order_relaxed);
+			WriteCounter.store(0, std::memory_order_release);
 			InternalBuffer.Reset();
 			InternalBuffer.AddZeroed(Capacity);
 		}
@@ -71,21 +79,35 @@ namespace LBSImpactSFXSynth
 		 */
 		void Reserve(uint32 InMinimumCapacity, bool bRetainExistingSamples)
 		{
-			if (Capacity <= InMinimumCapacity)
+			if (Capacity < InMinimumCapacity)
 			{
-				uint32 NewCapacity = InMinimumCapacity + 1;
-
-				checkf(NewCapacity < (uint32)TNumericLimits<int32>::Max(), TEXT("Max capacity overflow. Requested %d. Maximum allowed %d"), NewCapacity, TNumericLimits<int32>::Max());
+				checkf(InMinimumCapacity <= (1u << 30), TEXT("Max capacity overflow. Requested %u. Maximum allowed %u"), InMinimumCapacity, (1u << 30));
 
-				uint32 NumToAdd = NewCapacity - Capacity;
-				InternalBuffer.AddZeroed(NumToAdd);
+				const uint32 NewCapacity = FMath::RoundUpToPowerOfTwo(InMinimumCapacity);
+				if (bRetainExistingSamples)
+				{
+					//Samples are re-laid out from index zero as the mask changes with the capacity
+					TArray<SampleType, TAlignedHeapAllocator<Alignment>> NewBuffer;
+					NewBuffer.AddZeroed(NewCapacity);
+					const uint32 NumSamples = Num();
+					Peek(NewBuffer.GetData(), NumSamples);
+					InternalBuffer = MoveTemp(NewBuffer);
+					ReadCounter.store(0, std::memory_order_relaxed);
+					WriteCounter.store(NumSamples, std::memory_order_release);
+				}
+				else
+				{
+					InternalBuffer.AddZeroed(NewCapacity - Capacity);
+				}
+				
 				Capacity = NewCapacity;
+				IndexMask = Capacity - 1;
 			}
 
 			if (!bRetainExistingSamples)
 			{
-				ReadCounter.Set(0);
-				WriteCounter.Set(0);
+				ReadCounter.store(0, std::memory_order_relaxed);
+				WriteCounter.store(0, std::memory_order_release);
 			}
 		}
 
@@ -101,16 +123,17 @@ namespace LBSImpactSFXSynth
 		int32 Push(const SampleType* InBuffer, uint32 NumSamples)
 		{
 			SampleType* DestBuffer = InternalBuffer.GetData();
-			const uint32 ReadIndex = ReadCounter.GetValue();
-			const uint32 WriteIndex = WriteCounter.GetValue();
+			const uint32 ReadIndex = ReadCounter.load(std::memory_order_acquire);
+			const uint32 WriteIndex = WriteCounter.load(std::memory_order_relaxed);
 
-			int32 NumToCopy = FMath::Min<int32>(NumSamples, Remainder());
-			const int32 NumToWrite = FMath::Min<int32>(NumToCopy, Capacity - WriteIndex);
+			const uint32 NumToCopy = FMath::Min<uint32>(NumSamples, Capacity - (WriteIndex - ReadIndex));
+			const uint32 StartIndex = WriteIndex & IndexMask;
+			const uint32 NumToWrite = FMath::Min<uint32>(NumToCopy, Capacity - StartIndex);
 
-			FMemory::Memcpy(&DestBuffer[WriteIndex], InBuffer, NumToWrite * sizeof(SampleType));
+			FMemory::Memcpy(&DestBuffer[StartIndex], InBuffer, NumToWrite * sizeof(SampleType));
 			FMemory::Memcpy(&DestBuffer[0], &InBuffer[NumToWrite], (NumToCopy - NumToWrite) * sizeof(SampleType));
 
-			WriteCounter.Set((WriteIndex + NumToCopy) % Capacity);
+			WriteCounter.store(WriteIndex + NumToCopy, std::memory_order_release);
 
 			return NumToCopy;
 		}
@@ -120,16 +143,17 @@ namespace LBSImpactSFXSynth
 		int32 PushZeros(uint32 NumSamplesOfZeros)
 		{
 			SampleType* DestBuffer = InternalBuffer.GetData();
-			const uint32 ReadIndex = ReadCounter.GetValue();
-			const uint32 WriteIndex = WriteCounter.GetValue();
+			const uint32 ReadIndex = ReadCounter.load(std::memory_order_acquire);
+			const uint32 WriteIndex = WriteCounter.load(std::memory_order_relaxed);
 
-			int32 NumToZeroEnd = FMath::Min<int32>(NumSamplesOfZeros, Remainder());
-			const int32 NumToZeroBegin = FMath::Min<int32>(NumToZeroEnd, Capacity - WriteIndex);
+			const uint32 NumToZeroEnd = FMath::Min<uint32>(NumSamplesOfZeros, Capacity - (WriteIndex - ReadIndex));
+			const uint32 StartIndex = WriteIndex & IndexMask;
+			const uint32 NumToZeroBegin = FMath::Min<uint32>(NumToZeroEnd, Capacity - StartIndex);
 
-			FMemory::Memzero(&DestBuffer[WriteIndex], NumToZeroBegin * sizeof(SampleType));
+			FMemory::Memzero(&DestBuffer[StartIndex], NumToZeroBegin * sizeof(SampleType));
 			FMemory::Memzero(&DestBuffer[0], (NumToZeroEnd - NumToZeroBegin) * sizeof(SampleType));
 
-			WriteCounter.Set((WriteIndex + NumToZeroEnd) % Capacity);
+			WriteCounter.store(WriteIndex + NumToZeroEnd, std::memory_order_release);
 
 			return NumToZeroEnd;
 		}
@@ -138,38 +162,34 @@ namespace LBSImpactSFXSynth
 		// Returns false if the buffer is full.
 		bool Push(const SampleType& InElement)
 		{
-			if (Remainder() == 0)
+			const uint32 ReadIndex = ReadCounter.load(std::memory_order_acquire);
+			const uint32 WriteIndex = WriteCounter.load(std::memory_order_relaxed);
+			if (WriteIndex - ReadIndex >= Capacity)
 			{
 				return false;
 			}
 			else
 			{
-				SampleType* DestBuffer = InternalBuffer.GetData();
-				const uint32 ReadIndex = ReadCounter.GetValue();
-				const uint32 WriteIndex = WriteCounter.GetValue();
+				InternalBuffer.GetData()[WriteIndex & IndexMask] = InElement;
 
-				DestBuffer[WriteIndex] = InElement;
-
-				WriteCounter.Set((WriteIndex + 1) % Capacity);
+				WriteCounter.store(WriteIndex + 1, std::memory_order_release);
 				return true;
 			}
 		}
 
 		bool Push(SampleType&& InElement)
 		{
-			if (Remainder() == 0)
+			const uint32 ReadIndex = ReadCounter.load(std::memory_order_acquire);
+			const uint32 WriteIndex = WriteCounter.load(std::memory_order_relaxed);
+			if (WriteIndex - ReadIndex >= Capacity)
 			{
 				return false;
 			}
 			else
 			{
-				SampleType* DestBuffer = InternalBuffer.GetData();
-				const uint32 ReadIndex = ReadCounter.GetValue();
-				const uint32 WriteIndex = WriteCounter.GetValue();
-
-				DestBuffer[WriteIndex] = MoveTemp(InElement);
+				InternalBuffer.GetData()[WriteIndex & IndexMask] = MoveTemp(InElement);
 
-				WriteCounter.Set((WriteIndex + 1) % Capacity);
+				WriteCounter.store(WriteIndex + 1, std::memory_order_release);
 				return true;
 			}
 		}
@@ -177,40 +197,47 @@ namespace LBSImpactSFXSynth
 		// Same as Pop(), but does not increment the read counter.
 		int32 Peek(SampleType* OutBuffer, uint32 NumSamples) const
 		{
-			const SampleType* SrcBuffer = InternalBuffer.GetData();
-			const uint32 ReadIndex = ReadCounter.GetValue();
-			const uint32 WriteIndex = WriteCounter.GetValue();
+			return Peek(OutBuffer, 0, NumSamples);
+		}
 
-			const int32 NumToCopy = FMath::Min<int32>(NumSamples, Num());
-			const int32 NumRead = FMath::Min<int32>(NumToCopy, Capacity - ReadIndex);
-			FMemory::Memcpy(OutBuffer, &SrcBuffer[ReadIndex], NumRead * sizeof(SampleType));
-				
-			FMemory::Memcpy(&OutBuffer[NumRead], &SrcBuffer[0], (NumToCopy - NumRead) * sizeof(SampleType));
+		// Same as Pop(), but does not increment the read counter.
+		int32 Peek(SampleType* OutBuffer, uint32 StartOffset, uint32 NumSamples) const
+		{
+			TArrayView<const SampleType> FirstView;
+			TArrayView<const SampleType> SecondView;
+			const int32 NumToCopy = PeekContiguous(StartOffset, NumSamples, FirstView, SecondView);
+			
+			FMemory::Memcpy(OutBuffer, FirstView.GetData(), FirstView.Num() * sizeof(SampleType));
+			FMemory::Memcpy(&OutBuffer[FirstView.Num()], SecondView.GetData(), SecondView.Num() * sizeof(SampleType));
 
-			check(NumSamples < ((uint32)TNumericLimits<int32>::Max()));
+			check(NumSamples < ((uint32)(TNumericLimits<int32>::Max())));
 			return NumToCopy;
 		}
 
-		// Same as Pop(), but does not increment the read counter.
-		int32 Peek(SampleType* OutBuffer, uint32 StartOffset,  uint32 NumSamples)
+		/** Get up to NumSamples readable samples starting StartOffset samples after the read position without copying them.
+		 * OutSecond is only non-empty when the requested range wraps around the end of the storage.
+		 * The views stay valid until the samples are popped with CommitRead() or Pop().
+		 * @return The total number of samples in both views. */
+		int32 PeekContiguous(uint32 StartOffset, uint32 NumSamples, TArrayView<const SampleType>& OutFirst, TArrayView<const SampleType>& OutSecond) const
 		{
 			const SampleType* SrcBuffer = InternalBuffer.GetData();
-			const uint32 ReadIndex = ReadCounter.GetValue();
-			const uint32 WriteIndex = WriteCounter.GetValue();
+			const uint32 WriteIndex = WriteCounter.load(std::memory_order_acquire);
+			const uint32 ReadIndex = ReadCounter.load(std::memory_order_relaxed);
+			const uint32 NumAvailable = WriteIndex - ReadIndex;
 			
-			uint32 StartIndex = ReadIndex + StartOffset;
-			if(StartIndex >= Capacity)
-				StartIndex -= Capacity;
-			
-			const int32 NumToCopy = FMath::Min<int32>(NumSamples, Num() - StartOffset);
-			
-			const int32 NumRead = FMath::Min<int32>(NumToCopy, Capacity - StartIndex);
-			FMemory::Memcpy(OutBuffer, &SrcBuffer[StartIndex], NumRead * sizeof(SampleType));
-			
-			FMemory::Memcpy(&OutBuffer[NumRead], &SrcBuffer[0], (NumToCopy - NumRead) * sizeof(SampleType));
+			const uint32 NumToRead = StartOffset < NumAvailable ? FMath::Min<uint32>(NumSamples, NumAvailable - StartOffset) : 0u;
+			const uint32 StartIndex = (ReadIndex + StartOffset) & IndexMask;
+			const uint32 NumFirst = FMath::Min<uint32>(NumToRead, Capacity - StartIndex);
 
-			check(NumSamples < ((uint32)(TNumericLimits<int32>::Max())));
-			return NumToCopy;
+			OutFirst = TArrayView<const SampleType>(&SrcBuffer[StartIndex], NumFirst);
+			OutSecond = TArrayView<const SampleType>(SrcBuffer, NumToRead - NumFirst);
+			return NumToRead;
+		}
+
+		/** Release samples which have been read through PeekContiguous(). Same as Pop(NumSamples). */
+		int32 CommitRead(uint32 NumSamples)
+		{
+			return Pop(NumSamples);
 		}
 		
 		// Peeks a single element.
@@ -223,10 +250,8 @@ namespace LBSImpactSFXSynth
 			}
 			else
 			{
-				SampleType* SrcBuffer = InternalBuffer.GetData();
-				const uint32 ReadIndex = ReadCounter.GetValue();
-				
-				OutElement = SrcBuffer[ReadIndex];
+				const uint32 ReadIndex = ReadCounter.load(std::memory_order_relaxed);
+				OutElement = InternalBuffer.GetData()[ReadIndex & IndexMask];
 
 				return true;
 			}
@@ -239,7 +264,7 @@ namespace LBSImpactSFXSynth
 			int32 NumSamplesRead = Peek(OutBuffer, NumSamples);
 			check(NumSamples < ((uint32)TNumericLimits<int32>::Max()));
 
-			ReadCounter.Set((ReadCounter.GetValue() + NumSamplesRead) % Capacity);
+			ReadCounter.store(ReadCounter.load(std::memory_order_relaxed) + NumSamplesRead, std::memory_order_release);
 
 			return NumSamplesRead;
 		}
@@ -250,9 +275,9 @@ namespace LBSImpactSFXSynth
 		{
 			check(NumSamples < ((uint32)TNumericLimits<int32>::Max()));
 
-			int32 NumSamplesRead = FMath::Min<int32>(NumSamples, Num());
+			int32 NumSamplesRead = FMath::Min<uint32>(NumSamples, Num());
 
-			ReadCounter.Set((ReadCounter.GetValue() + NumSamplesRead) % Capacity);
+			ReadCounter.store(ReadCounter.load(std::memory_order_relaxed) + NumSamplesRead, std::memory_order_release);
 
 			return NumSamplesRead;
 		}
@@ -264,11 +289,10 @@ namespace LBSImpactSFXSynth
 			// Calling this when the buffer is empty is considered a fatal error.
 			check(Num() > 0);
 
-			SampleType* SrcBuffer = InternalBuffer.GetData();
-			const uint32 ReadIndex = ReadCounter.GetValue();
+			const uint32 ReadIndex = ReadCounter.load(std::memory_order_relaxed);
 
-			SampleType PoppedValue = MoveTempIfPossible(InternalBuffer[ReadIndex]);
-			ReadCounter.Set((ReadCounter.GetValue() + 1) % Capacity);
+			SampleType PoppedValue = MoveTempIfPossible(InternalBuffer[ReadIndex & IndexMask]);
+			ReadCounter.store(ReadIndex + 1, std::memory_order_release);
 			return PoppedValue;
 		}
 
@@ -277,38 +301,26 @@ namespace LBSImpactSFXSynth
 		// in the buffer. Cannot be used to increase the capacity of this buffer.
 		void SetNum(uint32 NumSamples, bool bRetainOldestSamples = false)
 		{
-			check(NumSamples < Capacity);
+			check(NumSamples <= Capacity);
 
 			if (bRetainOldestSamples)
 			{
-				WriteCounter.Set((ReadCounter.GetValue() + NumSamples) % Capacity);
+				WriteCounter.store(ReadCounter.load(std::memory_order_acquire) + NumSamples, std::memory_order_release);
 			}
 			else
 			{
-				int64 ReadCounterNum = ((int32)WriteCounter.GetValue()) - ((int32) NumSamples);
-				if (ReadCounterNum < 0)
-				{
-					ReadCounterNum = Capacity + ReadCounterNum;
-				}
-
-				ReadCounter.Set(ReadCounterNum);
+				ReadCounter.store(WriteCounter.load(std::memory_order_acquire) - NumSamples, std::memory_order_release);
 			}
 		}
 
 		// Get number of samples that can be popped off of the buffer.
 		uint32 Num() const
 		{
-			const int32 ReadIndex = ReadCounter.GetValue();
-			const int32 WriteIndex = WriteCounter.GetValue();
+			//Read first so a concurrent pop can never move it past the loaded write counter
+			const uint32 ReadIndex = ReadCounter.load(std::memory_order_acquire);
+			const uint32 WriteIndex = WriteCounter.load(std::memory_order_acquire);
 
-			if (WriteIndex >= ReadIndex)
-			{
-				return WriteIndex - ReadIndex;
-			}
-			else
-			{
-				return Capacity - ReadIndex + WriteIndex;
-			}
+			return WriteIndex - ReadIndex;
 		}
 
 		// Get the current capacity of the buffer
@@ -320,10 +332,7 @@ namespace LBSImpactSFXSynth
 		// Get number of samples that can be pushed onto the buffer before it is full.
 		uint32 Remainder() const
 		{
-			const uint32 ReadIndex = ReadCounter.GetValue();
-			const uint32 WriteIndex = WriteCounter.GetValue();
-
-			return (Capacity - 1 - WriteIndex + ReadIndex) % Capacity;
+			return Capacity - FMath::Min(Capacity, Num());
 		}
 	};
 
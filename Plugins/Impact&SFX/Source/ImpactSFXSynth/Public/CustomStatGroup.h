@@ -4,5 +4,96 @@
 
 #include "CoreMinimal.h"
 #include "Stats/Stats.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 DECLARE_STATS_GROUP(TEXT("ImpactSFXSynth"), STATGROUP_ImpactSFXSynth, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Voices"), STAT_ImpactSFXActiveVoices, STATGROUP_ImpactSFXSynth, IMPACTSFXSYNTH_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Modals"), STAT_ImpactSFXActiveModals, STATGROUP_ImpactSFXSynth, IMPACTSFXSYNTH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Residual Frames Synthesized"), STAT_ImpactSFXResidualFrames, STATGROUP_ImpactSFXSynth, IMPACTSFXSYNTH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Voices Stolen"), STAT_ImpactSFXVoicesStolen, STATGROUP_ImpactSFXSynth, IMPACTSFXSYNTH_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Voice Creations"), STAT_ImpactSFXVoiceCreations, STATGROUP_ImpactSFXSynth, IMPACTSFXSYNTH_API);
+
+/** Insights channel for per node instance scopes and counters. Enable with -trace=ImpactSFXSynth,Counters */
+UE_TRACE_CHANNEL_EXTERN(ImpactSFXSynthChannel, IMPACTSFXSYNTH_API);
+
+#if CPUPROFILERTRACE_ENABLED
+#define IMPACTSFX_TRACE_NODE_SCOPE(NodeTrace) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*(NodeTrace).GetName(), ImpactSFXSynthChannel)
+#else
+#define IMPACTSFX_TRACE_NODE_SCOPE(NodeTrace)
+#endif
+
+namespace LBSImpactSFXSynth
+{
+	/** Runtime counters of a synthesizer over one audio block.
+	 * Voices and modals are levels at the end of the block. The other counters are events summed over the block. */
+	struct FSynthBlockCounters
+	{
+		int32 NumActiveVoices = 0;
+		int32 NumActiveModals = 0;
+		int32 NumResidualFrames = 0;
+		int32 NumVoicesStolen = 0;
+		int32 NumVoiceCreations = 0;
+
+		/** Levels are replaced by the latest sub block while events are accumulated. */
+		void Merge(const FSynthBlockCounters& Other)
+		{
+			NumActiveVoices = Other.NumActiveVoices;
+			NumActiveModals = Other.NumActiveModals;
+			NumResidualFrames += Other.NumResidualFrames;
+			NumVoicesStolen += Other.NumVoicesStolen;
+			NumVoiceCreations += Other.NumVoiceCreations;
+		}
+
+		void ResetEvents()
+		{
+			NumResidualFrames = 0;
+			NumVoicesStolen = 0;
+			NumVoiceCreations = 0;
+		}
+	};
+
+	/** Publishes the block counters of one MetaSound operator instance.
+	 * Stats show the sum over all instances. Insights shows one counter track per instance when ImpactSFXSynthChannel is enabled. */
+	class IMPACTSFXSYNTH_API FSynthNodeTrace
+	{
+	public:
+		explicit FSynthNodeTrace(const FName& InNodeName);
+		~FSynthNodeTrace();
+
+		FSynthNodeTrace(const FSynthNodeTrace&) = delete;
+		FSynthNodeTrace& operator=(const FSynthNodeTrace&) = delete;
+
+		/** Call once at the end of each audio block. Event counters of InCounters are reset afterwards. */
+		void Publish(FSynthBlockCounters& InCounters);
+
+		const FString& GetName() const { return Name; }
+
+	private:
+		void UpdateLevels(const int32 NumActiveVoices, const int32 NumActiveModals);
+		
+		FString Name;
+		int32 LastNumActiveVoices;
+		int32 LastNumActiveModals;
+
+		static FThreadSafeCounter TotalActiveVoices;
+		static FThreadSafeCounter TotalActiveModals;
+		static FThreadSafeCounter NumInstances;
+		
+#if COUNTERSTRACE_ENABLED
+		using FTraceCounter = FCountersTrace::TCounter<int64, TraceCounterType_Int>;
+
+		void CreateTraceCounters();
+		
+		TArray<FString> CounterNames;
+		TUniquePtr<FTraceCounter> ActiveVoicesCounter;
+		TUniquePtr<FTraceCounter> ActiveModalsCounter;
+		TUniquePtr<FTraceCounter> ResidualFramesCounter;
+		TUniquePtr<FTraceCounter> VoicesStolenCounter;
+		TUniquePtr<FTraceCounter> VoiceCreationsCounter;
+#endif
+	};
+}
@@ -88,6 +88,7 @@ public:
 	float GetXEnd() const { return MaxX; }
 	float GetXStep() const { return Step; }
 	int32 GetNumValues() const { return Data.Num(); }
+	TArrayView<const float> GetDataView() const { return TArrayView<const float>(Data); }
 
 	bool IsXAxisRangeMatch(float Start, float End) const;
 	
@@ -96,7 +97,8 @@ public:
 	/// @param XStep Key Step
 	/// @param OutArray Out Array
 	/// @param NumRemoveLastSample Default to 1. This assumes the last key is redundant (the same as the first key) for a perfect cyclic interpolation. 
-	void GetArrayByTimeCyclicInterp(float StartX, float XStep, TArrayView<float>& OutArray, int NumRemoveLastSample = 1);
+	/// Wrapping is a mask instead of a compare when the cyclic length (Num values - NumRemoveLastSample) is a power of two.
+	void GetArrayByTimeCyclicInterp(float StartX, float XStep, TArrayView<float>& OutArray, int NumRemoveLastSample = 1) const;
 	
 	float GetValueByTimeNearest(float InTime) const;
 	float GetValueByTimeInterp(float InTime) const;
@@ -112,6 +114,13 @@ public:
 	float GetValueByArrayIndex(const int32 InIndex) const;
 	
 protected:
+	/** Number of fractional bits of the phase used by GetArrayByTimeCyclicInterp. */
+	static constexpr int32 PhaseFracBits = 32;
+
+	template <bool bIsPowerOfTwo>
+	void CyclicInterpFixedPoint(uint64 Phase, const uint64 PhaseStep, const int32 NumData, TArrayView<float>& OutArray) const;
+	
+
 	TArray<float> Data;
 	float MinX;
 	int32 MinXInt;
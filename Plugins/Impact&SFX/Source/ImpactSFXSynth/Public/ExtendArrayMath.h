@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "DSP/BufferVectorOperations.h"
+#include "Algo/Reverse.h"
 
 #define IMPS_EXP_FACTOR_MAX (15.0f)
 
@@ -28,6 +29,32 @@ namespace ExtendArrayMath
 												  TArrayView<const float> PBuffer, TArrayView<const float> QBuffer,
 												   int32 NumModal, const float AmpScale, TArrayView<float> OutputBuffer);
 
+	/** Modal calculation by using euler transform. Each modal is scaled by its own gain in GainBuffer before summing.
+	 * All buffer sizes must be a multiple of audio register*/
+	IMPACTSFXSYNTH_API void ArrayImpactModalEuler(TArrayView<float> RealBuffer, TArrayView<float> ImgBuffer,
+												  TArrayView<const float> PBuffer, TArrayView<const float> QBuffer,
+												  TArrayView<const float> GainBuffer, int32 NumModal, TArrayView<float> OutputBuffer);
+
+	/** Modal calculation by using euler transform while P and Q are ramped by PDelta and QDelta after each sample.
+	 * Only the rotation angle is ramped: P and Q are renormalized so |P + iQ| always equals DecayBuffer,
+	 * which keeps decay and upward gain identical to an instant coefficient change.
+	 * All buffer sizes must be a multiple of audio register*/
+	IMPACTSFXSYNTH_API void ArrayImpactModalEulerRamp(TArrayView<float> RealBuffer, TArrayView<float> ImgBuffer,
+													  TArrayView<float> PBuffer, TArrayView<float> QBuffer,
+													  TArrayView<const float> PDeltaBuffer, TArrayView<const float> QDeltaBuffer,
+													  TArrayView<const float> DecayBuffer, int32 NumModal, TArrayView<float> OutputBuffer);
+
+	/** Same as ArrayImpactModalEulerRamp but each modal is scaled by its own gain in GainBuffer before summing. */
+	IMPACTSFXSYNTH_API void ArrayImpactModalEulerRamp(TArrayView<float> RealBuffer, TArrayView<float> ImgBuffer,
+													  TArrayView<float> PBuffer, TArrayView<float> QBuffer,
+													  TArrayView<const float> PDeltaBuffer, TArrayView<const float> QDeltaBuffer,
+													  TArrayView<const float> DecayBuffer, TArrayView<const float> GainBuffer,
+													  int32 NumModal, TArrayView<float> OutputBuffer);
+
+	/** Calculate euler rotation coefficients P = cos(Angle) * Decay and Q = sin(Angle) * Decay. Buffer sizes must be a multiple of audio register*/
+	IMPACTSFXSYNTH_API void ArrayEulerRotationCoefs(TArrayView<const float> AngleBuffer, TArrayView<const float> DecayBuffer,
+													int32 NumModal, TArrayView<float> OutPBuffer, TArrayView<float> OutQBuffer);
+
 	/** Calculate the total gain of all modals with euler transform buffers. Real and Img buffer size must be a multiple of audio register*/
 	IMPACTSFXSYNTH_API float ArrayModalTotalGain(TArrayView<const float> RealBuffer, TArrayView<const float> ImgBuffer, int32 NumModal);
 	
@@ -36,25 +63,14 @@ namespace ExtendArrayMath
 	/** Separate Time in Decay and Sin calculation. Use this when Amp is updated with decay after each frame. */
 	IMPACTSFXSYNTH_API void ArrayImpactModalDeltaDecay(TArrayView<const float> TimeValues,const float Amp, const float Decay,
 													const float PhiSpeed, TArrayView<float> OutFloatBuffer);
-												
-	/** Output is added with the synthesized chirp signal */
-	IMPACTSFXSYNTH_API void ArrayLinearChirpSynth(TArrayView<const float> TimeValues, const float ChirpRate,
-												 const float Amp, const float Decay,
- 												 const float F0, TArrayView<float> OutFloatBuffer);
-
-	/** Output data is replaced with the synthesized chirp signal instead of adding which gives a small performance boost*/
-	IMPACTSFXSYNTH_API void ArrayLinearChirpSynthSingle(TArrayView<const float> TimeValues, const float ChirpRate,
-														const float Amp, const float Decay, 
-														const float F0, TArrayView<float> OutFloatBuffer);
-
-	IMPACTSFXSYNTH_API void ArraySigmoidChirpSynth(TArrayView<const float> TimeValues, const float ChirpRate,
-												   const float Amp, const float Decay, const float F0,
-												   const float FRange, const float Bias, TArrayView<float> OutFloatBuffer);
-
-	IMPACTSFXSYNTH_API void ArrayExponentChirpSynth(TArrayView<const float> TimeValues, const float ChirpRate,
-												   const float Amp, const float Decay, const float F0,
-												   const float FRange, const float Bias, TArrayView<float> OutFloatBuffer);
 	
+	/** Output is added with the imaginary part of all complex phasors. After each sample, Z is multiplied by W and W is rotated by R.
+	 * This gives a quadratic phase (linear chirp) without calling sin/exp per sample. All buffer sizes must be a multiple of audio register*/
+	IMPACTSFXSYNTH_API void ArrayChirpPhasorSynth(TArrayView<float> ZRealBuffer, TArrayView<float> ZImgBuffer,
+												  TArrayView<float> WRealBuffer, TArrayView<float> WImgBuffer,
+												  TArrayView<const float> RRealBuffer, TArrayView<const float> RImgBuffer,
+												  int32 NumModal, TArrayView<float> OutFloatBuffer);
+
 	IMPACTSFXSYNTH_API void ArrayImpactModalFastSin(TArrayView<const float> TimeValues, TArrayView<const float> SinValues, const float Amp, const float Decay,
 											TArrayView<float> OutFloatBuffer);
 	
@@ -62,23 +78,51 @@ namespace ExtendArrayMath
 
 	IMPACTSFXSYNTH_API void ArrayDeltaTimeDecayInPlace(TArrayView<const float> TimeValues, const float ExpConst, TArrayView<float> OutputValue);
 	
+	/** Reverse the order of all values in place. Swaps four values from each end per iteration. */
+	IMPACTSFXSYNTH_API void ArrayReverseInPlace(TArrayView<float> InValues);
+
+	template <typename T>
+	void ArrayReverseInPlace(TArrayView<T> InValues)
+	{
+		Algo::Reverse(InValues.GetData(), InValues.Num());
+	}
+	
+	/** Rotate InArray in place so the value at Shift becomes the first value. Shift is wrapped into [0, Num).
+	 * Uses three reversals so no temporary buffer is allocated. */
 	template <typename T>
-	IMPACTSFXSYNTH_API void ArrayCircularRightShift(TArrayView<T> InArray, const int32 Shift)
+	void ArrayCircularRightShift(TArrayView<T> InArray, int32 Shift)
 	{
 		const int32 NumSamples = InArray.Num();
-		check(Shift >= 0 && Shift < NumSamples);
-		
-		TArray<T> TempArray;
-		TempArray.SetNumUninitialized(NumSamples);
-		T* TempBuffer = TempArray.GetData();
-		T* InBuffer = InArray.GetData();
-		FMemory::Memcpy(TempBuffer, InBuffer, NumSamples * sizeof(T));		
-		
-		const int32 NumRight = NumSamples - Shift;
-		FMemory::Memcpy(&InBuffer[0], &TempBuffer[Shift], NumRight * sizeof(T));
+		if(NumSamples < 2)
+			return;
+
+		Shift = Shift % NumSamples;
+		if(Shift < 0)
+			Shift += NumSamples;
+		if(Shift == 0)
+			return;
 
-		const int32 Remain = NumSamples - NumRight;
-		FMemory::Memcpy(&InBuffer[NumRight], &TempBuffer[0], Remain * sizeof(T));
+		ArrayReverseInPlace(InArray.Slice(0, Shift));
+		ArrayReverseInPlace(InArray.Slice(Shift, NumSamples - Shift));
+		ArrayReverseInPlace(InArray);
+	}
+
+	/** Out-of-place version of ArrayCircularRightShift. InArray and OutArray must have the same size and must not overlap. */
+	template <typename T>
+	void ArrayCircularRightShift(TArrayView<const T> InArray, int32 Shift, TArrayView<T> OutArray)
+	{
+		const int32 NumSamples = InArray.Num();
+		check(OutArray.Num() == NumSamples);
+		if(NumSamples == 0)
+			return;
+
+		Shift = Shift % NumSamples;
+		if(Shift < 0)
+			Shift += NumSamples;
+
+		const int32 NumRight = NumSamples - Shift;
+		FMemory::Memcpy(OutArray.GetData(), InArray.GetData() + Shift, NumRight * sizeof(T));
+		FMemory::Memcpy(OutArray.GetData() + NumRight, InArray.GetData(), Shift * sizeof(T));
 	}
 
 };
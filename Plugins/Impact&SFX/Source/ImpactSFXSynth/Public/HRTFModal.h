@@ -11,6 +11,8 @@ namespace LBSImpactSFXSynth
 	
 	class IMPACTSFXSYNTH_API FHRTFModal
 	{
+		friend class FHRTFModalBank;
+		
 		static constexpr float SoundSpeed = 344.0f;
 		static constexpr float MaxITDUnit = 0.0075f;
 
@@ -40,7 +42,17 @@ namespace LBSImpactSFXSynth
 		void InterpolateAmp(bool bIsLeftChannel, float Azi, float Elev, const TArrayView<float>& OutBuffer, float Gain);
 
 		float GetInterauralTimeDelay(float Azi, float AbsCosElev);
-		float GetDecay(bool bIsLefChannel, float Azi, float AbsCosElev);
+		static float GetITDUnit(float Azi, float AbsCosElev);
+		static float GetDecay(bool bIsLefChannel, float Azi, float AbsCosElev);
+
+		/// Bilinear lookup of the dense direction table.
+		/// @param Azi Azimuth in the range [0, 2*pi].
+		/// @param Elev Elevation in the range [-pi/2, pi/2].
+		void LookupDirection(float Azi, float Elev, float& OutDecayLeft, float& OutDecayRight,
+							 float& OutITDLeft, float& OutITDRight) const;
+		
+		/// Dense table of decays and ITD units of both ears, built once and shared by all instances.
+		static const FAlignedFloatBuffer& GetDirectionTable();
 		
 		bool IsFinish(bool bIsAudioEnd);
 		float MapElevationToCorrectRange(float Elevation);
@@ -50,6 +62,8 @@ namespace LBSImpactSFXSynth
 		void ConvolveOneChannel(TArrayView<float>& OutAudio, const TArrayView<const float>& InAudio, const float* TwoRCosData,
              					const float* GainFData, const float* GainPhiData, float* OutD1BufferPtr, float* OutD2BufferPtr,
              					const float R2, const float Threshold = 1e-5f);
+		/** View of the input delayed by NumDelay samples. Only copied into TempBuffer if it wraps around the ring buffer. */
+		TArrayView<const float> GetDelayedInput(const int32 NumDelay);
 		
 		float FindDeltaAngleRadians(float A1, float A2);
 		
@@ -65,6 +79,11 @@ namespace LBSImpactSFXSynth
 		static constexpr float AmpAziStep = UE_PI / 2;
 		
 		static constexpr int32 NumModals = 32;
+
+		static constexpr float DirTableStep = UE_PI / 90.f; //2 degrees
+		static constexpr int32 NumDirTableAzi = 181; //[0, 2pi] with the last column equal to the first one
+		static constexpr int32 NumDirTableElev = 91; //[-pi/2, pi/2]
+		static constexpr int32 NumDirTableParams = 4; //Decay left, decay right, ITD unit left, ITD unit right
 		
 		float SamplingRate;
 		int32 NumFramesPerBlock;
@@ -81,6 +100,10 @@ namespace LBSImpactSFXSynth
 
 		FAlignedFloatBuffer AmpTempInterHorBuffer;
 
+		//Direction independent terms of each modal
+		FAlignedFloatBuffer CosThetas;
+		FAlignedFloatBuffer SinThetaPhis;
+
 		float R2Left;
 		FAlignedFloatBuffer TwoRCosLeft;
 		FAlignedFloatBuffer GainFLeft;
@@ -102,4 +125,71 @@ namespace LBSImpactSFXSynth
 		int32 MaxDelaySamples;
 		bool bIsFirstFrame;
 	};
+
+	/// Spatialize many sources with HRTF modals in one pass.
+	/// Each source keeps its own input delay line and interaural delays, while resonator coefficients and states
+	/// of all sources are packed into shared SoA buffers so they are processed in one SIMD loop
+	/// and the output of all sources is mixed into one stereo output.
+	/// A source which is not submitted in a block is fed silence with its last direction until it is removed,
+	/// so its delay line keeps advancing and its resonators ring out naturally.
+	class IMPACTSFXSYNTH_API FHRTFModalBank
+	{
+	public:
+		FHRTFModalBank(float InSamplingRate, int32 InNumFramesPerBlock, int32 InMaxNumSources);
+
+		/// Add a new source to the bank.
+		/// @return The source ID or INDEX_NONE if the bank is full.
+		int32 AddSource();
+
+		/// Remove a source from the bank. Its resonator states are cleared so the ID can be reused.
+		void RemoveSource(int32 SourceId);
+
+		/// Submit the input of a source for the next ProcessBlock call.
+		/// @return True if this source is finished and can be removed.
+		bool SetSourceInput(int32 SourceId, const TArrayView<const float>& InAudio, float Azimuth, float Elevation,
+							float Gain, bool bIsAudioEnd);
+
+		/// Convolve all submitted sources and mix them into a stereo output.
+		void ProcessBlock(FMultichannelBufferView& OutAudio, bool bClampOutput = false);
+
+		int32 GetNumActiveSources() const { return NumActiveSources; }
+		
+	protected:
+		bool IsSourceFinish(int32 SourceId) const;
+		void PackSourceCoefs(int32 SourceId);
+		/** Push one block into the delay line of a source and copy its delayed input. An empty view pushes silence. */
+		void PushSourceInput(int32 SourceId, const TArrayView<const float>& InAudio);
+		void ConvolvePackedChannel(TArrayView<float>& OutAudio, const FAlignedFloatBuffer& DelayedInput,
+								   const FAlignedFloatBuffer& TwoRCos, const FAlignedFloatBuffer& GainF,
+								   const FAlignedFloatBuffer& GainPhi, const FAlignedFloatBuffer& R2,
+								   FAlignedFloatBuffer& Out1D, FAlignedFloatBuffer& Out2D,
+								   const float Threshold = 1e-5f);
+		
+	private:
+		float SamplingRate;
+		int32 NumFramesPerBlock;
+		int32 NumFramesDelayed;
+		int32 MaxNumSources;
+		int32 NumActiveSources;
+
+		TArray<TUniquePtr<FHRTFModal>> Sources;
+		TArray<bool> IsSourceUsed;
+		TArray<bool> IsSourceSubmitted;
+		
+		FAlignedFloatBuffer DelayedInLeft;
+		FAlignedFloatBuffer TwoRCosLeft;
+		FAlignedFloatBuffer GainFLeft;
+		FAlignedFloatBuffer GainPhiLeft;
+		FAlignedFloatBuffer R2Left;
+		FAlignedFloatBuffer Out1DLeft;
+		FAlignedFloatBuffer Out2DLeft;
+
+		FAlignedFloatBuffer DelayedInRight;
+		FAlignedFloatBuffer TwoRCosRight;
+		FAlignedFloatBuffer GainFRight;
+		FAlignedFloatBuffer GainPhiRight;
+		FAlignedFloatBuffer R2Right;
+		FAlignedFloatBuffer Out1DRight;
+		FAlignedFloatBuffer Out2DRight;
+	};
 }
@@ -0,0 +1,61 @@
+﻿// Copyright 2023-2024, Le Binh Son, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DSP/BufferVectorOperations.h"
+
+namespace LBSImpactSFXSynth
+{
+	using namespace Audio;
+
+	/// Linear phase half-band FIR used to change the sampling rate by a factor of 2.
+	/// Every other tap of a half-band filter is zero except the center one, so only the even taps are stored.
+	/// Both polyphase resamplers delay their signal by CenterTap samples at the higher rate.
+	struct IMPACTSFXSYNTH_API FHalfBandFilter
+	{
+		static constexpr int32 NumEvenTaps = 12;
+		static constexpr int32 NumTaps = 2 * NumEvenTaps - 1;
+		static constexpr int32 CenterTap = NumEvenTaps - 1;
+		/** Passband edge relative to the higher rate. A decimation and interpolation round trip is flat within 0.01 dB below it. */
+		static constexpr float PassbandRatio = 0.13f;
+
+		/** Blackman windowed coefficients of taps 0, 2, ..., NumTaps - 1, normalized so the DC gain is one. */
+		static const float* GetEvenTaps();
+	};
+
+	/// Decimate a stream by 2. The input can have any number of samples, odd counts are carried to the next call.
+	class IMPACTSFXSYNTH_API FHalfBandDecimator
+	{
+	public:
+		FHalfBandDecimator();
+		
+		void Reset();
+
+		/** OutAudio must hold at least (InAudio.Num() + 1) / 2 samples. Returns the number of written samples. */
+		int32 ProcessAudio(TArrayView<const float> InAudio, TArrayView<float> OutAudio);
+
+	private:
+		static constexpr int32 NumHistory = FHalfBandFilter::NumTaps - 1;
+		
+		FAlignedFloatBuffer WorkBuffer;
+		int32 Phase;
+	};
+
+	/// Interpolate a stream by 2. Each input sample creates exactly two output samples.
+	class IMPACTSFXSYNTH_API FHalfBandInterpolator
+	{
+	public:
+		FHalfBandInterpolator();
+		
+		void Reset();
+
+		/** OutAudio must hold at least 2 * InAudio.Num() samples. */
+		void ProcessAudio(TArrayView<const float> InAudio, TArrayView<float> OutAudio);
+
+	private:
+		static constexpr int32 NumHistory = FHalfBandFilter::NumEvenTaps - 1;
+		
+		FAlignedFloatBuffer WorkBuffer;
+	};
+}
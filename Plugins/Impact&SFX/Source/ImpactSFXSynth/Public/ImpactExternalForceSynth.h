@@ -21,6 +21,15 @@ namespace LBSImpactSFXSynth
 								const float AmplitudeScale = 1.f, const float DecayScale = 1.f, const float FreqScale = 1.f,
 								const bool bIsForceStop = true, bool bClampOutput = true);
 
+		/** Synthesize any number of contact forces with a single run of the modal bank.
+		 * Because the modal bank is linear, all forces are summed into one excitation per output channel first.
+		 * InForceGains can be empty (every force is added to every channel) or hold NumOutChannel gains for each force.
+		 * C++ only: the external force node still calls Synthesize with one force per output channel. */
+		bool SynthesizeMultiForces(FMultichannelBufferView& OutAudio, TArrayView<const TArrayView<const float>> InForces,
+								   TArrayView<const float> InForceGains, const FImpactModalObjAssetProxyPtr& ModalsParams,
+								   const float AmplitudeScale = 1.f, const float DecayScale = 1.f, const float FreqScale = 1.f,
+								   const bool bIsForceStop = true, bool bClampOutput = true);
+
 		virtual ~FImpactExternalForceSynth() = default;
 		
 	protected:
@@ -53,6 +62,9 @@ namespace LBSImpactSFXSynth
 		FAlignedFloatBuffer OutL2Buffer;
 		FAlignedFloatBuffer OutR1Buffer;
 		FAlignedFloatBuffer OutR2Buffer;
+
+		TArray<FAlignedFloatBuffer> MixedForceBuffers;
+		TArray<TArrayView<const float>> MixedForceViews;
 	
 	private:
 		float SamplingRate;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "DSP/BufferVectorOperations.h"
 
 namespace LBSImpactSFXSynth
 {
@@ -14,13 +15,53 @@ namespace LBSImpactSFXSynth
 		float FreqScale = 1.f;
 	};
 	
+	/** Precomputed spectral peaks of a modal set. Everything except the amplitude scale and time is baked in, so the same
+	 * table can be shared by all impacts which use the same modal params, decay scale and frequency scale. */
+	struct IMPACTSFXSYNTH_API FModalFFTTable
+	{
+		/** Raw amplitudes of modals. Padded to a multiple of audio register with zeros. */
+		Audio::FAlignedFloatBuffer Amps;
+		/** Clamped decay rates of modals. Padded to a multiple of audio register with zeros. */
+		Audio::FAlignedFloatBuffer Decays;
+		/** Amplitudes at the current frame. */
+		Audio::FAlignedFloatBuffer FrameAmps;
+		TArray<int32> StartBins;
+		TArray<int32> NumBins;
+		/** Gaussian weights of adjacent bins. Each modal has FModalFFT::NumWeights values starting from its start bin. */
+		TArray<float> Weights;
+		
+		const float* ParamsData = nullptr;
+		int32 NumParams = 0;
+		FModalMods Mods;
+		int32 NumModals = 0;
+		float MagScale = 1.f;
+
+		bool IsValid() const { return NumModals > 0; }
+		bool IsBuiltFor(TArrayView<const float> ModalsParams, const FModalMods& InMods) const;
+		void Reset();
+	};
+	
 	class IMPACTSFXSYNTH_API FModalFFT
 	{
 		static constexpr int32 NumAdjBin = 3;
+		/** Number of fractional bin positions stored in the gaussian look up table. */
+		static constexpr int32 GaussianLUTResolution = 256;
 		
 	public:
+		static constexpr int32 NumWeights = 2 * NumAdjBin + 1;
+		
 		static bool GetFFTMag(TArrayView<const float> ModalsParams, const float SamplingRate, const int32 NumFFT, const int32 HopSize,   
 		                      TArrayView<float> FFTMagBuffer, const int32 CurrentFrame, const FModalMods& InMods);
+
+		/** Build start bins, gaussian weights and decay rates of all modals. The amplitude scale of InMods is ignored. */
+		static void BuildTable(TArrayView<const float> ModalsParams, const float SamplingRate, const int32 NumFFT, const int32 NumMagBins,
+							   const FModalMods& InMods, FModalFFTTable& OutTable);
+
+		/** Same as the params version but only evaluates the decay of each modal at Time and scatters it using the prebuilt weights. */
+		static bool GetFFTMag(FModalFFTTable& Table, const float AmplitudeScale, const float Time, TArrayView<float> FFTMagBuffer);
+
+	private:
+		static const TArray<float>& GetGaussianLUT();
 		
 		virtual ~FModalFFT() = default;
 	};
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "HalfBandResampler.h"
 #include "ImpactModalObj.h"
 #include "DSP/MultichannelBuffer.h"
 
@@ -35,6 +36,34 @@ namespace LBSImpactSFXSynth
 		}
 	};
 	
+	/** Modals of one frequency band. A band with a decimation factor larger than 1 runs at SamplingRate / DecimationFactor. */
+	struct FModalReverbBand
+	{
+		int32 DecimationFactor = 1;
+		float TimeStep = 0.f;
+		int32 MaxNumModals = 0;
+		int32 CurrentNumModals = 0;
+		float LastInAudioSample = 0.f;
+		
+		FAlignedFloatBuffer FreqBuffer;
+		FAlignedFloatBuffer PhaseBuffer;
+		FAlignedFloatBuffer GainBuffer;
+		FAlignedFloatBuffer TwoDecayCosBuffer;
+		FAlignedFloatBuffer DecaySqrBuffer;
+		FAlignedFloatBuffer Activation1DBuffer;
+		FAlignedFloatBuffer ActivationBuffer;
+		FAlignedFloatBuffer OutL1Buffer;
+		FAlignedFloatBuffer OutL2Buffer;
+
+		/** One half-band stage for each factor of 2. */
+		TArray<FHalfBandDecimator> Decimators;
+		TArray<FHalfBandInterpolator> Interpolators;
+		FAlignedFloatBuffer OutBuffer;
+		/** Full rate output which has been synthesized but not mixed into the output yet. */
+		FAlignedFloatBuffer PendingBuffer;
+		int32 NumPendingFrames = 0;
+	};
+	
 	class IMPACTSFXSYNTH_API FModalReverb
 	{
 	public:
@@ -52,10 +81,16 @@ namespace LBSImpactSFXSynth
 		static constexpr float MaxRoomSize = 5000.f;
 		static constexpr float MaxOpenRoomFactor = 10.f;
 		static constexpr float DefaultDelay = 0.01f;
+
+		static constexpr int32 NumBands = 3;
+		/** Limits the latency and the number of half-band stages of a band. */
+		static constexpr int32 MaxBandDecimation = 4;
 		
+		/** bInIsMultirate = false runs every band at the output rate. It's only useful as a reference for the decimated bands. */
 		FModalReverb(const float InSamplingRate, const FModalReverbParams& InReverbParams,
 					 const int32 NumModalsLow, const int32 NumModalsMid, const int32 NumModalsHigh,
-		             const float InAbsorption, const float InRoomSize, const float InOpenFactor, const float InGain);
+		             const float InAbsorption, const float InRoomSize, const float InOpenFactor, const float InGain,
+		             const bool bInIsMultirate = true);
 		
 		bool CreateReverb(TArrayView<float>& OutAudio, const TArrayView<const float>& InAudio,
 						  const float InAbsorption, const float InRoomSize, const float InOpenRoomFactor,
@@ -64,24 +99,29 @@ namespace LBSImpactSFXSynth
 	protected:
 		void SetEnvCoefs(const float InAbsorption, float InRoomSize, float InOpenRoomFactor, const float InGain);
 		
-		void InitBuffers(const int32 NumModalsLow, const int32 NumModalsMid, const int32 NumModalsHigh);
-		void InitBufferBand(const float FMin, const float FMax, const int32 NumModals, const float BufferIndex, const float GainScale);
+		void InitBuffers(const int32 NumModalsLow, const int32 NumModalsMid, const int32 NumModalsHigh, const bool bIsMultirate);
+		/** Largest power of two decimation which keeps FMax inside the passband of every half-band stage. */
+		int32 GetBandDecimation(const float FMax) const;
+		void InitBand(FModalReverbBand& Band, const int32 DecimationFactor, const float FMin, const float FMax,
+					  const int32 NumModals, const float GainScale);
 		FORCEINLINE float GetDecayFromFreqScale(float FreqScale, float FreqScaleSqr) const;
 		FORCEINLINE float GetAmpFromFreqScale(float FreqScale, float FreqScaleSqr) const;
 		
-		void GetNumUsedModals(const bool bIsForceStop);
-		void ScatterFreqAndPhase();
+		void GetNumUsedModals(FModalReverbBand& Band, const bool bIsForceStop);
+		void ScatterFreqAndPhase(FModalReverbBand& Band);
 		
 		void ProcessAudio(TArrayView<float>& OutAudio, const TArrayView<const float>& InAudio,
 		                       const int32 NumOutputFrames);
+		void ProcessBand(FModalReverbBand& Band, TArrayView<float> OutAudio, TArrayView<const float> InAudio);
+		/** Run all modals of a band at its own sampling rate. OutAudio is overwritten. */
+		void ProcessModals(FModalReverbBand& Band, TArrayView<float> OutAudio, TArrayView<const float> InAudio) const;
 
 		FORCEINLINE float ProcessOneSample(const float* TwoRCosData, const float* R2Data, const float* GainFData, const float* GainCData,
-					float* OutL1BufferPtr, float* OutL2BufferPtr, const VectorRegister4Float& ThresholdReg,
+					float* OutL1BufferPtr, float* OutL2BufferPtr, const int32 NumModals, const VectorRegister4Float& ThresholdReg,
 					const VectorRegister4Float& InAudio1DReg, const VectorRegister4Float& InAudioReg) const;
 	
 	private:
 		float SamplingRate;
-		float LastInAudioSample;
 		float AmpScale;
 		float BaseDecay;
 		float OutDoorMinDecay;
@@ -89,17 +129,9 @@ namespace LBSImpactSFXSynth
         FModalReverbParams ReverbParams;
     
         float TimeStep;
-        int32 CurrentNumModals;
-		int32 MaxNumModals;
 
-        FAlignedFloatBuffer FreqBuffer;
-        FAlignedFloatBuffer PhaseBuffer;
-		FAlignedFloatBuffer GainBuffer;
-        FAlignedFloatBuffer TwoDecayCosBuffer;
-        FAlignedFloatBuffer DecaySqrBuffer;
-        FAlignedFloatBuffer Activation1DBuffer;
-        FAlignedFloatBuffer ActivationBuffer;
-        FAlignedFloatBuffer OutL1Buffer;
-        FAlignedFloatBuffer OutL2Buffer;
+		FModalReverbBand Bands[NumBands];
+		/** Ping-pong buffers for the decimation and interpolation stages. */
+		FAlignedFloatBuffer ResampleBuffers[2];
 	};
 }
\ No newline at end of file
@@ -53,6 +53,9 @@ namespace LBSImpactSFXSynth
 		void ForceStop();
 		
 		float GetCurrentMaxAmplitude() const;
+
+		/** Modals are only dropped together when the total amplitude fades out, so every used modal is active until then. */
+		int32 GetNumActiveModals() const { return IsFinished() ? 0 : NumTrueModal; }
 		
 	private:
 		void InitBuffers(const FImpactModalObjAssetProxyPtr& ModalsParamsPtr, const int32 NumUsedModals);
@@ -10,25 +10,30 @@ namespace LBSImpactSFXSynth
 {
 	using namespace Audio;
 
+	/// Four delay lines mixed by a Householder matrix. Each delay line is one lane of a vector register.
+	/// All lines share one interleaved power of two buffer and one write index, so wrapping is a single mask.
 	class FMultiDelayReverbMix
 	{
 	public:
 		static constexpr int32 NumChannels = 4;
 		
 		FMultiDelayReverbMix(float InSamplingRate, float InGain, float InMinDelay, float InMaxDelay);
+		/** Pick new delay lengths and clear all delay lines. The delay buffer is only reallocated if it must grow. */
+		void Init(float InGain, float InMinDelay, float InMaxDelay);
 		void ProcessAudio(TArrayView<float>&  OutAudio, const TArrayView<const float>& InAudio, const float FeedbackGain);
 		void ResetBuffers();
 
 	private:
 		FORCEINLINE void SetDecayGain(float InGain);
-		FORCEINLINE void ProcessOneSample(TArrayView<float>& OutAudio, int i, const float InSample);
 		
 		float SamplingRate;
 		float DecayGain;
 
-		TArray<int32> ChannelDelaySample;
-		TArray<int32> ChannelWriteIndex;
-		TArray<FAlignedFloatBuffer> DelayBuffers;
+		int32 ChannelDelaySample[NumChannels];
+		uint32 WriteIndex;
+		uint32 IndexMask;
+		/** Samples of all channels are interleaved. */
+		FAlignedFloatBuffer DelayBuffer;
 	};
 
 
@@ -5,6 +5,7 @@
 #include "ModalSynth.h"
 #include "ResidualSynth.h"
 #include "MultiImpactData.h"
+#include "CustomStatGroup.h"
 #include "DSP/Dsp.h"
 #include "DSP/BufferVectorOperations.h"
 #include "DSP/MultichannelBuffer.h"
@@ -66,6 +67,9 @@ namespace LBSImpactSFXSynth
 		
 		int32 GetSeed() const { return Seed; }
 		bool CanRun() const { return bHasModalSynth || bHasResidualSynth; }
+
+		/** Counters of the last Synthesize call. */
+		const FSynthBlockCounters& GetBlockCounters() const { return BlockCounters; }
 		
 	private:
 		FMultiImpactDataAssetProxyRef MultiImpactProxy;
@@ -99,6 +103,8 @@ namespace LBSImpactSFXSynth
 
 		float GlobalModalPitchShift;
 		float GlobalResidualPitchShift;
+
+		FSynthBlockCounters BlockCounters;
 		
 		bool SpawningNewImpacts(const int32 NumFramesToGenerate, const FMultiImpactSpawnParams& SpawnParams);
 		void StopWeakestSynths(int32 NumImpactToSpawn);
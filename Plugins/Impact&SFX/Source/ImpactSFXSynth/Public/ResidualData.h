@@ -155,6 +155,9 @@ public:
 	int32 GetNumCurves() const;
 
 	void SetResidualObj(UResidualObj* InObj);
+
+	/** Create a proxy that synthesizes from InResidualObjSnapshot with the current settings of this data. */
+	FResidualDataAssetProxyPtr CreatePreviewProxyData(UResidualObj* InResidualObjSnapshot) const;
 #endif
 
 private:
@@ -187,6 +190,13 @@ public:
 	
 	explicit FResidualDataAssetProxy(const UResidualData* InResidualData, const float PlaySpeed, const int32 Seed,
 	                                 const float StartTime, const float Duration, const float PitchShift);
+
+	/**
+	 * Use the settings of InResidualData but synthesize from InResidualObj instead of InResidualData->ResidualObj.
+	 * The editor uses this to run on a private copy of the residual object.
+	 */
+	FResidualDataAssetProxy(const UResidualData* InResidualData, UResidualObj* InResidualObj, const float PlaySpeed, const int32 Seed,
+	                        const float StartTime, const float Duration, const float PitchShift);
 	
 	/**
 	 * Should only be used in Editor for synthesizing
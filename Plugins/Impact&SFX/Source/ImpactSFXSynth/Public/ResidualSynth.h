@@ -58,6 +58,9 @@ namespace LBSImpactSFXSynth
 		float GetSamplingRate() const { return SamplingRate; }
 		
 		float GetCurrentFrameEnergy();
+
+		/** Number of residual frames synthesized by the last Synthesize call. */
+		int32 GetNumLastSynthesizedFrames() const { return NumLastSynthesizedFrames; }
 		
 		bool IsFinished() const;
 		bool IsRunning() const;
@@ -106,7 +109,7 @@ namespace LBSImpactSFXSynth
 		float PlaySpeed;
 		TArray<int32> FFTInterpolateIdxs;
 		TArray<float> Freqs;
-		TArray<int32> PhaseIndexes;
+		TArray<uint32> PhaseIndexes;
 		Audio::FAlignedFloatBuffer ErbFrameBuffer;
 		Audio::FAlignedFloatBuffer ErbPitchScaleBuffer;
 		Audio::FAlignedFloatBuffer ErbInterpolateBuffer;
@@ -136,6 +139,8 @@ namespace LBSImpactSFXSynth
 		//Used to track and compare energy in multi impacts
 		float LastEnergyFrame;
 		float CurrentFrameEnergy;
+
+		int32 NumLastSynthesizedFrames;
 		
 		bool IsPitchScale() const;
 	};
@@ -44,14 +44,26 @@ namespace LBSImpactSFXSynth
 		int32 Frame = 0;
 		
 		float AmpScale = 1.0f;
-		FModalMods ExciteModalMods = FModalMods();
+		/** Index into the mods table of the synth. */
+		int32 ModsIndex = 0;
+		
+		float ExciteAmpScale = 1.0f;
 		bool bExciteModalEnable = true;
 		
-		FModalMods ResonModalMods = FModalMods();
+		float ResonAmpScale = 1.0f;
 		bool bResonModalEnable = true;
 
 		bool bResidualEnable = true;
 		float ResidualPitchScale = 1.f;
+
+		bool IsActive() const { return bResidualEnable || bExciteModalEnable || bResonModalEnable; }
+	};
+
+	/** Mods shared by all impacts spawned with the same input values. */
+	struct IMPACTSFXSYNTH_API FScratchImpactMods
+	{
+		FModalMods ExciteModalMods = FModalMods();
+		FModalMods ResonModalMods = FModalMods();
 	};
 
 	class IMPACTSFXSYNTH_API FScratchingSynth
@@ -71,6 +83,7 @@ namespace LBSImpactSFXSynth
 						FMultichannelBufferView& OutAudio, bool bClampOutput);
 
 		int32 GetSeed() const { return Seed; };
+		int32 GetNumActiveImpacts() const { return FMath::CountBits(ActiveImpactMask); }
 
 	protected:
 		void IniFFTBuffers();
@@ -80,6 +93,13 @@ namespace LBSImpactSFXSynth
 		bool SpawnImpactIfNeeded(const FScratchImpactSpawnParams& SpawnParams, const FImpactModalObjAssetProxyPtr& ExciteModalsParams, const FModalMods& ExciteModalMods,
 								 const FImpactModalObjAssetProxyPtr& ResonModalsParams, const FModalMods& ResonModalMods);
 		void SynthesizeCurrentImpacts(const FImpactModalObjAssetProxyPtr& ExciteModalsParams, const FImpactModalObjAssetProxyPtr& ResonModalsParams);
+		int32 AddImpact();
+		void CompactImpacts();
+		int32 FindOrAddImpactMods(const FModalMods& ExciteModalMods, const FModalMods& ResonModalMods);
+		
+		void UpdateModalFFTTable(const FImpactModalObjAssetProxyPtr& ModalsParams, const FModalMods& InMods, FModalFFTTable& Table) const;
+		bool GetModalFFTMag(const FImpactModalObjAssetProxyPtr& ModalsParams, const FModalMods& InMods, const float AmpScale,
+							FModalFFTTable& Table, const int32 DeltaFrame);
 		void DoIFFT();
 
 	private:
@@ -110,7 +130,18 @@ namespace LBSImpactSFXSynth
 		float LastImpactSpawnTime;
 		bool bIsFinalFrameSynth;
 		
-		TArray<FScratchImpactInfo> ImpactInfos;
+		//Ring of impacts ordered from oldest to newest, starting at ImpactHead. Finished impacts are cleared from ActiveImpactMask
+		FScratchImpactInfo ImpactInfos[MaxNumImpacts];
+		int32 ImpactHead;
+		int32 NumImpacts;
+		uint32 ActiveImpactMask;
+
+		FScratchImpactMods ImpactMods[MaxNumImpacts];
+		uint32 UsedImpactModsMask;
+
+		//One table per mods slot, shared by all impacts spawned with the same proxy and mods. Storage is kept when a slot is reused
+		FModalFFTTable ExciteFFTTables[MaxNumImpacts];
+		FModalFFTTable ResonFFTTables[MaxNumImpacts];
 	};
 }
 
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "MetasoundEnumDefinitions.h"
 #include "DSP/AlignedBuffer.h"
+#include <array>
 
 namespace LBSImpactSFXSynth
 {
@@ -16,20 +17,68 @@ namespace LBSImpactSFXSynth
 		Unknown
 	};
 	
-	class IMPACTSFXSYNTH_API FDrumModalPresets
+	namespace ResidualStatsPrivate
 	{
-	public:
-		// Statically-defined scale/chord tone definitions.
-		static TMap<Metasound::EDrumModalType, Audio::FAlignedFloatBuffer> PresetMap;
-	};
+		/** Compile-time sine. X is folded into [-Pi/2, Pi/2] and evaluated with a degree 17 Taylor polynomial (error < 1e-12). */
+		constexpr double ConstexprSin(double X)
+		{
+			constexpr double Pi = 3.14159265358979323846;
+			while(X > Pi)
+				X -= 2.0 * Pi;
+			while(X < -Pi)
+				X += 2.0 * Pi;
+			
+			if(X > 0.5 * Pi)
+				X = Pi - X;
+			else if(X < -0.5 * Pi)
+				X = -Pi - X;
+
+			const double X2 = X * X;
+			double Term = X;
+			double Sum = X;
+			for(int32 i = 1; i <= 8; i++)
+			{
+				Term *= -X2 / ((2 * i) * (2 * i + 1));
+				Sum += Term;
+			}
+			return Sum;
+		}
+
+		template <int32 N>
+		constexpr std::array<float, N> MakeSinCycle()
+		{
+			std::array<float, N> Table {};
+			for(int32 i = 0; i < N; i++)
+				Table[i] = static_cast<float>(ConstexprSin(2.0 * 3.14159265358979323846 * i / N));
+			return Table;
+		}
+
+		constexpr bool IsNearlyEqual(const float A, const float B, const float Tolerance)
+		{
+			return (A - B) <= Tolerance && (B - A) <= Tolerance;
+		}
+	}
 	
 	class IMPACTSFXSYNTH_API FResidualStats
 	{
 	public:
-		static constexpr int32 NumSinPoint = 1024; // must match SinCycle.Num()
-		static constexpr int32 MaxSinIdx = 1023;
-		static constexpr int32 CosShift = 256;
-		static constexpr float SinStep = UE_TWO_PI / 1024.f;
-		static Audio::FAlignedFloatBuffer SinCycle;
+		static constexpr int32 NumSinPoint = 1024;
+		static constexpr uint32 MaxSinIdx = NumSinPoint - 1;
+		static constexpr uint32 CosShift = NumSinPoint / 4;
+		static constexpr float SinStep = UE_TWO_PI / NumSinPoint;
+		alignas(16) static constexpr std::array<float, NumSinPoint> SinCycle = ResidualStatsPrivate::MakeSinCycle<NumSinPoint>();
+
+		/** Phase indexes wrap by masking, so any uint32 phase accumulator can be passed directly. */
+		FORCEINLINE static float Sin(const uint32 PhaseIndex) { return SinCycle[PhaseIndex & MaxSinIdx]; }
+		FORCEINLINE static float Cos(const uint32 PhaseIndex) { return SinCycle[(PhaseIndex + CosShift) & MaxSinIdx]; }
 	};
+
+	static_assert((FResidualStats::NumSinPoint & (FResidualStats::NumSinPoint - 1)) == 0, "Phase masking requires a power of two table size.");
+	static_assert(FResidualStats::SinCycle[0] == 0.f);
+	static_assert(FResidualStats::SinCycle[FResidualStats::CosShift] == 1.f);
+	static_assert(FResidualStats::SinCycle[3 * FResidualStats::CosShift] == -1.f);
+	static_assert(ResidualStatsPrivate::IsNearlyEqual(FResidualStats::SinCycle[FResidualStats::NumSinPoint / 2], 0.f, 1e-7f));
+	static_assert(ResidualStatsPrivate::IsNearlyEqual(FResidualStats::SinCycle[FResidualStats::NumSinPoint / 8], 0.70710678f, 1e-7f));
+	static_assert(ResidualStatsPrivate::IsNearlyEqual(FResidualStats::SinCycle[1], 0.0061358847f, 1e-9f));
+	static_assert(ResidualStatsPrivate::IsNearlyEqual(FResidualStats::SinCycle[FResidualStats::NumSinPoint - 1], -0.0061358847f, 1e-9f));
 }
@@ -0,0 +1,52 @@
+﻿// Copyright 2023-2024, Le Binh Son, All Rights Reserved.
+
+#pragma once
+
+#include "Extend/RCurveExtend.h"
+#include "DSP/AlignedBuffer.h"
+
+namespace LBSImpactSFXSynth
+{
+	using namespace Audio;
+
+	/// Mip-mapped cyclic wavetable baked from a single cycle curve.
+	/// Level 0 is the curve resampled to a power of 2 length. Each next level is half-band filtered and decimated by 2
+	/// so reading at high speed picks a level which doesn't alias.
+	class IMPACTSFXSYNTH_API FCycleWaveTable
+	{
+	public:
+		static constexpr int32 MaxTableLength = 4096;
+		static constexpr int32 MinTableLength = 8;
+		static constexpr int32 MaxNumLevels = 10;
+		static_assert((MinTableLength << (MaxNumLevels - 1)) == MaxTableLength);
+		
+		/** All levels are reserved at their largest size so Build doesn't allocate for curves up to MaxTableLength points. */
+		FCycleWaveTable();
+
+		/// Bake all mip levels from the input curve.
+		/// Curves longer than MaxTableLength are band limited by the half-band cascade before they become level 0.
+		/// @param InCurve Cyclic curve. The last key is assumed to be the same as the first key.
+		void Build(const FRCurveExtendAssetProxy& InCurve);
+
+		bool IsValid() const { return NumLevels > 0; }
+		
+		/// Read values from the table by using linear interpolation
+		/// @param StartPercent Start position in the cycle. Must be >= 0.
+		/// @param PercentStep The cycle percent step between two output samples
+		/// @param OutArray Out Array
+		void Read(float StartPercent, float PercentStep, TArrayView<float> OutArray) const;
+		
+	protected:
+		int32 GetLevel(float PercentStep) const;
+
+		/** Cyclic half-band low-pass of Upper then keep every other sample. Upper size must be a power of 2 and twice the size of Lower. */
+		static void DecimateCyclic(TArrayView<const float> Upper, TArrayView<float> Lower);
+		
+	private:
+		TArray<FAlignedFloatBuffer> Levels;
+		int32 NumLevels;
+
+		/** Only used for curves longer than MaxTableLength */
+		FAlignedFloatBuffer ScratchBuffers[2];
+	};
+}
@@ -4,6 +4,7 @@
 
 #include "Math/RandomStream.h"
 #include "Extend/RCurveExtend.h"
+#include "VehicleSFX/CycleWaveTable.h"
 #include "DSP/AlignedBuffer.h"
 
 namespace LBSImpactSFXSynth
@@ -38,6 +39,8 @@ namespace LBSImpactSFXSynth
 		void ResetCycleIndex() { CurrentCycleIndex = 0; }
 		
 	protected:
+		static void UpdateWaveTable(const FRCurveExtendAssetProxyPtr& InCurve, FRCurveExtendAssetProxyPtr& OutCachedCurve, FCycleWaveTable& OutWaveTable);
+		
 		void RemapCurrentCycleIndex(int32 NumSamplesPerCycle, int32 NumSamplesFirstState, int32 NumSamplesSecondState);
 		
 		void MergeNoise(EForceNoiseMergeMode NoiseMode, float Amp, TArrayView<float> OutBufferView);
@@ -50,6 +53,8 @@ namespace LBSImpactSFXSynth
 
 		FRCurveExtendAssetProxyPtr FirstCurve;
 		FRCurveExtendAssetProxyPtr SecondCurve;
+		FCycleWaveTable FirstWaveTable;
+		FCycleWaveTable SecondWaveTable;
 		
 		int32 CurrentCycleIndex;
 
@@ -18,7 +18,7 @@ namespace LBSImpactSFXSynth
 							  const FImpactModalObjAssetProxyPtr& ModalsParams,
 							  const int32 NumModal, const int32 NumModalNonThrottle,
 							  const float InHarmonicGain, 
-							  const int32 InSeed = -1);
+							  const int32 InSeed = -1, const float InControlRate = 100.f);
 
 		void Generate(FMultichannelBufferView& OutAudio, const FVehicleEngineParams& Params, const FImpactModalObjAssetProxyPtr& ModalsParams);
 
@@ -32,14 +32,16 @@ namespace LBSImpactSFXSynth
 		FORCEINLINE float GetRandFreq(const FVehicleEngineParams& Params, float RPMFreqRate, float FreqVar, float Freq) const;
 		FORCEINLINE void AddToInterpEnv(int Index, float NewEnv, float InterpSpeed = 1.f);
 
+		/** Compute target P and Q of the used modals at control rate then ramp current coefficients to them in one control period */
 		void UpdateFreqParams(const FVehicleEngineParams& Params, TArrayView<const float> ModalData, float RPMFreqRate, float FreqVar);
+		void UpdateFinalAmps(const FVehicleEngineParams& Params);
 		
 		void ChangeEngineMode(const FVehicleEngineParams& Params);
 
 		void SetNonThrottleMode(const int NumNoThrottleModals);
 		void SetThrottleMode();
 
-		void VectorSynthHarmonics(TArrayView<float> OutBuffer);
+		void RenderHarmonics(TArrayView<float> OutBuffer, const bool bIsRamping);
 
 		int32 GetNumNonZeroEnvelop();
 		
@@ -60,9 +62,16 @@ namespace LBSImpactSFXSynth
 		int32 NumUsedParams;
 		int32 NumTrueModal;
 		float LastHarmonicRand;
-		FAlignedFloatBuffer D1Buffer;
-		FAlignedFloatBuffer D2Buffer;
-		FAlignedFloatBuffer TwoRCosBuffer;
+		FAlignedFloatBuffer RealBuffer;
+		FAlignedFloatBuffer ImgBuffer;
+		FAlignedFloatBuffer PBuffer;
+		FAlignedFloatBuffer QBuffer;
+		FAlignedFloatBuffer DecayBuffer;
+		FAlignedFloatBuffer AngleBuffer;
+		FAlignedFloatBuffer TargetPBuffer;
+		FAlignedFloatBuffer TargetQBuffer;
+		FAlignedFloatBuffer PDeltaBuffer;
+		FAlignedFloatBuffer QDeltaBuffer;
 		FAlignedFloatBuffer TargetEnvelopBuffer;
 		FAlignedFloatBuffer CurrentEnvelopeBuffer;
 		FAlignedFloatBuffer CurrentFreqBuffer;
@@ -70,6 +79,11 @@ namespace LBSImpactSFXSynth
 
 		int32 CurrentModeNumModals;
 		int32 NumModalSynth;
+
+		int32 ControlPeriod;
+		int32 ControlCounter;
+		int32 RampRemaining;
+		bool bHasCoefs;
 		
 		TMap<int32, float> EnvelopeIdxMap;
 
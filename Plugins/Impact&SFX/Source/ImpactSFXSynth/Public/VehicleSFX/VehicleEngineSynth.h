@@ -70,7 +70,7 @@ namespace LBSImpactSFXSynth
 		FVehicleEngineSynth(const float InSamplingRate, const int32 InNumPulsePerCycle,
 							  const FImpactModalObjAssetProxyPtr& ModalsParams, const int32 NumModal,
 							  const float InHarmonicGain, const float InHarmonicFreqScale,
-							  const int32 InSeed = -1);
+							  const int32 InSeed = -1, const float InControlRate = 100.f);
 
 		void Generate(FMultichannelBufferView& OutAudio, const FVehicleEngineParams& Params, const FImpactModalObjAssetProxyPtr& ModalsParams);
 
@@ -87,6 +87,10 @@ namespace LBSImpactSFXSynth
 
 		void SetDecelerationMode(const FVehicleEngineParams& Params);
 		void SetNonDecelerationMode(const FVehicleEngineParams& Params);
+
+		/** Compute target P and Q from AngleBuffer and DecayBuffer then ramp current coefficients to them in one control period */
+		void UpdateTargetCoefs();
+		void RenderHarmonics(TArrayView<float> OutBuffer, const bool bIsRamping);
 	
 	private:
 		float SamplingRate;
@@ -112,6 +116,18 @@ namespace LBSImpactSFXSynth
 		FAlignedFloatBuffer QBuffer;
 		FAlignedFloatBuffer PBuffer;
 		FAlignedFloatBuffer DecayBuffer;
+		FAlignedFloatBuffer AngleBuffer;
+		FAlignedFloatBuffer TargetPBuffer;
+		FAlignedFloatBuffer TargetQBuffer;
+		FAlignedFloatBuffer PDeltaBuffer;
+		FAlignedFloatBuffer QDeltaBuffer;
+
+		int32 ControlPeriod;
+		int32 ControlCounter;
+		int32 RampRemaining;
+		bool bIsTargetChanged;
+		bool bIsFreqChanged;
+		bool bHasCoefs;
 
 		int32 CurrentNumModalUsed;
 		
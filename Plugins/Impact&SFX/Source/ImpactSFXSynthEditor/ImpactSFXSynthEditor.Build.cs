@@ -38,7 +38,9 @@ public class ImpactSFXSynthEditor : ModuleRules
                 "Json", 
                 "JsonUtilities", 
                 "EditorScriptingUtilities", 
-                "MetasoundEditor"
+                "MetasoundEditor",
+                "Projects",
+                "SHVirtualInstrument"
             }
         );
         
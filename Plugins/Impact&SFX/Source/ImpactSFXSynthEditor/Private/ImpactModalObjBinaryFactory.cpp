@@ -0,0 +1,299 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+
+#include "ImpactModalObjBinaryFactory.h"
+
+#include "AssetToolsModule.h"
+#include "AutomatedAssetImportData.h"
+#include "ImpactSFXSynthEditorLog.h"
+#include "ImpactModalObj.h"
+#include "EditorFramework/AssetImportData.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "Impact modal binary files are read without byte swapping.");
+
+namespace LBSImpactSFXSynth
+{
+	namespace Editor
+	{
+		struct FImpactModalBinaryHeader
+		{
+			static constexpr uint32 MagicId = 0x42504D49; // "IMPB"
+			static constexpr uint32 CurrentFormatVersion = 1;
+			static constexpr uint32 HasChecksumFlag = 1;
+			
+			uint32 Magic;
+			uint32 FormatVersion;
+			int32 Version;
+			int32 NumModals;
+			uint32 Flags;
+			uint32 Checksum;
+		};
+		static_assert(sizeof(FImpactModalBinaryHeader) == 24, "FImpactModalBinaryHeader must be packed.");
+
+		static constexpr int32 NumParamsPerModal = 3;
+	}
+}
+
+static bool bImpactModalObjBinaryFactorySuppressImportOverwriteDialog = false;
+
+const TCHAR* UImpactModalObjBinaryFactory::FileExtension = TEXT("impbin");
+
+UImpactModalObjBinaryFactory::UImpactModalObjBinaryFactory()
+{
+	bCreateNew = false;
+	SupportedClass = UImpactModalObj::StaticClass();
+	bEditorImport = true;
+	bText = false;
+	
+	Formats.Add(TEXT("impbin;Impact Obj binary file"));
+	
+	bAutomatedReimport = true;
+}
+
+UObject* UImpactModalObjBinaryFactory::FactoryCreateBinary(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags,
+	UObject* Context, const TCHAR* Type, const uint8*& Buffer, const uint8* BufferEnd, FFeedbackContext* Warn)
+{
+	UImpactModalObj* ExisingImpactModalObj = FindObject<UImpactModalObj>(InParent, *InName.ToString());
+
+	bool bUseExistingSettings = bImpactModalObjBinaryFactorySuppressImportOverwriteDialog;
+
+	if (ExisingImpactModalObj && !bUseExistingSettings && !GIsAutomationTesting)
+	{
+		DisplayOverwriteOptionsDialog(FText::Format(
+			NSLOCTEXT("ImpactModalObjBinaryFactory", "ImportOverwriteWarning", "You are about to import '{0}' over an existing impact modal obj."),
+			FText::FromName(InName)));
+
+		switch (OverwriteYesOrNoToAllState)
+		{
+			case EAppReturnType::Yes:
+			case EAppReturnType::YesAll:
+			{
+				bUseExistingSettings = false;
+				break;
+			}
+			case EAppReturnType::No:
+			case EAppReturnType::NoAll:
+			{
+				bUseExistingSettings = true;
+				break;
+			}
+			default:
+			{
+				GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, nullptr);
+				return nullptr;
+			}
+		}
+	}
+
+	bImpactModalObjBinaryFactorySuppressImportOverwriteDialog = false;
+
+	UImpactModalObj* ImpactModalObj = (bUseExistingSettings && ExisingImpactModalObj) ? ExisingImpactModalObj : NewObject<UImpactModalObj>(InParent, InName, Flags);
+	if(ImportFromBinary(ImpactModalObj, Buffer, BufferEnd))
+	{
+		ImpactModalObj->AssetImportData->Update(CurrentFilename);
+		
+		GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, ImpactModalObj);
+		return ImpactModalObj;
+	}
+
+	GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, nullptr);
+	return nullptr;
+}
+
+bool UImpactModalObjBinaryFactory::ImportFromBinary(UImpactModalObj* ImpactModalObj, const uint8* Buffer, const uint8* BufferEnd)
+{
+	using namespace LBSImpactSFXSynth::Editor;
+	
+	const int64 BufferSize = BufferEnd - Buffer;
+	if(BufferSize < static_cast<int64>(sizeof(FImpactModalBinaryHeader)))
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("Imported Impact Modal Obj binary file is too small!"));
+		return false;
+	}
+	
+	FImpactModalBinaryHeader Header;
+	FMemory::Memcpy(&Header, Buffer, sizeof(FImpactModalBinaryHeader));
+	if(Header.Magic != FImpactModalBinaryHeader::MagicId || Header.FormatVersion > FImpactModalBinaryHeader::CurrentFormatVersion)
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("Imported Impact Modal Obj binary file has an unsupported header!"));
+		return false;
+	}
+	
+	if(Header.Version <= 0)
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("Imported Impact Modal Obj has invalid Version = %d!"), Header.Version);
+		return false;
+	}
+
+	const int64 NumParams = static_cast<int64>(Header.NumModals) * NumParamsPerModal;
+	const int64 PayloadSize = NumParams * sizeof(float);
+	if(Header.NumModals <= 0 || BufferSize - static_cast<int64>(sizeof(FImpactModalBinaryHeader)) != PayloadSize)
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("Imported Impact Modal Obj has invalid length!"));
+		return false;
+	}
+
+	const uint8* Payload = Buffer + sizeof(FImpactModalBinaryHeader);
+	if((Header.Flags & FImpactModalBinaryHeader::HasChecksumFlag) && FCrc::MemCrc32(Payload, PayloadSize) != Header.Checksum)
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("Imported Impact Modal Obj binary file is corrupted!"));
+		return false;
+	}
+
+	//Payload is planar (all amps, then decays, then freqs) while Params interleaves amp, decay and freq of each modal
+	const int32 NumModals = Header.NumModals;
+	const float* Amps = reinterpret_cast<const float*>(Payload);
+	const float* Decays = Amps + NumModals;
+	const float* Freqs = Decays + NumModals;
+	
+	ImpactModalObj->Params.SetNumUninitialized(NumParams);
+	float* Params = ImpactModalObj->Params.GetData();
+	for(int32 i = 0, j = 0; i < NumModals; i++, j += NumParamsPerModal)
+	{
+		Params[j] = Amps[i];
+		Params[j + 1] = Decays[i];
+		Params[j + 2] = Freqs[i];
+	}
+
+	ImpactModalObj->Version = Header.Version;
+	ImpactModalObj->NumModals = NumModals;
+	return true;
+}
+
+bool UImpactModalObjBinaryFactory::ExportToBinaryFile(const UImpactModalObj* ImpactModalObj, const FString& Filename, bool bWriteChecksum)
+{
+	using namespace LBSImpactSFXSynth::Editor;
+	
+	if(ImpactModalObj == nullptr || ImpactModalObj->NumModals <= 0 || ImpactModalObj->Params.Num() != ImpactModalObj->NumModals * NumParamsPerModal)
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("UImpactModalObjBinaryFactory::ExportToBinaryFile: invalid impact modal obj!"));
+		return false;
+	}
+
+	const int32 NumModals = ImpactModalObj->NumModals;
+	const int32 PayloadSize = ImpactModalObj->Params.Num() * sizeof(float);
+	TArray<uint8> Data;
+	Data.SetNumUninitialized(sizeof(FImpactModalBinaryHeader) + PayloadSize);
+
+	uint8* Payload = Data.GetData() + sizeof(FImpactModalBinaryHeader);
+	float* Amps = reinterpret_cast<float*>(Payload);
+	float* Decays = Amps + NumModals;
+	float* Freqs = Decays + NumModals;
+	const float* Params = ImpactModalObj->Params.GetData();
+	for(int32 i = 0, j = 0; i < NumModals; i++, j += NumParamsPerModal)
+	{
+		Amps[i] = Params[j];
+		Decays[i] = Params[j + 1];
+		Freqs[i] = Params[j + 2];
+	}
+	
+	FImpactModalBinaryHeader Header;
+	Header.Magic = FImpactModalBinaryHeader::MagicId;
+	Header.FormatVersion = FImpactModalBinaryHeader::CurrentFormatVersion;
+	Header.Version = ImpactModalObj->Version;
+	Header.NumModals = NumModals;
+	Header.Flags = bWriteChecksum ? FImpactModalBinaryHeader::HasChecksumFlag : 0;
+	Header.Checksum = bWriteChecksum ? FCrc::MemCrc32(Payload, PayloadSize) : 0;
+	FMemory::Memcpy(Data.GetData(), &Header, sizeof(FImpactModalBinaryHeader));
+
+	return FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+
+TArray<UObject*> UImpactModalObjBinaryFactory::ImportDirectory(const FString& SourceDirectory, const FString& DestinationPath, bool bReplaceExisting)
+{
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *FPaths::Combine(SourceDirectory, FString::Printf(TEXT("*.%s"), FileExtension)), true, false);
+	IFileManager::Get().FindFiles(FileNames, *FPaths::Combine(SourceDirectory, TEXT("*.impobj")), true, false);
+	if(FileNames.Num() == 0)
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("UImpactModalObjBinaryFactory::ImportDirectory: no modal files found in %s"), *SourceDirectory);
+		return TArray<UObject*>();
+	}
+	
+	for(FString& FileName : FileNames)
+		FileName = FPaths::Combine(SourceDirectory, FileName);
+	
+	UAutomatedAssetImportData* ImportData = NewObject<UAutomatedAssetImportData>();
+	ImportData->Filenames = MoveTemp(FileNames);
+	ImportData->DestinationPath = DestinationPath;
+	ImportData->bReplaceExisting = bReplaceExisting;
+
+	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
+	return AssetToolsModule.Get().ImportAssetsAutomated(ImportData);
+}
+
+bool UImpactModalObjBinaryFactory::CanReimport(UObject* Obj, TArray<FString>& OutFilenames)
+{
+	if (UImpactModalObj* ImpactModalObj = Cast<UImpactModalObj>(Obj))
+	{
+		const FString Filename = ImpactModalObj->AssetImportData->GetFirstFilename();
+		if(FPaths::GetExtension(Filename).Equals(FileExtension, ESearchCase::IgnoreCase))
+		{
+			OutFilenames.Add(Filename);
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+void UImpactModalObjBinaryFactory::SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths)
+{
+	UImpactModalObj* ImpactModalObj = Cast<UImpactModalObj>(Obj);
+	if (ImpactModalObj && ensure(NewReimportPaths.Num() == 1))
+	{
+		ImpactModalObj->AssetImportData->UpdateFilenameOnly(NewReimportPaths[0]);
+	}
+}
+
+EReimportResult::Type UImpactModalObjBinaryFactory::Reimport(UObject* Obj)
+{
+	if (!Obj || !Obj->IsA(UImpactModalObj::StaticClass()))
+		return EReimportResult::Failed;	
+
+	UImpactModalObj* ImpactModalObj = Cast<UImpactModalObj>(Obj);
+	check(ImpactModalObj);
+
+	const FString Filename = ImpactModalObj->AssetImportData->GetFirstFilename();
+	if (!Filename.Len() || !FPaths::GetExtension(Filename).Equals(FileExtension, ESearchCase::IgnoreCase))
+		return EReimportResult::Failed;
+
+	UE_LOG(LogImpactSFXSynthEditor, Log, TEXT("Performing reimport of [%s]"), *Filename);
+
+	if (IFileManager::Get().FileSize(*Filename) == INDEX_NONE)
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("-- cannot reimport: source file cannot be found."));
+		return EReimportResult::Failed;
+	}
+
+	bImpactModalObjBinaryFactorySuppressImportOverwriteDialog = true;
+
+	bool OutCanceled = false;
+	if (!ImportObject(ImpactModalObj->GetClass(), ImpactModalObj->GetOuter(), *ImpactModalObj->GetName(), RF_Public | RF_Standalone, Filename, nullptr, OutCanceled))
+	{
+		if (OutCanceled)
+		{
+			UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("-- import canceled"));
+			return EReimportResult::Cancelled;
+		}
+
+		UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("-- import failed"));
+		return EReimportResult::Failed;
+	}
+
+	UE_LOG(LogImpactSFXSynthEditor, Log, TEXT("-- imported successfully"));
+
+	ImpactModalObj->AssetImportData->Update(Filename);
+	ImpactModalObj->MarkPackageDirty();
+
+	return EReimportResult::Succeeded;
+}
+
+void UImpactModalObjBinaryFactory::CleanUp()
+{
+	Super::CleanUp();
+}
@@ -3,6 +3,7 @@
 
 #include "ImpactModalObjFactory.h"
 
+#include "ImpactModalObjBinaryFactory.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "ImpactSFXSynthEditorLog.h"
 #include "ImpactModalObj.h"
@@ -125,8 +126,9 @@ bool UImpactModalObjFactory::ImportFromText(UImpactModalObj* ImpactModalObj,  co
 
 bool UImpactModalObjFactory::CanReimport(UObject* Obj, TArray<FString>& OutFilenames)
 {
+	//Binary files are reimported by UImpactModalObjBinaryFactory
 	if (UImpactModalObj* ImpactModalObj = Cast<UImpactModalObj>(Obj))
-		return true;
+		return !FPaths::GetExtension(ImpactModalObj->AssetImportData->GetFirstFilename()).Equals(UImpactModalObjBinaryFactory::FileExtension, ESearchCase::IgnoreCase);
 	
 	return false;
 }
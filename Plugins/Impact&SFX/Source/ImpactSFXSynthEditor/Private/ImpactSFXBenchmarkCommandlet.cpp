@@ -0,0 +1,200 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "ImpactSFXBenchmarkCommandlet.h"
+
+#include "ImpactModalObj.h"
+#include "ImpactSFXSynthEditorLog.h"
+#include "MultiImpactData.h"
+#include "ResidualData.h"
+#include "SynthBenchmarkUtils.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Piano/PianoModel.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace LBSImpactSFXSynth
+{
+	namespace Benchmark
+	{
+		/** Blocks rendered before measuring so lazily built tables and first-block buffers are not counted. */
+		static constexpr int32 NumWarmUpBlocks = 8;
+
+		template<typename TObjectType>
+		static bool LoadAssetParam(const TMap<FString, FString>& ParamVals, const TCHAR* Key, TObjectType*& OutAsset)
+		{
+			const FString* Path = ParamVals.Find(Key);
+			if(Path == nullptr)
+				return true;
+
+			OutAsset = LoadObject<TObjectType>(nullptr, **Path);
+			if(OutAsset == nullptr)
+			{
+				UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("ImpactSFXBenchmarkCommandlet: can't load %s=%s"), Key, **Path);
+				return false;
+			}
+			return true;
+		}
+	}
+}
+
+UImpactSFXBenchmarkCommandlet::UImpactSFXBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UImpactSFXBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::Benchmark;
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	TArray<int32> SampleRates;
+	ParseIntList(ParamVals.Find(TEXT("SampleRates")), { 48000, 44100 }, SampleRates);
+	TArray<int32> BlockSizes;
+	ParseIntList(ParamVals.Find(TEXT("BlockSizes")), { 256, 512, 1024 }, BlockSizes);
+
+	const FString* SecondsValue = ParamVals.Find(TEXT("Seconds"));
+	const float Seconds = SecondsValue ? FMath::Max(0.1f, FCString::Atof(**SecondsValue)) : 10.f;
+	const FString* SeedValue = ParamVals.Find(TEXT("Seed"));
+	const int32 Seed = SeedValue ? FCString::Atoi(**SeedValue) : 1234;
+	const FString* Filter = ParamVals.Find(TEXT("Filter"));
+	const FString* OutputValue = ParamVals.Find(TEXT("Output"));
+	const FString OutputPath = OutputValue ? *OutputValue : GetDefaultOutputPath();
+
+	UImpactModalObj* ModalObj = nullptr;
+	UResidualData* ResidualData = nullptr;
+	UMultiImpactData* MultiImpactData = nullptr;
+	UPianoModel* PianoModel = nullptr;
+	if(!LoadAssetParam(ParamVals, TEXT("ModalObj"), ModalObj) || !LoadAssetParam(ParamVals, TEXT("ResidualData"), ResidualData)
+		|| !LoadAssetParam(ParamVals, TEXT("MultiImpactData"), MultiImpactData) || !LoadAssetParam(ParamVals, TEXT("PianoModel"), PianoModel))
+		return 1;
+
+	FBenchmarkAssets Assets;
+	CreateBenchmarkAssets(Seed, ModalObj, ResidualData, MultiImpactData, Assets);
+	if(PianoModel)
+		Assets.PianoProxy = PianoModel->CreateNewPianoModelProxyData();
+	else
+		UE_LOG(LogImpactSFXSynthEditor, Display, TEXT("ImpactSFXBenchmarkCommandlet: -PianoModel isn't set. PianoSynth is skipped."));
+
+	TArray<TSharedPtr<FJsonValue>> JsonResults;
+	FAlignedFloatBuffer OutBuffer;
+	for(const FBenchmarkCase& Case : GetBenchmarkCases())
+	{
+		if(Filter && !Case.Name.Contains(*Filter))
+			continue;
+
+		for(const int32 SampleRate : SampleRates)
+		{
+			for(const int32 BlockSize : BlockSizes)
+			{
+				const float SamplingRate = static_cast<float>(SampleRate);
+				TUniquePtr<FSynthRunner> Runner = Case.CreateRunner(Assets, SamplingRate, BlockSize);
+				if(!Runner.IsValid())
+					continue;
+
+				OutBuffer.SetNumZeroed(BlockSize);
+				const int32 NumBlocks = FMath::CeilToInt32(Seconds * SamplingRate / BlockSize);
+				uint64 TotalCycles = 0;
+				int64 TotalVoices = 0;
+				int32 NumAllocations = 0;
+				{
+					FScopedAllocationCounter AllocationCounter;
+					AllocationCounter.Pause();
+					for(int32 Block = 0; Block < NumWarmUpBlocks + NumBlocks; Block++)
+					{
+						Runner->Prepare();
+
+						const bool bIsMeasured = Block >= NumWarmUpBlocks;
+						if(bIsMeasured)
+							AllocationCounter.Resume();
+						const uint64 StartCycles = FPlatformTime::Cycles64();
+						const int32 NumVoices = Runner->Render(OutBuffer);
+						const uint64 EndCycles = FPlatformTime::Cycles64();
+						AllocationCounter.Pause();
+
+						if(bIsMeasured)
+						{
+							TotalCycles += EndCycles - StartCycles;
+							TotalVoices += NumVoices;
+						}
+					}
+					NumAllocations = AllocationCounter.GetNumAllocations();
+				}
+
+				const double WallSeconds = FMath::Max(TotalCycles * FPlatformTime::GetSecondsPerCycle64(), UE_DOUBLE_SMALL_NUMBER);
+				const int64 NumSamples = static_cast<int64>(NumBlocks) * BlockSize;
+				const double AudioSeconds = NumSamples / static_cast<double>(SamplingRate);
+				const double AverageVoices = static_cast<double>(TotalVoices) / NumBlocks;
+				const double NsPerSample = WallSeconds * 1e9 / NumSamples;
+				const double VoicesPerMs = AverageVoices * AudioSeconds / WallSeconds;
+				const double AllocationsPerBlock = static_cast<double>(NumAllocations) / NumBlocks;
+
+				UE_LOG(LogImpactSFXSynthEditor, Display, TEXT("%-24s %6d Hz %5d frames: %8.2f ns/sample, %10.2f voices/ms, %6.3f allocations/block"),
+					   *Case.Name, SampleRate, BlockSize, NsPerSample, VoicesPerMs, AllocationsPerBlock);
+
+				const TSharedRef<FJsonObject> JsonResult = MakeShared<FJsonObject>();
+				JsonResult->SetStringField(TEXT("Name"), Case.Name);
+				JsonResult->SetNumberField(TEXT("SampleRate"), SampleRate);
+				JsonResult->SetNumberField(TEXT("BlockSize"), BlockSize);
+				JsonResult->SetNumberField(TEXT("NumBlocks"), NumBlocks);
+				JsonResult->SetNumberField(TEXT("NsPerSample"), NsPerSample);
+				JsonResult->SetNumberField(TEXT("VoicesPerMs"), VoicesPerMs);
+				JsonResult->SetNumberField(TEXT("AverageVoices"), AverageVoices);
+				JsonResult->SetNumberField(TEXT("AllocationsPerBlock"), AllocationsPerBlock);
+				JsonResults.Add(MakeShared<FJsonValueObject>(JsonResult));
+			}
+		}
+	}
+
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetNumberField(TEXT("Seed"), Seed);
+	JsonObject->SetNumberField(TEXT("Seconds"), Seconds);
+	JsonObject->SetNumberField(TEXT("NumWarmUpBlocks"), NumWarmUpBlocks);
+	JsonObject->SetArrayField(TEXT("Results"), JsonResults);
+
+	FString JsonText;
+	const TSharedRef<TJsonWriter<TCHAR>> JsonWriter = TJsonWriterFactory<TCHAR>::Create(&JsonText);
+	if(!FJsonSerializer::Serialize(JsonObject, JsonWriter) || !FFileHelper::SaveStringToFile(JsonText, *OutputPath))
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("ImpactSFXBenchmarkCommandlet: can't write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogImpactSFXSynthEditor, Display, TEXT("ImpactSFXBenchmarkCommandlet: %d results written to %s"), JsonResults.Num(), *OutputPath);
+	return 0;
+}
+
+void UImpactSFXBenchmarkCommandlet::ParseIntList(const FString* Value, const TArray<int32>& Defaults, TArray<int32>& OutValues)
+{
+	if(Value == nullptr)
+	{
+		OutValues = Defaults;
+		return;
+	}
+
+	TArray<FString> Entries;
+	Value->ParseIntoArray(Entries, TEXT("+"));
+	for(const FString& Entry : Entries)
+	{
+		const int32 IntValue = FCString::Atoi(*Entry);
+		if(IntValue > 0)
+			OutValues.AddUnique(IntValue);
+	}
+
+	if(OutValues.Num() == 0)
+		OutValues = Defaults;
+}
+
+FString UImpactSFXBenchmarkCommandlet::GetDefaultOutputPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ImpactSFXSynth") / TEXT("Benchmark.json");
+}
@@ -0,0 +1,267 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "ResidualAnalysisCommandlet.h"
+
+#include "ImpactSFXSynthEditorLog.h"
+#include "ObjectTools.h"
+#include "ResidualAnalyzer.h"
+#include "ResidualObj.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "EditorFramework/AssetImportData.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+namespace LBSImpactSFXSynth
+{
+	namespace ResidualAnalysisCommandlet
+	{
+		static const TCHAR* DefaultAffix = TEXT("RO_");
+		
+		struct FAnalysisJob
+		{
+			FString SourceFile;
+			FString PackageName;
+			FString CacheKey;
+			UResidualObj* ResidualObj = nullptr;
+			bool bIsSuccess = false;
+		};
+	}
+}
+
+UResidualAnalysisCommandlet::UResidualAnalysisCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UResidualAnalysisCommandlet::Main(const FString& Params)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::ResidualAnalysisCommandlet;
+	
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	const FString* Source = ParamVals.Find(TEXT("Source"));
+	const FString* Dest = ParamVals.Find(TEXT("Dest"));
+	if(Source == nullptr || Dest == nullptr || !FPackageName::IsValidLongPackageName(*Dest / TEXT("Dummy")))
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("Usage: -run=ResidualAnalysis -Source=<Dir or File[+File...]> -Dest=/Game/Path [-Channel=N] [-Force]"));
+		return 1;
+	}
+
+	const FString* ChannelValue = ParamVals.Find(TEXT("Channel"));
+	const int32 Channel = ChannelValue ? FCString::Atoi(**ChannelValue) : 0;
+	const bool bIsForce = Switches.Contains(TEXT("Force"));
+	
+	TArray<FString> SourceFiles;
+	TMap<FString, FString> SubFolders;
+	GatherSourceFiles(*Source, SourceFiles, SubFolders);
+	if(SourceFiles.Num() == 0)
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("ResidualAnalysisCommandlet: no wav files found in %s"), **Source);
+		return 0;
+	}
+	
+	TArray<FString> CacheKeys;
+	CacheKeys.SetNum(SourceFiles.Num());
+	ParallelFor(SourceFiles.Num(), [&](const int32 Index)
+	{
+		CacheKeys[Index] = MakeCacheKey(SourceFiles[Index], Channel);
+	});
+
+	TMap<FString, FString> Cache;
+	LoadCache(Cache);
+
+	//UObjects are created and saved on this thread. Only the analysis itself runs on the worker pool
+	int32 NumFailed = 0;
+	TArray<FAnalysisJob> Jobs;
+	Jobs.Empty(SourceFiles.Num());
+	TMap<FString, FString> PackageSources;
+	for(int32 i = 0; i < SourceFiles.Num(); i++)
+	{
+		if(CacheKeys[i].IsEmpty())
+		{
+			UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("ResidualAnalysisCommandlet: can't read %s"), *SourceFiles[i]);
+			NumFailed++;
+			continue;
+		}
+		
+		const FString AssetName = ObjectTools::SanitizeObjectName(DefaultAffix + FPaths::GetBaseFilename(SourceFiles[i]));
+		const FString PackageName = MakePackageName(*Dest, SubFolders.FindRef(SourceFiles[i]), AssetName);
+		
+		//Two jobs on one object would analyze into the same data concurrently
+		if(const FString* OtherSource = PackageSources.Find(PackageName))
+		{
+			UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("ResidualAnalysisCommandlet: %s and %s both map to %s. Rename one of them."),
+				   **OtherSource, *SourceFiles[i], *PackageName);
+			NumFailed++;
+			continue;
+		}
+		PackageSources.Add(PackageName, SourceFiles[i]);
+		
+		const FString* CachedKey = Cache.Find(PackageName);
+		if(!bIsForce && CachedKey && *CachedKey == CacheKeys[i] && FPackageName::DoesPackageExist(PackageName))
+		{
+			UE_LOG(LogImpactSFXSynthEditor, Display, TEXT("ResidualAnalysisCommandlet: %s is up to date."), *PackageName);
+			continue;
+		}
+
+		UPackage* Package = FPackageName::DoesPackageExist(PackageName) ? LoadPackage(nullptr, *PackageName, LOAD_None) : nullptr;
+		if(Package == nullptr)
+			Package = CreatePackage(*PackageName);
+		UResidualObj* ResidualObj = FindObject<UResidualObj>(Package, *AssetName);
+		if(ResidualObj == nullptr)
+			ResidualObj = NewObject<UResidualObj>(Package, *AssetName, RF_Public | RF_Standalone);
+		
+		FAnalysisJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.SourceFile = SourceFiles[i];
+		Job.PackageName = PackageName;
+		Job.CacheKey = CacheKeys[i];
+		Job.ResidualObj = ResidualObj;
+	}
+
+	UE_LOG(LogImpactSFXSynthEditor, Display, TEXT("ResidualAnalysisCommandlet: analyzing %d of %d files."), Jobs.Num(), SourceFiles.Num());
+	ParallelFor(Jobs.Num(), [&](const int32 Index)
+	{
+		FAnalysisJob& Job = Jobs[Index];
+		FResidualAnalyzer Analyzer = FResidualAnalyzer(Job.SourceFile, Channel);
+		Job.bIsSuccess = Analyzer.StartAnalyzing(Job.ResidualObj);
+	});
+
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	for(const FAnalysisJob& Job : Jobs)
+	{
+		if(!Job.bIsSuccess)
+		{
+			UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("ResidualAnalysisCommandlet: failed to analyze %s"), *Job.SourceFile);
+			NumFailed++;
+			continue;
+		}
+		
+		Job.ResidualObj->AssetImportData->Update(Job.SourceFile);
+		Job.ResidualObj->MarkPackageDirty();
+		AssetRegistryModule.Get().AssetCreated(Job.ResidualObj);
+		
+		UPackage* Package = Job.ResidualObj->GetPackage();
+		const FString PackageFileName = FPackageName::LongPackageNameToFilename(Job.PackageName, FPackageName::GetAssetPackageExtension());
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+		if(!UPackage::SavePackage(Package, Job.ResidualObj, *PackageFileName, SaveArgs))
+		{
+			UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("ResidualAnalysisCommandlet: failed to save %s"), *PackageFileName);
+			NumFailed++;
+			continue;
+		}
+		
+		Cache.Add(Job.PackageName, Job.CacheKey);
+	}
+
+	SaveCache(Cache);
+	UE_LOG(LogImpactSFXSynthEditor, Display, TEXT("ResidualAnalysisCommandlet: finished with %d failures."), NumFailed);
+	return NumFailed > 0 ? 1 : 0;
+}
+
+void UResidualAnalysisCommandlet::GatherSourceFiles(const FString& Source, TArray<FString>& OutFiles, TMap<FString, FString>& OutSubFolders)
+{
+	TArray<FString> Entries;
+	Source.ParseIntoArray(Entries, TEXT("+"));
+	for(const FString& Entry : Entries)
+	{
+		if(FPaths::DirectoryExists(Entry))
+		{
+			TArray<FString> FoundFiles;
+			IFileManager::Get().FindFilesRecursive(FoundFiles, *Entry, TEXT("*.wav"), true, false);
+			const FString RootDir = FPaths::ConvertRelativePathToFull(Entry);
+			for(const FString& FoundFile : FoundFiles)
+			{
+				const FString FullPath = FPaths::ConvertRelativePathToFull(FoundFile);
+				FString SubFolder = FPaths::GetPath(FullPath);
+				if(FPaths::MakePathRelativeTo(SubFolder, *(RootDir / TEXT(""))) && !SubFolder.IsEmpty() && SubFolder != TEXT("."))
+					OutSubFolders.Add(FullPath, SubFolder);
+				OutFiles.Emplace(FullPath);
+			}
+		}
+		else if(FPaths::FileExists(Entry))
+			OutFiles.Emplace(Entry);
+		else
+			UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("ResidualAnalysisCommandlet: %s doesn't exist."), *Entry);
+	}
+	
+	for(FString& File : OutFiles)
+		File = FPaths::ConvertRelativePathToFull(File);
+	OutFiles.Sort();
+}
+
+FString UResidualAnalysisCommandlet::MakePackageName(const FString& Dest, const FString& SubFolder, const FString& AssetName)
+{
+	FString PackagePath = Dest;
+	TArray<FString> Folders;
+	SubFolder.ParseIntoArray(Folders, TEXT("/"));
+	for(const FString& Folder : Folders)
+		PackagePath /= ObjectTools::SanitizeInvalidChars(Folder, INVALID_LONGPACKAGE_CHARACTERS);
+	return PackagePath / AssetName;
+}
+
+FString UResidualAnalysisCommandlet::MakeCacheKey(const FString& SourceFile, const int32 Channel)
+{
+	using namespace LBSImpactSFXSynth;
+	
+	const FMD5Hash FileHash = FMD5Hash::HashFile(*SourceFile);
+	if(!FileHash.IsValid())
+		return FString();
+
+	//Any change of the analysis settings invalidates previous results
+	return FString::Printf(TEXT("%s_%d_%d_%d_%d"), *LexToString(FileHash), FResidualAnalyzer::NumFFTAnalyze,
+						   FResidualAnalyzer::HopSizeAnalyze, FResidualAnalyzer::NumErb, Channel);
+}
+
+FString UResidualAnalysisCommandlet::GetCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ImpactSFXSynth") / TEXT("ResidualAnalysisCache.json");
+}
+
+void UResidualAnalysisCommandlet::LoadCache(TMap<FString, FString>& OutCache)
+{
+	FString JsonText;
+	if(!FFileHelper::LoadFileToString(JsonText, *GetCacheFilePath()))
+		return;
+
+	TSharedPtr<FJsonObject> JsonParsed;
+	const TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(JsonText);
+	if(!FJsonSerializer::Deserialize(JsonReader, JsonParsed) || !JsonParsed.IsValid())
+	{
+		UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("ResidualAnalysisCommandlet: cache file is invalid and will be rebuilt."));
+		return;
+	}
+	
+	for(const auto& Entry : JsonParsed->Values)
+		OutCache.Add(Entry.Key, Entry.Value->AsString());
+}
+
+void UResidualAnalysisCommandlet::SaveCache(const TMap<FString, FString>& InCache)
+{
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	for(const auto& Entry : InCache)
+		JsonObject->SetStringField(Entry.Key, Entry.Value);
+
+	FString JsonText;
+	const TSharedRef<TJsonWriter<TCHAR>> JsonWriter = TJsonWriterFactory<TCHAR>::Create(&JsonText);
+	if(!FJsonSerializer::Serialize(JsonObject, JsonWriter) || !FFileHelper::SaveStringToFile(JsonText, *GetCacheFilePath()))
+		UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("ResidualAnalysisCommandlet: can't write cache file %s"), *GetCacheFilePath());
+}
@@ -6,57 +6,105 @@
 #include "ResidualObj.h"
 #include "ResidualData.h"
 #include "ResidualSynth.h"
+#include "Async/ParallelFor.h"
 #include "DSP/AudioFFT.h"
 #include "DSP/FloatArrayMath.h"
+#include "EditorFramework/AssetImportData.h"
+#include "Misc/SecureHash.h"
 #include "Sound/SoundWave.h"
 
 namespace LBSImpactSFXSynth
 {
-	FResidualAnalyzer::FResidualAnalyzer(const USoundWave* Wave)
+	FResidualAnalyzer::FResidualAnalyzer(const USoundWave* Wave, const int32 InChannel, const bool bStreamSourceFile)
+		: bIsFFTValid(false), Channel(InChannel), NumPaddedSamples(0), PaddedReadPos(0), LastLoudIdx(INDEX_NONE), OrgPower(0.0)
 	{
-		TArray<uint8> ImportedSoundWaveData;
-		uint32 ImportedSampleRate;
-		uint16 ImportedChannelCount;
-		Wave->GetImportedSoundWaveData(ImportedSoundWaveData, ImportedSampleRate, ImportedChannelCount);
-		if(ImportedChannelCount > 2 || ImportedChannelCount <= 0)
+		if(Wave == nullptr || !OpenWave(Wave, bStreamSourceFile))
 		{
-			UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("FResidualAnalyzer: only mono and stereo audio are supported!"));
+			UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("FResidualAnalyzer: Can't read wave data!"));
 			return;
 		}
-		
-		SamplingRate = ImportedSampleRate;
-		const int32 TotalSamples = ImportedSoundWaveData.Num() / sizeof(int16);
-		
-		if (TotalSamples > 0)
+
+		InitAnalysis();
+	}
+
+	FResidualAnalyzer::FResidualAnalyzer(const FString& WaveFilePath, const int32 InChannel)
+		: bIsFFTValid(false), Channel(InChannel), NumPaddedSamples(0), PaddedReadPos(0), LastLoudIdx(INDEX_NONE), OrgPower(0.0)
+	{
+		if(!Reader.OpenFile(WaveFilePath))
+		{
+			UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("FResidualAnalyzer: Can't read wave file %s!"), *WaveFilePath);
+			return;
+		}
+
+		InitAnalysis();
+	}
+
+	void FResidualAnalyzer::InitAnalysis()
+	{
+		SamplingRate = Reader.GetSamplingRate();
+		if (Reader.GetNumFrames() > 0)
 		{
-			FFFTSettings FFTSettings;
 			FFTSettings.Log2Size = Audio::CeilLog2(NumFFTAnalyze);
 			FFTSettings.bArrays128BitAligned = true;
 			FFTSettings.bEnableHardwareAcceleration = true;
 		
 			checkf(Audio::FFFTFactory::AreFFTSettingsSupported(FFTSettings), TEXT("No fft algorithm supports fft settings."));
-			FFT = FFFTFactory::NewFFTAlgorithm(FFTSettings);
-			if(FFT.IsValid())
+			const TUniquePtr<IFFTAlgorithm> FFT = FFFTFactory::NewFFTAlgorithm(FFTSettings);
+			bIsFFTValid = FFT.IsValid();
+			if(bIsFFTValid)
 			{
-				GetPaddedWaveMonoData(ImportedSoundWaveData, ImportedChannelCount, TotalSamples);
 				InitFFTBuffers();
 				InitFreqBuffers();
+				NumPaddedSamples = HopSize + Reader.GetNumFrames() + NumFFTAnalyze;
 			}
 		}
 	}
 
+	bool FResidualAnalyzer::OpenWave(const USoundWave* Wave, const bool bStreamSourceFile)
+	{
+		if(bStreamSourceFile && OpenSourceFile(Wave))
+			return true;
+		
+		TArray<uint8> ImportedSoundWaveData;
+		uint32 ImportedSampleRate;
+		uint16 ImportedChannelCount;
+		Wave->GetImportedSoundWaveData(ImportedSoundWaveData, ImportedSampleRate, ImportedChannelCount);
+		return Reader.OpenPCM16(MoveTemp(ImportedSoundWaveData), ImportedSampleRate, ImportedChannelCount);
+	}
+
+	bool FResidualAnalyzer::OpenSourceFile(const USoundWave* Wave)
+	{
+#if WITH_EDITORONLY_DATA
+		if(Wave->AssetImportData == nullptr || Wave->AssetImportData->SourceData.SourceFiles.Num() == 0)
+			return false;
+
+		//The source file can be edited or replaced after import. Only use it if it's still the data of this asset.
+		const FString SourceFile = Wave->AssetImportData->GetFirstFilename();
+		if(SourceFile.IsEmpty() || !FPaths::FileExists(SourceFile))
+			return false;
+
+		const FMD5Hash& ImportedHash = Wave->AssetImportData->SourceData.SourceFiles[0].FileHash;
+		if(!ImportedHash.IsValid() || FMD5Hash::HashFile(*SourceFile) != ImportedHash)
+		{
+			UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("FResidualAnalyzer: Source file %s has changed since import. Imported data is used instead."), *SourceFile);
+			return false;
+		}
+		
+		return Reader.OpenFile(SourceFile);
+#else
+		return false;
+#endif
+	}
+	
 	void FResidualAnalyzer::InitFFTBuffers()
 	{
-		InReal.SetNumUninitialized(FFT->NumInputFloats());
-		OutComplex.SetNumUninitialized(FFT->NumOutputFloats());
-		OutMagnitude.SetNumUninitialized(FFT->NumOutputFloats() / 2);
-		WindowBuffer.SetNumUninitialized(FFT->NumInputFloats());
-		FResidualSynth::GenerateHannWindow(WindowBuffer.GetData(), FFT->NumInputFloats(), true);
+		WindowBuffer.SetNumUninitialized(NumFFTAnalyze);
+		FResidualSynth::GenerateHannWindow(WindowBuffer.GetData(), NumFFTAnalyze, true);
 	}
 
 	void FResidualAnalyzer::InitFreqBuffers()
 	{
-		HopSize = NumFFTAnalyze / 2;
+		HopSize = HopSizeAnalyze;
 		
 		ErbMin = UResidualData::Freq2Erb(FreqMin);
 		ErbMax = UResidualData::Freq2Erb(FreqMax);
@@ -90,75 +138,90 @@ namespace LBSImpactSFXSynth
 
 	bool FResidualAnalyzer::StartAnalyzing(UResidualObj* OutResidualObj)
 	{
-		const float Duration = WaveData.Num() / SamplingRate;
-		if(Duration > 10.0f)
-		{
-			UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("FResidualAnalyzer::StartAnalyzing: duration must be lower than 10 seconds!"));
-			return false;
-		}
-		
-		if(!FFT.IsValid())
+		if(!bIsFFTValid)
 		{
 			UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("FResidualAnalyzer::StartAnalyzing: invalid FFT algorithm!"));
 			return false;
 		}
 		
-		const int32 EndIdx = WaveData.Num() - NumFFTAnalyze; //Don't include end padding
-		int32 CurrentIdx = 0;
-		TArrayView<const float> WaveDataView = TArrayView<float>(WaveData);
-		const float* DataBuffer = WaveDataView.GetData();
-		float* InData = InReal.GetData();
-		float* OutComplexBuff = OutComplex.GetData();
-		const int32 NumFrames = EndIdx / NumFFTAnalyze;
+		const int64 EndIdx = NumPaddedSamples - NumFFTAnalyze; //Don't include end padding
+		const int64 NumFrames = EndIdx / NumFFTAnalyze;
 		if(NumFrames < UResidualObj::NumMinErbFrames)
 		{
 			UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("FResidualAnalyzer::StartAnalyzing: wave file is too short!"));
 			return false;
 		}
+
+		const int64 NumHops64 = (EndIdx + HopSize - 1) / HopSize;
+		if(NumHops64 * NumErb >= MAX_int32)
+		{
+			UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("FResidualAnalyzer::StartAnalyzing: wave file is too long!"));
+			return false;
+		}
 		
-		OutResidualObj->Data.Empty(NumErb * NumFrames);
-		TArray<float> ErbEnv;
-		ErbEnv.SetNumUninitialized(NumErb);
-		int32 NumFrame = 0;
-		while (CurrentIdx < EndIdx)
+		const int32 NumHops = static_cast<int32>(NumHops64);
+		Audio::FAlignedFloatBuffer& OutData = OutResidualObj->Data;
+		OutData.SetNumUninitialized(NumErb * NumHops);
+		TArray<float> TotalMags;
+		TotalMags.SetNumUninitialized(NumHops);
+
+		//Stream the wave data in windows of NumStreamHops hops and analyze each window in parallel.
+		//Memory usage of the input only depends on the window size, not the clip length.
+		const int32 NumChunks = NumAnalysisChunks > 0 ? NumAnalysisChunks : FMath::Max(1, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+		const int32 NumStreamHops = NumChunks * MinFramesPerChunk;
+		FAlignedFloatBuffer StreamBuffer;
+		StreamBuffer.SetNumUninitialized((NumStreamHops + 1) * HopSize);
+		
+		int32 NumBufferSamples = 0;
+		for(int32 StartHop = 0; StartHop < NumHops; StartHop += NumStreamHops)
 		{
-			FMemory::Memcpy(InData, &DataBuffer[CurrentIdx], NumFFTAnalyze * sizeof(float));
-			CurrentIdx += HopSize;
-			
-			Audio::ArrayMultiplyInPlace(WindowBuffer, InReal);
+			//Keep the last hop of the previous window as each frame overlaps with the next hop
+			if(NumBufferSamples > HopSize)
+			{
+				FMemory::Memmove(StreamBuffer.GetData(), &StreamBuffer[NumBufferSamples - HopSize], HopSize * sizeof(float));
+				NumBufferSamples = HopSize;
+			}
 			
-			FFT->ForwardRealToComplex(InData, OutComplexBuff);
-			Audio::ArrayComplexToPower(OutComplex, OutMagnitude);
-			Audio::ArraySqrtInPlace(OutMagnitude); //Use magnitude instead of power to reduce computational cost when synthesizing
-			Audio::ArrayMultiplyByConstantInPlace(OutMagnitude, 1.0 / NumFFTAnalyze);
+			const int32 NumWindowHops = FMath::Min(NumStreamHops, NumHops - StartHop);
+			const int32 NumNeeded = (NumWindowHops + 1) * HopSize;
+			NumBufferSamples += ReadPaddedWave(&StreamBuffer[NumBufferSamples], NumNeeded - NumBufferSamples);
+			if(NumBufferSamples < NumNeeded)
+				FMemory::Memzero(&StreamBuffer[NumBufferSamples], (NumNeeded - NumBufferSamples) * sizeof(float));
+			NumBufferSamples = NumNeeded;
 			
-			FMemory::Memzero(ErbEnv.GetData(), ErbEnv.Num() * sizeof(float));
-			for(int i = 0; i < NumFreqs; i++)
-				ErbEnv[Freq2ErbIndexes[i]] += OutMagnitude[i];
+			const int32 NumHopsPerChunk = FMath::Max(MinFramesPerChunk, FMath::DivideAndRoundUp(NumWindowHops, NumChunks));
+			const int32 NumWindowChunks = FMath::DivideAndRoundUp(NumWindowHops, NumHopsPerChunk);
+			ParallelFor(NumWindowChunks, [&](const int32 ChunkIdx)
+			{
+				const int32 StartChunkHop = ChunkIdx * NumHopsPerChunk;
+				const int32 NumChunkHops = FMath::Min(NumHopsPerChunk, NumWindowHops - StartChunkHop);
+				const int32 OutHop = StartHop + StartChunkHop;
+				if(NumChunkHops > 0)
+					AnalyzeFrames(&StreamBuffer[StartChunkHop * HopSize], NumChunkHops, &OutData[OutHop * NumErb], &TotalMags[OutHop]);
+			});
+		}
 
-			float TotalMag;
-			Audio::ArraySum(ErbEnv, TotalMag);
-			if(TotalMag < ErbCutThreshold)
+		//Trim silent frames serially. Kept frames are moved forward in place so the result is the same as the serial analysis
+		int32 NumFrame = 0;
+		for(int32 Hop = 0; Hop < NumHops; Hop++)
+		{
+			if(TotalMags[Hop] < ErbCutThreshold)
 			{
 				if(NumFrame == 0) //Still at starting frame then we just skip
 					continue;
-				
-				if(CurrentIdx < EndIdx) //If reaching end frame then we don't trim 
-				{
-					int32 RemainIdx = CurrentIdx;
-					while (RemainIdx < EndIdx && WaveDataView[RemainIdx] < ErbCutThreshold)
-						RemainIdx++;
-
-					if(RemainIdx >= EndIdx)
-						break;
-				}
+
+				//If reaching end frame then we don't trim. Otherwise, trim if all remaining samples are silent
+				const int64 CurrentIdx = static_cast<int64>(Hop + 1) * HopSize;
+				if(CurrentIdx < EndIdx && LastLoudIdx < CurrentIdx) 
+					break;
 			}
-			
-			for(int i = 0; i < NumErb; i++)
-				OutResidualObj->Data.Emplace(ErbEnv[i]);
+
+			if(NumFrame != Hop)
+				FMemory::Memmove(&OutData[NumFrame * NumErb], &OutData[Hop * NumErb], NumErb * sizeof(float));
 			
 			NumFrame++;
 		}
+		OutData.SetNum(NumFrame * NumErb);
 		
 		OutResidualObj->SetProperties(1, NumFFTAnalyze, HopSize, NumErb, NumFrame, SamplingRate, ErbMax, ErbMin);
 
@@ -166,53 +229,117 @@ namespace LBSImpactSFXSynth
 		return true;
 	}
 
-	void FResidualAnalyzer::GetPaddedWaveMonoData(TArray<uint8> ImportedSoundWaveData, uint16 ImportedChannelCount, int32 TotalSamples)
+	int32 FResidualAnalyzer::ReadPaddedWave(float* OutData, const int32 NumSamples)
 	{
-		const int32 NumSamples = TotalSamples / ImportedChannelCount;
-		const int32 Padding = NumFFTAnalyze / 2;
-		WaveData.SetNumUninitialized(NumSamples + Padding + NumFFTAnalyze);
-		FMemory::Memzero(WaveData.GetData(), WaveData.Num() * sizeof(float));
+		const int32 NumToRead = static_cast<int32>(FMath::Min<int64>(NumSamples, NumPaddedSamples - PaddedReadPos));
+		int32 NumRead = 0;
+		
+		//Zero padding at the start
+		const int32 NumStartPad = static_cast<int32>(FMath::Clamp<int64>(HopSize - PaddedReadPos, 0, NumToRead));
+		FMemory::Memzero(OutData, NumStartPad * sizeof(float));
+		NumRead += NumStartPad;
+
+		const int32 NumWave = Reader.ReadMono(TArrayView<float>(&OutData[NumRead], NumToRead - NumRead), Channel);
+		for(int32 i = NumRead; i < NumRead + NumWave; i++)
+		{
+			const float Value = OutData[i];
+			OrgPower += Value * Value;
+			if(Value >= ErbCutThreshold)
+				LastLoudIdx = PaddedReadPos + i;
+		}
+		NumRead += NumWave;
+
+		//Zero padding at the end
+		FMemory::Memzero(&OutData[NumRead], (NumToRead - NumRead) * sizeof(float));
+		PaddedReadPos += NumToRead;
+		return NumToRead;
+	}
+
+	void FResidualAnalyzer::AnalyzeFrames(const float* InData, const int32 NumFrames, float* OutErbData, float* OutTotalMags) const
+	{
+		const TUniquePtr<IFFTAlgorithm> FFT = FFFTFactory::NewFFTAlgorithm(FFTSettings);
+		FAlignedFloatBuffer InReal;
+		FAlignedFloatBuffer OutComplex;
+		FAlignedFloatBuffer OutMagnitude;
+		InReal.SetNumUninitialized(FFT->NumInputFloats());
+		OutComplex.SetNumUninitialized(FFT->NumOutputFloats());
+		OutMagnitude.SetNumUninitialized(FFT->NumOutputFloats() / 2);
+		
+		float* InRealData = InReal.GetData();
+		float* OutComplexBuff = OutComplex.GetData();
+		for(int32 Frame = 0; Frame < NumFrames; Frame++)
+		{
+			FMemory::Memcpy(InRealData, &InData[Frame * HopSize], NumFFTAnalyze * sizeof(float));
+			
+			Audio::ArrayMultiplyInPlace(WindowBuffer, InReal);
 			
-		const int16* InputBuffer = (int16*)ImportedSoundWaveData.GetData();
-		for (int32 i = 0, j = Padding; i < TotalSamples; i += ImportedChannelCount, j++) //Only use first channel
-			WaveData[j] = static_cast<float>(InputBuffer[i]) / 32768.0f;
+			FFT->ForwardRealToComplex(InRealData, OutComplexBuff);
+			Audio::ArrayComplexToPower(OutComplex, OutMagnitude);
+			Audio::ArraySqrtInPlace(OutMagnitude); //Use magnitude instead of power to reduce computational cost when synthesizing
+			Audio::ArrayMultiplyByConstantInPlace(OutMagnitude, 1.0 / NumFFTAnalyze);
+
+			TArrayView<float> ErbEnv = TArrayView<float>(&OutErbData[Frame * NumErb], NumErb);
+			FMemory::Memzero(ErbEnv.GetData(), NumErb * sizeof(float));
+			for(int i = 0; i < NumFreqs; i++)
+				ErbEnv[Freq2ErbIndexes[i]] += OutMagnitude[i];
+
+			Audio::ArraySum(ErbEnv, OutTotalMags[Frame]);
+		}
 	}
 
 	void FResidualAnalyzer::CalibrateSynthMagnitudeToOriginal(UResidualObj* OutResidualObj)
 	{
-		Audio::ArraySquareInPlace(WaveData);
-		float OrgPower;
-		Audio::ArraySum(WaveData, OrgPower);
-
 		const auto ResidualDataAssetProxy =  MakeShared<FResidualDataAssetProxy>(OutResidualObj);
 		float CurrentAmpScale = 1.f;
 		FResidualSynth ResidualSynth = FResidualSynth(SamplingRate, HopSize, 1, ResidualDataAssetProxy,
 													  1.f, CurrentAmpScale, 1.f, 0, 0.f, -1.f);
 		
 		Audio::FAlignedFloatBuffer SynthesizedData;
-		float UpperAmpScale = 10.0f;
-		float LowerAmpScale = 0.2f;
-		int NumLoops = 0;
-		float PowerFac = 0.f;
-		for(; NumLoops < 50; NumLoops++)
+		NumCalibrationPasses = 0;
+		bool bIsFirstPass = true;
+		auto GetPowerFactor = [&](const float AmpScale)
 		{
+			if(!bIsFirstPass)
+			{
+				ResidualSynth.ChangeScalingParams(0.f, -1.f, 1.f, AmpScale, 1.f, 1.f);
+				ResidualSynth.Restart();
+			}
+			bIsFirstPass = false;
+			NumCalibrationPasses++;
+			
 			FResidualSynth::SynthesizeFull(ResidualSynth, SynthesizedData);
 			Audio::ArraySquareInPlace(SynthesizedData);
 			float SynthPower = 0.f;
 			Audio::ArraySum(SynthesizedData, SynthPower);
-			
-			PowerFac = OrgPower / SynthPower;
-			if(FMath::IsNearlyEqual(PowerFac, 1.0f, 0.01f))
-				break;
+			return static_cast<float>(OrgPower / FMath::Max(SynthPower, UE_SMALL_NUMBER));
+		};
 
-			if(PowerFac < 1.0f)
-				UpperAmpScale = CurrentAmpScale;
-			else
-				LowerAmpScale = CurrentAmpScale;
-			CurrentAmpScale = (UpperAmpScale + LowerAmpScale) / 2.0f;
-			
-			ResidualSynth.ChangeScalingParams(0.f, -1.f, 1.f, CurrentAmpScale, 1.f, 1.f);
-			ResidualSynth.Restart();
+		//Synthesized power is quadratic to the amplitude scale (apart from random phase variance)
+		//So the scale can be found directly from the power ratio with one refinement pass
+		float PowerFac = GetPowerFactor(CurrentAmpScale);
+		if(!FMath::IsNearlyEqual(PowerFac, 1.0f, 0.01f))
+		{
+			CurrentAmpScale = FMath::Clamp(CurrentAmpScale * FMath::Sqrt(PowerFac), MinCalibrateScale, MaxCalibrateScale);
+			PowerFac = GetPowerFactor(CurrentAmpScale);
+		}
+
+		if(!FMath::IsNearlyEqual(PowerFac, 1.0f, 0.01f))
+		{
+			//Fallback to bisection if the random phase variance is too large
+			float UpperAmpScale = MaxCalibrateScale;
+			float LowerAmpScale = MinCalibrateScale;
+			for(int NumLoops = 0; NumLoops < 50; NumLoops++)
+			{
+				if(PowerFac < 1.0f)
+					UpperAmpScale = CurrentAmpScale;
+				else
+					LowerAmpScale = CurrentAmpScale;
+				CurrentAmpScale = (UpperAmpScale + LowerAmpScale) / 2.0f;
+				
+				PowerFac = GetPowerFactor(CurrentAmpScale);
+				if(FMath::IsNearlyEqual(PowerFac, 1.0f, 0.01f))
+					break;
+			}
 		}
 
 		Audio::ArrayMultiplyByConstantInPlace(OutResidualObj->Data, CurrentAmpScale);
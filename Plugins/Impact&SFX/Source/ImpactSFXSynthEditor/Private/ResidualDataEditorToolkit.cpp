@@ -3,15 +3,20 @@
 #include "ResidualDataEditorToolkit.h"
 
 #include "AudioDevice.h"
+#include "Async/Async.h"
 #include "EditorDialogLibrary.h"
 #include "ImpactSFXSynthEditorLog.h"
+#include "ResidualObj.h"
 #include "ResidualSynth.h"
 #include "SCurveEditorPanel.h"
+#include "SResidualDataWidget.h"
 #include "DSP/FloatArrayMath.h"
 #include "ImpactSFXSynth/Public/Utils.h"
 #include "Widgets/Docking/SDockTab.h"
 #include "Modules/ModuleManager.h"
 #include "Sound/SoundWaveProcedural.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
 
 #define LOCTEXT_NAMESPACE "ResidualDataEditor"
 
@@ -22,6 +27,22 @@ namespace LBSImpactSFXSynth
 		const FName FResidualDataEditorToolkit::AppIdentifier(TEXT("ResidualDataEditorApp"));
 		const FName FResidualDataEditorToolkit::PropertiesTabId(TEXT("ResidualDataEditor_Properties"));
 		const FName FResidualDataEditorToolkit::CurveTabId(TEXT("ResidualDataEditor_Curves"));
+		const FName FResidualDataEditorToolkit::SpectrogramTabId(TEXT("ResidualDataEditor_Spectrogram"));
+		
+		FResidualDataEditorToolkit::FResidualDataEditorToolkit()
+			: PreviewGeneration(MakeShared<FThreadSafeCounter, ESPMode::ThreadSafe>())
+			, bIsToolkitAlive(MakeShared<FThreadSafeBool, ESPMode::ThreadSafe>(true))
+			, bShouldZoomToFit(true)
+			, bPlayPendingPreview(false)
+		{
+		}
+
+		FResidualDataEditorToolkit::~FResidualDataEditorToolkit()
+		{
+			//Cancel running tasks and stop them from touching this toolkit
+			PreviewGeneration->Increment();
+			*bIsToolkitAlive = false;
+		}
 		
 		void FResidualDataEditorToolkit::Init(const EToolkitMode::Type Mode, const TSharedPtr<IToolkitHost>& InitToolkitHost, UObject* InParentObject)
 		{
@@ -62,7 +83,7 @@ namespace LBSImpactSFXSynth
 			PropertiesView = PropertyModule.CreateDetailView(Args);
 			PropertiesView->SetObject(InParentObject);
 
-			TSharedRef<FTabManager::FLayout> StandaloneDefaultLayout = FTabManager::NewLayout("ResidualDataEditor_Layoutv1")
+			TSharedRef<FTabManager::FLayout> StandaloneDefaultLayout = FTabManager::NewLayout("ResidualDataEditor_Layoutv2")
 			->AddArea
 			(
 				FTabManager::NewPrimaryArea()
@@ -90,6 +111,12 @@ namespace LBSImpactSFXSynth
 							->SetSizeCoefficient(0.33f)
 							->AddTab(CurveTabId, ETabState::OpenedTab)
 						)
+						->Split
+						(
+							FTabManager::NewStack()
+							->SetSizeCoefficient(0.15f)
+							->AddTab(SpectrogramTabId, ETabState::OpenedTab)
+						)
 					)
 				)
 			);
@@ -142,12 +169,18 @@ namespace LBSImpactSFXSynth
 			.SetDisplayName(LOCTEXT("ModificationCurvesTab", "Modification Curves"))
 			.SetGroup(WorkspaceMenuCategory.ToSharedRef())
 			.SetIcon(CurveIcon);
+
+			InTabManager->RegisterTabSpawner(SpectrogramTabId, FOnSpawnTab::CreateSP(this, &FResidualDataEditorToolkit::SpawnTab_Spectrogram))
+						.SetDisplayName(LOCTEXT("SpectrogramTab", "Residual Spectrogram"))
+						.SetGroup(WorkspaceMenuCategory.ToSharedRef())
+						.SetIcon(CurveIcon);
 		}
 
 		void FResidualDataEditorToolkit::UnregisterTabSpawners(const TSharedRef<class FTabManager>& InTabManager)
 		{
 			FAssetEditorToolkit::UnregisterTabSpawners(InTabManager);
 			InTabManager->UnregisterTabSpawner(CurveTabId);
+			InTabManager->UnregisterTabSpawner(SpectrogramTabId);
 			InTabManager->UnregisterTabSpawner(PropertiesTabId);
 		}
 
@@ -158,7 +191,10 @@ namespace LBSImpactSFXSynth
 				return;
 
 			if(IsCurvePropertyChanged(PropertyThatChanged))
+			{
 				RefreshCurves();
+				RequestPreviewSynthesis(false);
+			}
 		}
 
 		bool FResidualDataEditorToolkit::IsCurvePropertyChanged(FProperty* PropertyThatChanged)
@@ -257,6 +293,7 @@ namespace LBSImpactSFXSynth
 			if (bSuccess)
 			{
 				RefreshCurves();
+				RequestPreviewSynthesis(false);
 			}
 		}
 
@@ -265,6 +302,7 @@ namespace LBSImpactSFXSynth
 			if (bSuccess)
 			{
 				RefreshCurves();
+				RequestPreviewSynthesis(false);
 			}
 		}
 
@@ -468,10 +506,9 @@ namespace LBSImpactSFXSynth
 
 		TSharedRef<SDockTab> FResidualDataEditorToolkit::SpawnTab_OutputCurve(const FSpawnTabArgs& Args)
 		{
-			FAlignedFloatBuffer TempData;
-			SynthesizeDataAndCurves(TempData);
 			RefreshCurves();
-			CurveEditor->ZoomToFitAll();
+			bShouldZoomToFit = true;
+			RequestPreviewSynthesis(false);
 			
 			TSharedRef<SDockTab> NewDockTab = SNew(SDockTab)
 				.Label(FText::Format(LOCTEXT("ResidualDataCurveEditorTitle", "Modification Curve: {0}"), FText::FromString(GetEditingObject()->GetName())))
@@ -499,6 +536,29 @@ namespace LBSImpactSFXSynth
 				];
 		}
 
+		TSharedRef<SDockTab> FResidualDataEditorToolkit::SpawnTab_Spectrogram(const FSpawnTabArgs& Args)
+		{
+			check(Args.GetTabId() == SpectrogramTabId);
+
+			//Read the object through the attribute so switching or reimporting the residual object is picked up by the widget
+			TWeakObjectPtr<UResidualData> WeakResidualData = Cast<UResidualData>(GetEditingObject());
+			return SNew(SDockTab)
+				.Label(LOCTEXT("ResidualDataSpectrogramTitle", "Residual Spectrogram"))
+				[
+					SNew(SBorder)
+					.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
+					.Padding(0.0f)
+					[
+						SNew(SResidualDataWidget)
+						.ResidualData_Lambda([WeakResidualData]() -> UResidualObj*
+						{
+							const UResidualData* ResidualData = WeakResidualData.Get();
+							return ResidualData ? ResidualData->ResidualObj.Get() : nullptr;
+						})
+					]
+				];
+		}
+
 		void FResidualDataEditorToolkit::ClearExpressionCurve(int32 InIndex)
 		{
 			if (CurveData.IsValidIndex(InIndex))
@@ -549,86 +609,137 @@ namespace LBSImpactSFXSynth
 			if(!GEditor || !GEditor->CanPlayEditorSound())
 				return;
 
-			Audio::FAlignedFloatBuffer SynthesizedData;
-			SynthesizeDataAndCurves(SynthesizedData);			
-			PlaySynthesizedSound(SynthesizedData);
+			RequestPreviewSynthesis(true);
 		}
 
-		void FResidualDataEditorToolkit::SynthesizeDataAndCurves(Audio::FAlignedFloatBuffer& SynthesizedData)
+		void FResidualDataEditorToolkit::RequestPreviewSynthesis(const bool bPlayWhenFinished)
 		{
-			SynthesizedData.Empty();
-			SynthesizedCurve.CurveCustom.Reset();
-			MagFreqCurve.CurveCustom.Reset();
+			const int32 Generation = PreviewGeneration->Increment();
 			
 			UResidualData* ResidualData = Cast<UResidualData>(GetEditingObject());
-			if(ResidualData == nullptr || ResidualData->ResidualObj == nullptr)
+			FAudioDeviceHandle AudioDevice = GEngine ? GEngine->GetMainAudioDevice() : FAudioDeviceHandle();
+			//A newer request replaces an older one, so it must also take over any pending play
+			bPlayPendingPreview |= bPlayWhenFinished;
+			if(ResidualData == nullptr || ResidualData->ResidualObj == nullptr || !AudioDevice)
 			{
+				bPlayPendingPreview = false;
+				OnPreviewSynthesisFinished(FPreviewSynthResult());
 				return;
 			}
+
+			//Snapshot all parameters and a private copy of the residual object on the game thread,
+			//so edits or reimports made while synthesizing never touch data the running task is reading
+			TStrongObjectPtr<UResidualObj> ResidualObjSnapshot(DuplicateObject<UResidualObj>(ResidualData->ResidualObj, GetTransientPackage()));
+			const FResidualDataAssetProxyPtr ResidualDataAssetProxy = ResidualData->CreatePreviewProxyData(ResidualObjSnapshot.Get());
+			const float PlaySampleRate = AudioDevice->GetSampleRate();
+			const int32 HopSize = ResidualData->NumFFT / 2;
+			const float VolumeScale = ResidualData->PreviewVolumeScale;
 			
-			if(FAudioDeviceHandle AudioDevice = GEngine->GetMainAudioDevice())
+			TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> GenerationCounter = PreviewGeneration;
+			TSharedRef<FThreadSafeBool, ESPMode::ThreadSafe> IsAlive = bIsToolkitAlive;
+			Async(EAsyncExecution::ThreadPool, [this, GenerationCounter, IsAlive, Generation, ResidualDataAssetProxy,
+												ResidualObjSnapshot = MoveTemp(ResidualObjSnapshot),
+												PlaySampleRate, HopSize, VolumeScale]() mutable
 			{
-				const int32 NumChannel = FMath::Min(1, AudioDevice->GetMaxChannels());
-				if(NumChannel < 1)
-					return;
+				auto IsCancelled = [&GenerationCounter, Generation]() { return GenerationCounter->GetValue() != Generation; };
 				
-				const int32 HopSize = ResidualData->NumFFT / 2;
+				FPreviewSynthResult Result;
+				const bool bIsFinished = SynthesizeDataAndCurves(ResidualDataAssetProxy, PlaySampleRate, HopSize, VolumeScale, Result, IsCancelled);
+
+				//Always go back to the game thread so the snapshot is released there, even when cancelled
+				AsyncTask(ENamedThreads::GameThread, [this, GenerationCounter, IsAlive, Generation, bIsFinished,
+													  ResidualObjSnapshot = MoveTemp(ResidualObjSnapshot), Result = MoveTemp(Result)]() mutable
+				{
+					if(bIsFinished && *IsAlive && GenerationCounter->GetValue() == Generation)
+						OnPreviewSynthesisFinished(MoveTemp(Result));
+					ResidualObjSnapshot.Reset();
+				});
+			});
+		}
+
+		void FResidualDataEditorToolkit::OnPreviewSynthesisFinished(FPreviewSynthResult&& Result)
+		{
+			const bool bPlayWhenFinished = bPlayPendingPreview;
+			bPlayPendingPreview = false;
+			
+			SynthesizedCurve.CurveCustom.SetKeys(Result.EnergyKeys);
+			MagFreqCurve.CurveCustom.SetKeys(Result.MagFreqKeys);
+			RefreshCurves();
+			
+			if(bShouldZoomToFit && CurveEditor.IsValid())
+			{
+				CurveEditor->ZoomToFitAll();
+				bShouldZoomToFit = false;
+			}
+			
+			if(bPlayWhenFinished)
+				PlaySynthesizedSound(Result.SynthesizedData);
+		}
+
+		bool FResidualDataEditorToolkit::SynthesizeDataAndCurves(const FResidualDataAssetProxyPtr& ResidualDataAssetProxy, const float PlaySampleRate,
+																 const int32 HopSize, const float VolumeScale, FPreviewSynthResult& OutResult,
+																 TFunctionRef<bool()> IsCancelled)
+		{
+			constexpr int32 NumChannel = 1;
+			const float StartTime = ResidualDataAssetProxy->GetPreviewStartTime();
+			FResidualSynth ResidualSynth = FResidualSynth(PlaySampleRate, HopSize, NumChannel, ResidualDataAssetProxy.ToSharedRef(),
+														  ResidualDataAssetProxy->GetPreviewPlaySpeed(),
+														  VolumeScale,
+														  GetPitchScaleClamped(ResidualDataAssetProxy->GetPreviewPitchShift()),
+														  ResidualDataAssetProxy->GetPreviewSeed(),
+														  StartTime,
+														  ResidualDataAssetProxy->GetPreviewDuration(),
+														  false);
+			
+			int32 NumOutSamples =  FMath::CeilToInt32(ResidualSynth.GetMaxDuration() * PlaySampleRate);
+			NumOutSamples = FMath::Max(HopSize, NumOutSamples);
+
+			FAlignedFloatBuffer& SynthesizedData = OutResult.SynthesizedData;
+			SynthesizedData.SetNumUninitialized(NumOutSamples);
+			FMemory::Memzero(SynthesizedData.GetData(), NumOutSamples * sizeof(float));
+			OutResult.EnergyKeys.Empty(2 * FMath::DivideAndRoundUp(NumOutSamples, HopSize));
+
+			FAlignedFloatBuffer MagFreq;
+			MagFreq.SetNumUninitialized(ResidualSynth.GetCurrentMagFreq().Num());
+			FMemory::Memzero(MagFreq.GetData(), MagFreq.Num() * sizeof(float));
+			
+			FMultichannelBufferView OutAudioView;
+			OutAudioView.Emplace(SynthesizedData);
+			int32 CurrentFrame = 0;
+			bool bIsFinished = false;
+			int32 EndIdx = 0;
+			const int32 HalfHop = HopSize /2;
+			float CurrentTime = StartTime;
+			while (!bIsFinished && EndIdx <= NumOutSamples)
+			{
+				if(IsCancelled())
+					return false;
 				
-				const float PlaySampleRate = AudioDevice->GetSampleRate();
-				const auto ResidualDataAssetProxy =  ResidualData->CreateNewResidualProxyData().ToSharedRef();
-				const float StartTime = ResidualDataAssetProxy->GetPreviewStartTime();
-				FResidualSynth ResidualSynth = FResidualSynth(PlaySampleRate, HopSize, NumChannel, ResidualDataAssetProxy,
-															  ResidualDataAssetProxy->GetPreviewPlaySpeed(),
-															  ResidualData->PreviewVolumeScale,
-															  GetPitchScaleClamped(ResidualDataAssetProxy->GetPreviewPitchShift()),
-															  ResidualDataAssetProxy->GetPreviewSeed(),
-															  StartTime,
-															  ResidualDataAssetProxy->GetPreviewDuration(),
-															  false);
+				FMultichannelBufferView BufferView = SliceMultichannelBufferView(OutAudioView, CurrentFrame * HopSize, HopSize);
+				bIsFinished = ResidualSynth.Synthesize(BufferView, false, true);
 				
-				int32 NumOutSamples =  FMath::CeilToInt32(ResidualSynth.GetMaxDuration() * PlaySampleRate);
-				NumOutSamples = FMath::Max(HopSize, NumOutSamples);
+				float Magnitude = Audio::ArrayGetMagnitude(BufferView[0].Slice(0, HalfHop));
+				OutResult.EnergyKeys.Emplace(CurrentTime, Magnitude);
+				const float HalfDeltaTime = (ResidualSynth.GetCurrentTIme() - CurrentTime) / 2.0f;
+				CurrentTime += HalfDeltaTime;
 				
-				SynthesizedData.SetNumUninitialized(NumOutSamples);
-				FMemory::Memzero(SynthesizedData.GetData(), NumOutSamples * sizeof(float));
-
-				FAlignedFloatBuffer MagFreq;
-				MagFreq.SetNumUninitialized(ResidualSynth.GetCurrentMagFreq().Num());
-				FMemory::Memzero(MagFreq.GetData(), MagFreq.Num() * sizeof(float));
+				Magnitude = Audio::ArrayGetMagnitude(BufferView[0].Slice(HalfHop, HalfHop));
+				OutResult.EnergyKeys.Emplace(CurrentTime, Magnitude);
+				CurrentTime += HalfDeltaTime;
 				
-				FMultichannelBufferView OutAudioView;
-				OutAudioView.Emplace(SynthesizedData);
-				int32 CurrentFrame = 0;
-				bool bIsFinished = false;
-				int32 EndIdx = 0;
-				const int32 HalfHop = HopSize /2;
-				float CurrentTime = StartTime;
-				while (!bIsFinished && EndIdx <= NumOutSamples)
-				{
-					FMultichannelBufferView BufferView = SliceMultichannelBufferView(OutAudioView, CurrentFrame * HopSize, HopSize);
-					bIsFinished = ResidualSynth.Synthesize(BufferView, false, true);
-					
-					float Magnitude = Audio::ArrayGetMagnitude(BufferView[0].Slice(0, HalfHop));
-					SynthesizedCurve.CurveCustom.AddKey(CurrentTime, Magnitude, false);
-					const float HalfDeltaTime = (ResidualSynth.GetCurrentTIme() - CurrentTime) / 2.0f;
-					CurrentTime += HalfDeltaTime;
-					
-					Magnitude = Audio::ArrayGetMagnitude(BufferView[0].Slice(HalfHop, HalfHop));
-					SynthesizedCurve.CurveCustom.AddKey(CurrentTime, Magnitude, false);
-					CurrentTime += HalfDeltaTime;
-					
-					CurrentFrame++;
-					EndIdx = CurrentFrame * HopSize + HopSize;
-					
-					//This will not take into account the first frame as ResidualSynth.Synthesize will run 2 times at the start
-					Audio::ArrayAddInPlace(ResidualSynth.GetCurrentMagFreq(), MagFreq);
-				}
-
-				AddMagFreqCurveKeys(ResidualSynth, MagFreq);
+				CurrentFrame++;
+				EndIdx = CurrentFrame * HopSize + HopSize;
+				
+				//This will not take into account the first frame as ResidualSynth.Synthesize will run 2 times at the start
+				Audio::ArrayAddInPlace(ResidualSynth.GetCurrentMagFreq(), MagFreq);
 			}
+
+			BuildMagFreqCurveKeys(ResidualSynth, MagFreq, OutResult.MagFreqKeys);
+			return true;
 		}
 
-		void FResidualDataEditorToolkit::AddMagFreqCurveKeys(const LBSImpactSFXSynth::FResidualSynth& ResidualSynth, TArrayView<const float> MagFreq)
+		void FResidualDataEditorToolkit::BuildMagFreqCurveKeys(const LBSImpactSFXSynth::FResidualSynth& ResidualSynth, TArrayView<const float> MagFreq,
+															   TArray<FRichCurveKey>& OutKeys)
 		{
 			const float FreqResolution = ResidualSynth.GetFreqResolution();
 			float FinalFreqMag = 0;
@@ -658,14 +769,15 @@ namespace LBSImpactSFXSynth
 			if(FinalFreqMag > MaxDb)
 				MaxDb = FinalFreqMag;
 
+			OutKeys.Empty(MagFreqDb.Num());
 			float PreValue = 0;
 			for(int i = 0; i < MagFreqDb.Num(); i++)
 			{
 				const float Value = FMath::Max(-100.0f, MagFreqDb[i] - MaxDb);
 				if(i == 0 || Value != PreValue)
 				{
-					const FKeyHandle Handle = MagFreqCurve.CurveCustom.AddKey(FreqBins[i], Value, false);
-					MagFreqCurve.CurveCustom.GetKey(Handle).InterpMode = ERichCurveInterpMode::RCIM_Constant;
+					FRichCurveKey& Key = OutKeys.Emplace_GetRef(FreqBins[i], Value);
+					Key.InterpMode = ERichCurveInterpMode::RCIM_Constant;
 					PreValue = Value;
 				}
 			}
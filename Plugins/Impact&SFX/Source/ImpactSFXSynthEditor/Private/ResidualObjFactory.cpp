@@ -285,6 +285,7 @@ EReimportResult::Type UResidualObjFactory::Reimport(UObject* Obj)
 
 	ResidualObj->AssetImportData->Update(Filename);
 	ResidualObj->MarkPackageDirty();
+	ResidualObj->PostEditChange();
 
 	return EReimportResult::Succeeded;
 }
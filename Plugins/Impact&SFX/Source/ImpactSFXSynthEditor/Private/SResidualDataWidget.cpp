@@ -2,44 +2,146 @@
 
 
 #include "SResidualDataWidget.h"
+#include "CustomStatGroup.h"
 #include "Editor.h"
+#include "Engine/Texture2D.h"
+#include "Rendering/DrawElements.h"
+
+DECLARE_CYCLE_STAT(TEXT("ResidualDataWidget - Paint"), STAT_ResidualDataWidgetPaint, STATGROUP_ImpactSFXSynth);
+DECLARE_CYCLE_STAT(TEXT("ResidualDataWidget - Bake Spectrogram"), STAT_ResidualDataWidgetBake, STATGROUP_ImpactSFXSynth);
 
 void SResidualDataWidget::Construct(const FArguments& InArgs)
 {
 	ResidualData = InArgs._ResidualData;
 	
 	OnResidualDataChanged = InArgs._OnReisdualDataChanged;
-	
+
+	CachedSize = FIntPoint::ZeroValue;
+	CachedNumData = 0;
+	bIsSpectrogramDirty = true;
+
+	//Reimports and edits overwrite the data in place, so the size checks in OnPaint can't catch them
+	OnObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddSP(this, &SResidualDataWidget::OnObjectPropertyChanged);
+}
+
+SResidualDataWidget::~SResidualDataWidget()
+{
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(OnObjectPropertyChangedHandle);
+}
+
+void SResidualDataWidget::OnObjectPropertyChanged(UObject* InObject, FPropertyChangedEvent& InPropertyChangedEvent)
+{
+	if(InObject != nullptr && InObject == ResidualData.Get())
+	{
+		InvalidateSpectrogram();
+		OnResidualDataChanged.ExecuteIfBound(ResidualData.Get());
+	}
+}
+
+void SResidualDataWidget::InvalidateSpectrogram()
+{
+	bIsSpectrogramDirty = true;
+	Invalidate(EInvalidateWidgetReason::Paint);
 }
 
 int32 SResidualDataWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
 	const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId,
 	const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
 {
-	// const int32 NumPoints = 512;
-	// TArray<FVector2D> Points;
-	// Points.Reserve(NumPoints);
-	// const FTransform2D PointsTransform = GetPointsTransform(AllottedGeometry);
-	// for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
-	// {
-	// 	const float X = PointIndex / (NumPoints - 1.0);
-	// 	const float D = (X - Mean.Get()) / StandardDeviation.Get();
-	// 	const float Y = FMath::Exp(-0.5f * D * D);
-	// 	Points.Add(PointsTransform.TransformPoint(FVector2D(X, Y)));
-	// }
-	// FSlateDrawElement::MakeLines(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), Points);
+	SCOPE_CYCLE_COUNTER(STAT_ResidualDataWidgetPaint);
+	
+	const UResidualObj* ResidualObj = ResidualData.Get();
+	if(ResidualObj == nullptr || ResidualObj->GetNumFrame() <= 0 || ResidualObj->GetNumErb() <= 0)
+		return LayerId;
+
+	//No need to have more texels than pixels or than grid cells
+	const FVector2D PixelSize = AllottedGeometry.GetAbsoluteSize();
+	const FIntPoint Size(FMath::Clamp(FMath::CeilToInt32(PixelSize.X), 1, ResidualObj->GetNumFrame()),
+						 FMath::Clamp(FMath::CeilToInt32(PixelSize.Y), 1, ResidualObj->GetNumErb()));
+	
+	const int32 NumData = ResidualObj->GetDataView().Num();
+	if(bIsSpectrogramDirty || !SpectrogramTexture.IsValid() || CachedResidualObj.Get() != ResidualObj
+		|| CachedSize != Size || CachedNumData != NumData)
+	{
+		BakeSpectrogram(ResidualObj, Size);
+	}
+
+	if(SpectrogramTexture.IsValid())
+	{
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), &SpectrogramBrush,
+								   ESlateDrawEffect::None, InWidgetStyle.GetColorAndOpacityTint());
+	}
+	
 	return LayerId;
 }
 
+void SResidualDataWidget::BakeSpectrogram(const UResidualObj* InResidualObj, const FIntPoint& InSize) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ResidualDataWidgetBake);
+
+	CachedResidualObj = InResidualObj;
+	CachedSize = InSize;
+	CachedNumData = InResidualObj->GetDataView().Num();
+	bIsSpectrogramDirty = false;
+	
+	const int32 NumFrame = InResidualObj->GetNumFrame();
+	const int32 NumErb = InResidualObj->GetNumErb();
+	TArrayView<const float> Data = InResidualObj->GetDataView();
+	if(Data.Num() < NumFrame * NumErb)
+	{
+		SpectrogramTexture.Reset();
+		return;
+	}
+
+	//Decimate by taking the max of all cells covered by each texel so short transients are still visible
+	TArray<float> Decimated;
+	Decimated.SetNumZeroed(InSize.X * InSize.Y);
+	float MaxValue = UE_SMALL_NUMBER;
+	for(int32 Frame = 0; Frame < NumFrame; Frame++)
+	{
+		const int32 X = Frame * InSize.X / NumFrame;
+		const float* FrameData = &Data[Frame * NumErb];
+		for(int32 Erb = 0; Erb < NumErb; Erb++)
+		{
+			const int32 Y = InSize.Y - 1 - Erb * InSize.Y / NumErb; //Low bands at the bottom
+			float& Value = Decimated[Y * InSize.X + X];
+			Value = FMath::Max(Value, FrameData[Erb]);
+			MaxValue = FMath::Max(MaxValue, FrameData[Erb]);
+		}
+	}
+	
+	if(!SpectrogramTexture.IsValid() || SpectrogramTexture->GetSizeX() != InSize.X || SpectrogramTexture->GetSizeY() != InSize.Y)
+	{
+		UTexture2D* NewTexture = UTexture2D::CreateTransient(InSize.X, InSize.Y, PF_B8G8R8A8);
+		if(NewTexture == nullptr)
+		{
+			SpectrogramTexture.Reset();
+			return;
+		}
+		NewTexture->SRGB = false;
+		NewTexture->Filter = TF_Nearest;
+		SpectrogramTexture.Reset(NewTexture);
+	}
+
+	UTexture2D* Texture = SpectrogramTexture.Get();
+	FTexture2DMipMap& Mip = Texture->GetPlatformData()->Mips[0];
+	FColor* Pixels = static_cast<FColor*>(Mip.BulkData.Lock(LOCK_READ_WRITE));
+	const float InvMaxValue = 1.f / MaxValue;
+	for(int32 i = 0; i < Decimated.Num(); i++)
+	{
+		const float Db = 20.f * FMath::LogX(10.f, FMath::Max(Decimated[i] * InvMaxValue, UE_SMALL_NUMBER));
+		const float Alpha = FMath::Clamp(1.f - Db / MinDb, 0.f, 1.f);
+		Pixels[i] = FLinearColor::LerpUsingHSV(FLinearColor::Black, FLinearColor(1.f, 0.8f, 0.f), Alpha).ToFColor(false);
+	}
+	Mip.BulkData.Unlock();
+	Texture->UpdateResource();
+
+	SpectrogramBrush.SetResourceObject(Texture);
+	SpectrogramBrush.ImageSize = FVector2D(InSize.X, InSize.Y);
+	SpectrogramBrush.DrawAs = ESlateBrushDrawType::Image;
+}
+
 FVector2D SResidualDataWidget::ComputeDesiredSize(float) const
 {
 	return FVector2D(200.0, 200.0);
 }
-
-// FTransform2D SResidualDataWidget::GetPointsTransform(const FGeometry& AllottedGeometry) const
-// {
-// 	const double Margin = 0.05 * AllottedGeometry.GetLocalSize().GetMin();
-// 	const FScale2D Scale((AllottedGeometry.GetLocalSize() - 2.0 * Margin) * FVector2D(1.0, -1.0));
-// 	const FVector2D Translation(Margin, AllottedGeometry.GetLocalSize().Y - Margin);
-// 	return FTransform2D(Scale, Translation);
-// }
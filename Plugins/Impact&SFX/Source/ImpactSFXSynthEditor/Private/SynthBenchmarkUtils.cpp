@@ -0,0 +1,718 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "SynthBenchmarkUtils.h"
+
+#include "ChirpSynth.h"
+#include "HRTFModal.h"
+#include "ModalReverb.h"
+#include "ModalSynth.h"
+#include "MultiDelayReverbMix.h"
+#include "MultiImpactSynth.h"
+#include "ResidualAnalyzer.h"
+#include "ResidualObj.h"
+#include "ResidualSynth.h"
+#include "ScratchingSynth.h"
+#include "HAL/PlatformTLS.h"
+#include "HarmonixMidi/MidiConstants.h"
+#include "HarmonixMidi/MidiVoiceId.h"
+#include "Liquid/BurbleSoundGen.h"
+#include "Math/RandomStream.h"
+#include "Piano/PianoSynth.h"
+#include "UObject/Package.h"
+#include "VehicleSFX/VehicleEngineEulerSynth.h"
+#include "VehicleSFX/VehicleEngineSynth.h"
+
+#include <atomic>
+
+namespace LBSImpactSFXSynth
+{
+	namespace Benchmark
+	{
+		static constexpr int32 DefaultNumModals = 256;
+		static constexpr int32 DefaultMaxNumImpacts = 16;
+		static constexpr float DefaultResidualSeconds = 2.f;
+
+		namespace
+		{
+			class FAllocationCountingMalloc final : public FMalloc
+			{
+			public:
+				void Install(FMalloc* InInnerMalloc)
+				{
+					InnerMalloc = InInnerMalloc;
+					OwnerThreadId = FPlatformTLS::GetCurrentThreadId();
+					NumAllocations = 0;
+					bIsCounting = true;
+				}
+
+				virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+				{
+					CountIfOwner();
+					return InnerMalloc->Malloc(Count, Alignment);
+				}
+
+				virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+				{
+					CountIfOwner();
+					return InnerMalloc->TryMalloc(Count, Alignment);
+				}
+
+				virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+				{
+					//Realloc to zero is a free
+					if(Count > 0)
+						CountIfOwner();
+					return InnerMalloc->Realloc(Original, Count, Alignment);
+				}
+
+				virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+				{
+					if(Count > 0)
+						CountIfOwner();
+					return InnerMalloc->TryRealloc(Original, Count, Alignment);
+				}
+
+				virtual void Free(void* Original) override { InnerMalloc->Free(Original); }
+				virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return InnerMalloc->QuantizeSize(Count, Alignment); }
+				virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return InnerMalloc->GetAllocationSize(Original, SizeOut); }
+				virtual void Trim(bool bTrimThreadCaches) override { InnerMalloc->Trim(bTrimThreadCaches); }
+				virtual void SetupTLSCachesOnCurrentThread() override { InnerMalloc->SetupTLSCachesOnCurrentThread(); }
+				virtual void ClearAndDisableTLSCachesOnCurrentThread() override { InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+				virtual bool IsInternallyThreadSafe() const override { return InnerMalloc->IsInternallyThreadSafe(); }
+				virtual bool ValidateHeap() override { return InnerMalloc->ValidateHeap(); }
+				virtual const TCHAR* GetDescriptorName() const override { return TEXT("ImpactSFXAllocationCounter"); }
+
+				FMalloc* InnerMalloc = nullptr;
+				uint32 OwnerThreadId = 0;
+				std::atomic<int32> NumAllocations = 0;
+				std::atomic<bool> bIsCounting = false;
+				std::atomic<bool> bIsInstalled = false;
+
+			private:
+				FORCEINLINE void CountIfOwner()
+				{
+					if(bIsCounting.load(std::memory_order_relaxed) && FPlatformTLS::GetCurrentThreadId() == OwnerThreadId)
+						NumAllocations.fetch_add(1, std::memory_order_relaxed);
+				}
+			};
+
+			//Never destroyed as other threads can still hold a pointer to it after the scope ends
+			FAllocationCountingMalloc& GetCountingMalloc()
+			{
+				static FAllocationCountingMalloc* CountingMalloc = new FAllocationCountingMalloc();
+				return *CountingMalloc;
+			}
+		}
+
+		FScopedAllocationCounter::FScopedAllocationCounter()
+			: PreviousMalloc(GMalloc)
+		{
+			FAllocationCountingMalloc& CountingMalloc = GetCountingMalloc();
+			check(!CountingMalloc.bIsInstalled);
+			CountingMalloc.Install(PreviousMalloc);
+			CountingMalloc.bIsInstalled = true;
+			GMalloc = &CountingMalloc;
+		}
+
+		FScopedAllocationCounter::~FScopedAllocationCounter()
+		{
+			FAllocationCountingMalloc& CountingMalloc = GetCountingMalloc();
+			CountingMalloc.bIsCounting = false;
+			GMalloc = PreviousMalloc;
+			CountingMalloc.bIsInstalled = false;
+		}
+
+		int32 FScopedAllocationCounter::GetNumAllocations() const
+		{
+			return GetCountingMalloc().NumAllocations.load();
+		}
+
+		void FScopedAllocationCounter::Reset()
+		{
+			GetCountingMalloc().NumAllocations = 0;
+		}
+
+		void FScopedAllocationCounter::Pause()
+		{
+			GetCountingMalloc().bIsCounting = false;
+		}
+
+		void FScopedAllocationCounter::Resume()
+		{
+			GetCountingMalloc().bIsCounting = true;
+		}
+
+		TArray<float> MakeModalParams(const int32 NumModals, const int32 Seed)
+		{
+			FRandomStream RandomStream(Seed);
+			TArray<float> Params;
+			Params.SetNumUninitialized(NumModals * 3);
+			for(int32 i = 0; i < NumModals; i++)
+			{
+				//Louder modals first, as the analyzer sorts them
+				const float Priority = 1.f - static_cast<float>(i) / FMath::Max(1, NumModals);
+				Params[i * 3] = RandomStream.FRandRange(0.05f, 0.2f) * Priority;
+				Params[i * 3 + 1] = RandomStream.FRandRange(5.f, 60.f);
+				Params[i * 3 + 2] = FMath::Exp(RandomStream.FRandRange(FMath::Loge(60.f), FMath::Loge(16000.f)));
+			}
+			return Params;
+		}
+
+		UImpactModalObj* CreateTransientModalObj(const int32 NumModals, const int32 Seed)
+		{
+			UImpactModalObj* ModalObj = NewObject<UImpactModalObj>(GetTransientPackage());
+			ModalObj->Params = MakeModalParams(NumModals, Seed);
+			ModalObj->NumModals = NumModals;
+			return ModalObj;
+		}
+
+		UResidualObj* CreateTransientResidualObj(const int32 NumFrame, const float SamplingRate, const int32 Seed)
+		{
+			constexpr int32 NumErb = FResidualAnalyzer::NumErb;
+			FRandomStream RandomStream(Seed);
+
+			UResidualObj* ResidualObj = NewObject<UResidualObj>(GetTransientPackage());
+			ResidualObj->Data.SetNumUninitialized(NumFrame * NumErb);
+			for(int32 Frame = 0; Frame < NumFrame; Frame++)
+			{
+				const float Envelope = FMath::Exp(-4.f * Frame / NumFrame);
+				for(int32 Erb = 0; Erb < NumErb; Erb++)
+					ResidualObj->Data[Frame * NumErb + Erb] = Envelope * RandomStream.FRandRange(0.1f, 1.f);
+			}
+
+			ResidualObj->SetProperties(1, FResidualAnalyzer::NumFFTAnalyze, FResidualAnalyzer::HopSizeAnalyze, NumErb, NumFrame, SamplingRate,
+									   UResidualData::Freq2Erb(FResidualAnalyzer::FreqMax), UResidualData::Freq2Erb(FResidualAnalyzer::FreqMin));
+			return ResidualObj;
+		}
+
+		UResidualData* CreateTransientResidualData(UResidualObj* InResidualObj)
+		{
+			UResidualData* ResidualData = NewObject<UResidualData>(GetTransientPackage());
+			ResidualData->SetResidualObj(InResidualObj);
+			return ResidualData;
+		}
+
+		UMultiImpactData* CreateTransientMultiImpactData(UImpactModalObj* InModalObj, UResidualData* InResidualData)
+		{
+			UMultiImpactData* MultiImpactData = NewObject<UMultiImpactData>(GetTransientPackage());
+
+			//These are only editable through the details panel, so set them through reflection
+			if(const FObjectPropertyBase* ModalObjProperty = FindFProperty<FObjectPropertyBase>(UMultiImpactData::StaticClass(), TEXT("ModalObj")))
+				ModalObjProperty->SetObjectPropertyValue_InContainer(MultiImpactData, InModalObj);
+			if(const FObjectPropertyBase* ResidualDataProperty = FindFProperty<FObjectPropertyBase>(UMultiImpactData::StaticClass(), TEXT("ResidualData")))
+				ResidualDataProperty->SetObjectPropertyValue_InContainer(MultiImpactData, InResidualData);
+
+			return MultiImpactData;
+		}
+
+		/** One second of input which starts with a short noise burst, padded to whole blocks. */
+		static void MakeBurstInput(const float SamplingRate, const int32 BlockSize, const int32 Seed, FAlignedFloatBuffer& OutInput)
+		{
+			const int32 NumBlocks = FMath::CeilToInt32(SamplingRate / BlockSize);
+			OutInput.SetNumZeroed(NumBlocks * BlockSize);
+
+			FRandomStream RandomStream(Seed);
+			const int32 NumBurstFrames = FMath::Min(OutInput.Num(), FMath::CeilToInt32(0.02f * SamplingRate));
+			for(int32 i = 0; i < NumBurstFrames; i++)
+				OutInput[i] = RandomStream.FRandRange(-0.5f, 0.5f);
+		}
+
+		class FModalSynthRunner final : public FSynthRunner
+		{
+		public:
+			FModalSynthRunner(const FImpactModalObjAssetProxyPtr& InModalProxy, const float SamplingRate)
+				: ModalProxy(InModalProxy)
+				, ModalSynth(SamplingRate, InModalProxy)
+				, bIsFinished(false)
+			{
+				OutViews.SetNum(1);
+			}
+
+			virtual int32 Render(TArrayView<float> OutAudio) override
+			{
+				OutViews[0] = OutAudio;
+				bIsFinished = ModalSynth.Synthesize(OutViews, ModalProxy);
+				return 1;
+			}
+
+			virtual void Prepare() override
+			{
+				if(!bIsFinished)
+					return;
+
+				ModalSynth.ResetAllStates(ModalProxy, 0.f, -1.f, 1.f, 1.f, 1.f, 1.f, 0.5f, false, 0.f);
+				bIsFinished = false;
+			}
+
+		private:
+			FImpactModalObjAssetProxyPtr ModalProxy;
+			FModalSynth ModalSynth;
+			FMultichannelBufferView OutViews;
+			bool bIsFinished;
+		};
+
+		class FResidualSynthRunner final : public FSynthRunner
+		{
+		public:
+			FResidualSynthRunner(const FResidualDataAssetProxyPtr& InResidualProxy, const float SamplingRate, const int32 BlockSize, const int32 Seed)
+				: ResidualSynth(SamplingRate, BlockSize, 1, InResidualProxy.ToSharedRef(), 1.f, 1.f, 1.f, Seed, 0.f, -1.f, true)
+			{
+				OutViews.SetNum(1);
+			}
+
+			virtual int32 Render(TArrayView<float> OutAudio) override
+			{
+				OutViews[0] = OutAudio;
+				ResidualSynth.Synthesize(OutViews);
+				return 1;
+			}
+
+		private:
+			FResidualSynth ResidualSynth;
+			FMultichannelBufferView OutViews;
+		};
+
+		class FMultiImpactSynthRunner final : public FSynthRunner
+		{
+		public:
+			FMultiImpactSynthRunner(const FMultiImpactDataAssetProxyPtr& InMultiImpactProxy, const float SamplingRate, const int32 BlockSize, const int32 Seed)
+				: MultiImpactSynth(InMultiImpactProxy.ToSharedRef(), DefaultMaxNumImpacts, SamplingRate, BlockSize, 1, false, Seed)
+				, SpawnParams(4, 20.f, 1, 1.f, 0.f, -1.f, 0.01f, 0.5f, 0.5f, 0.f)
+				, bIsFinished(false)
+			{
+				OutViews.SetNum(1);
+			}
+
+			virtual int32 Render(TArrayView<float> OutAudio) override
+			{
+				OutViews[0] = OutAudio;
+				bIsFinished = MultiImpactSynth.Synthesize(OutViews, SpawnParams, 1.f, 1.f, 0.f, 0.f);
+				return MultiImpactSynth.GetBlockCounters().NumActiveVoices;
+			}
+
+			virtual void Prepare() override
+			{
+				if(!bIsFinished)
+					return;
+
+				MultiImpactSynth.Restart();
+				bIsFinished = false;
+			}
+
+		private:
+			FMultiImpactSynth MultiImpactSynth;
+			FMultiImpactSpawnParams SpawnParams;
+			FMultichannelBufferView OutViews;
+			bool bIsFinished;
+		};
+
+		class FModalReverbRunner final : public FSynthRunner
+		{
+		public:
+			FModalReverbRunner(const float SamplingRate, const int32 BlockSize, const int32 Seed)
+				: ModalReverb(SamplingRate, FModalReverbParams(), 32, 128, 96, FModalReverb::DefaultAbsorption, 1.f, 1.f, 1.f)
+				, InputPos(0)
+			{
+				MakeBurstInput(SamplingRate, BlockSize, Seed, Input);
+			}
+
+			virtual int32 Render(TArrayView<float> OutAudio) override
+			{
+				const TArrayView<const float> InAudio = TArrayView<const float>(Input).Slice(InputPos, OutAudio.Num());
+				ModalReverb.CreateReverb(OutAudio, InAudio, FModalReverb::DefaultAbsorption, 1.f, 1.f, 1.f, false);
+				InputPos = (InputPos + OutAudio.Num()) % Input.Num();
+				return 1;
+			}
+
+		private:
+			FModalReverb ModalReverb;
+			FAlignedFloatBuffer Input;
+			int32 InputPos;
+		};
+
+		/** Default delays and feedback gain of the TapDelayFF node. */
+		class FMultiDelayReverbMixRunner final : public FSynthRunner
+		{
+		public:
+			FMultiDelayReverbMixRunner(const float SamplingRate, const int32 BlockSize, const int32 Seed)
+				: DelayMix(SamplingRate, 0.5f, 0.1f, 0.2f)
+				, InputPos(0)
+			{
+				MakeBurstInput(SamplingRate, BlockSize, Seed, Input);
+			}
+
+			virtual int32 Render(TArrayView<float> OutAudio) override
+			{
+				const TArrayView<const float> InAudio = TArrayView<const float>(Input).Slice(InputPos, OutAudio.Num());
+				DelayMix.ProcessAudio(OutAudio, InAudio, 0.5f);
+				InputPos = (InputPos + OutAudio.Num()) % Input.Num();
+				return 1;
+			}
+
+		private:
+			FMultiDelayReverbMix DelayMix;
+			FAlignedFloatBuffer Input;
+			int32 InputPos;
+		};
+
+		class FHRTFModalRunner final : public FSynthRunner
+		{
+		public:
+			FHRTFModalRunner(const float SamplingRate, const int32 BlockSize, const int32 Seed)
+				: HRTFModal(SamplingRate, BlockSize)
+				, InputPos(0)
+				, Azimuth(0.f)
+				//Half a turn per second
+				, AzimuthStep(180.f * BlockSize / SamplingRate)
+			{
+				MakeBurstInput(SamplingRate, BlockSize, Seed, Input);
+				RightBuffer.SetNumZeroed(BlockSize);
+				StereoViews.SetNum(2);
+			}
+
+			virtual int32 Render(TArrayView<float> OutAudio) override
+			{
+				const TArrayView<const float> InAudio = TArrayView<const float>(Input).Slice(InputPos, OutAudio.Num());
+				StereoViews[0] = OutAudio;
+				StereoViews[1] = TArrayView<float>(RightBuffer).Slice(0, OutAudio.Num());
+				HRTFModal.TransferToStereo(InAudio, Azimuth, 0.f, 1.f, StereoViews, false);
+				InputPos = (InputPos + OutAudio.Num()) % Input.Num();
+				return 1;
+			}
+
+			virtual void Prepare() override
+			{
+				Azimuth += AzimuthStep;
+				if(Azimuth > 180.f)
+					Azimuth -= 360.f;
+			}
+
+		private:
+			FHRTFModal HRTFModal;
+			FAlignedFloatBuffer Input;
+			FAlignedFloatBuffer RightBuffer;
+			FMultichannelBufferView StereoViews;
+			int32 InputPos;
+			float Azimuth;
+			float AzimuthStep;
+		};
+
+		class FBurbleSoundGenRunner final : public FSynthRunner
+		{
+		public:
+			//Default inputs of the burble node
+			FBurbleSoundGenRunner(const float SamplingRate, const int32 Seed)
+				: BurbleSoundGen(SamplingRate, Seed, 1024)
+				, SpawnParams(1000.f, 0.9f, 1.f, 0.15e-3f, 150e-3f, 0.f, 0.f, 0.7634f, 1.f, 0.f, 10.f, 0.2f, 0.1f, 1.f, 1000.f)
+			{
+			}
+
+			virtual int32 Render(TArrayView<float> OutAudio) override
+			{
+				BurbleSoundGen.Generate(OutAudio, SpawnParams);
+				return BurbleSoundGen.GetCurrentNumBurbles();
+			}
+
+		private:
+			FBurbleSoundGen BurbleSoundGen;
+			FBurbleSoundSpawnParams SpawnParams;
+		};
+
+		/** Keep the impact ring of the scratching synth full. Modulated runs sweep the excite pitch every block like a pitch LFO. */
+		class FScratchingSynthRunner final : public FSynthRunner
+		{
+		public:
+			FScratchingSynthRunner(const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize, const bool bInIsModulated)
+				: ModalProxy(Assets.ModalProxy)
+				, ScratchingSynth(SamplingRate, BlockSize, 1, Assets.Seed, Assets.ResidualProxy, 1.f)
+				, SpawnParams(200.f, 1.f, 0.f, -1.f, 0.5f, 0.5f, 0.f, 0, 2, 1.f)
+				, bIsModulated(bInIsModulated)
+				, Phase(0.f)
+				, PhaseStep(UE_TWO_PI * 2.f * BlockSize / SamplingRate)
+			{
+				ResonMods.FreqScale = 0.5f;
+				OutViews.SetNum(1);
+			}
+
+			virtual int32 Render(TArrayView<float> OutAudio) override
+			{
+				OutViews[0] = OutAudio;
+				ScratchingSynth.Synthesize(SpawnParams, ModalProxy, ExciteMods, ModalProxy, ResonMods, OutViews, true);
+				return ScratchingSynth.GetNumActiveImpacts();
+			}
+
+			virtual void Prepare() override
+			{
+				if(!bIsModulated)
+					return;
+
+				Phase = FMath::Fmod(Phase + PhaseStep, UE_TWO_PI);
+				ExciteMods.FreqScale = 1.f + 0.1f * FMath::Sin(Phase);
+			}
+
+		private:
+			FImpactModalObjAssetProxyPtr ModalProxy;
+			FScratchingSynth ScratchingSynth;
+			FScratchImpactSpawnParams SpawnParams;
+			FModalMods ExciteMods;
+			FModalMods ResonMods;
+			FMultichannelBufferView OutViews;
+			bool bIsModulated;
+			float Phase;
+			float PhaseStep;
+		};
+
+		/** Restart the chirp synth each time all of its modals have decayed. */
+		template<typename TChirpSynth>
+		class TChirpSynthRunner final : public FSynthRunner
+		{
+		public:
+			static constexpr int32 NumUsedModals = 32;
+
+			TChirpSynthRunner(const FImpactModalObjAssetProxyPtr& InModalProxy, const float InSamplingRate, const int32 InBlockSize,
+							  const FChirpSynthParams& InParams)
+				: ModalProxy(InModalProxy)
+				, Params(InParams)
+				, SamplingRate(InSamplingRate)
+				, BlockSize(InBlockSize)
+				, bIsFinished(true)
+			{
+				OutViews.SetNum(1);
+				Prepare();
+			}
+
+			virtual int32 Render(TArrayView<float> OutAudio) override
+			{
+				OutViews[0] = OutAudio;
+				bIsFinished = ChirpSynth->Synthesize(OutViews, ModalProxy->GetParams(), Params, false);
+				return 1;
+			}
+
+			virtual void Prepare() override
+			{
+				if(!bIsFinished)
+					return;
+
+				ChirpSynth = MakeUnique<TChirpSynth>(SamplingRate, BlockSize, ModalProxy->GetParams(), Params, NumUsedModals);
+				bIsFinished = false;
+			}
+
+		private:
+			FImpactModalObjAssetProxyPtr ModalProxy;
+			TUniquePtr<FChirpSynth> ChirpSynth;
+			FChirpSynthParams Params;
+			FMultichannelBufferView OutViews;
+			float SamplingRate;
+			int32 BlockSize;
+			bool bIsFinished;
+		};
+
+		/** Sweep the RPM between idle and redline every four seconds. */
+		template<typename TVehicleSynth>
+		class TVehicleEngineRunner final : public FSynthRunner
+		{
+		public:
+			template<typename... ArgsType>
+			TVehicleEngineRunner(const FImpactModalObjAssetProxyPtr& InModalProxy, const float SamplingRate, const int32 BlockSize, ArgsType&&... Args)
+				: ModalProxy(InModalProxy)
+				, VehicleSynth(SamplingRate, Forward<ArgsType>(Args)...)
+				, Phase(0.f)
+				, PhaseStep(UE_TWO_PI * BlockSize / (4.f * SamplingRate))
+			{
+				OutViews.SetNum(1);
+			}
+
+			virtual int32 Render(TArrayView<float> OutAudio) override
+			{
+				OutViews[0] = OutAudio;
+				VehicleSynth.Generate(OutViews, Params, ModalProxy);
+				return 1;
+			}
+
+			virtual void Prepare() override
+			{
+				Phase = FMath::Fmod(Phase + PhaseStep, UE_TWO_PI);
+				Params.RPM = 800.f + 2500.f * (1.f - FMath::Cos(Phase));
+				Params.ThrottleInput = Phase < UE_PI ? 1.f : 0.f;
+			}
+
+		private:
+			FImpactModalObjAssetProxyPtr ModalProxy;
+			TVehicleSynth VehicleSynth;
+			FVehicleEngineParams Params;
+			FMultichannelBufferView OutViews;
+			float Phase;
+			float PhaseStep;
+		};
+
+		/** Strike a new triad every quarter of a second and release the previous one. */
+		class FPianoSynthRunner final : public FSynthRunner
+		{
+		public:
+			static constexpr int32 NumNotesPerChord = 3;
+
+			FPianoSynthRunner(const FPianoModelAssetProxyPtr& InPianoProxy, const float SamplingRate, const int32 BlockSize, const int32 Seed)
+				: PianoSynth(InPianoProxy, SamplingRate, 1.f, 1)
+				, SynthParams(1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, false, LBSVirtualInstrument::EPedalState::NoChange)
+				, RandomStream(Seed)
+				, BlockTimeMs(1000.f * BlockSize / SamplingRate)
+				, CurrentTimeMs(0.f)
+				, NextChordTimeMs(0.f)
+			{
+				NotesOn.Reserve(NumNotesPerChord);
+				NotesOff.Reserve(NumNotesPerChord);
+				HeldNotes.Reserve(NumNotesPerChord);
+			}
+
+			virtual int32 Render(TArrayView<float> OutAudio) override
+			{
+				PianoSynth.Synthesize(OutAudio, NotesOn, NotesOff, SynthParams, CurrentTimeMs);
+				return HeldNotes.Num();
+			}
+
+			virtual void Prepare() override
+			{
+				CurrentTimeMs += BlockTimeMs;
+				NotesOn.Reset();
+				NotesOff.Reset();
+				if(CurrentTimeMs < NextChordTimeMs)
+					return;
+
+				NextChordTimeMs = CurrentTimeMs + 250.f;
+				NotesOff.Append(HeldNotes);
+				HeldNotes.Reset();
+
+				const uint8 RootNote = static_cast<uint8>(RandomStream.RandRange(36, 84));
+				constexpr uint8 Intervals[NumNotesPerChord] = { 0, 4, 7 };
+				for(const uint8 Interval : Intervals)
+				{
+					const uint8 MidiNote = RootNote + Interval;
+					const uint8 Velocity = static_cast<uint8>(RandomStream.RandRange(40, 120));
+					const FMidiVoiceId VoiceId = VoiceGenerator.GetVoiceId(Harmonix::Midi::Constants::GNoteOn, MidiNote);
+					NotesOn.Add(VoiceId, LBSVirtualInstrument::FMidiNoteAction(MidiNote, Velocity, 0, 0, 0.f, 0, VoiceId));
+					HeldNotes.Add(VoiceId);
+				}
+			}
+
+		private:
+			LBSVirtualInstrument::FPianoSynth PianoSynth;
+			LBSVirtualInstrument::FPianoSynthParams SynthParams;
+			FMidiVoiceGeneratorBase VoiceGenerator;
+			TMap<FMidiVoiceId, LBSVirtualInstrument::FMidiNoteAction> NotesOn;
+			TArray<FMidiVoiceId> NotesOff;
+			TArray<FMidiVoiceId> HeldNotes;
+			FRandomStream RandomStream;
+			float BlockTimeMs;
+			float CurrentTimeMs;
+			float NextChordTimeMs;
+		};
+
+		TArray<FBenchmarkCase> GetBenchmarkCases()
+		{
+			TArray<FBenchmarkCase> Cases;
+			Cases.Add({ TEXT("ModalSynth"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<FModalSynthRunner>(Assets.ModalProxy, SamplingRate);
+			}});
+			Cases.Add({ TEXT("ResidualSynth"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<FResidualSynthRunner>(Assets.ResidualProxy, SamplingRate, BlockSize, Assets.Seed);
+			}});
+			Cases.Add({ TEXT("MultiImpactSynth"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<FMultiImpactSynthRunner>(Assets.MultiImpactProxy, SamplingRate, BlockSize, Assets.Seed);
+			}});
+			Cases.Add({ TEXT("ModalReverb"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<FModalReverbRunner>(SamplingRate, BlockSize, Assets.Seed);
+			}});
+			Cases.Add({ TEXT("MultiDelayReverbMix"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<FMultiDelayReverbMixRunner>(SamplingRate, BlockSize, Assets.Seed);
+			}});
+			Cases.Add({ TEXT("HRTFModal"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<FHRTFModalRunner>(SamplingRate, BlockSize, Assets.Seed);
+			}});
+			Cases.Add({ TEXT("BurbleSoundGen"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<FBurbleSoundGenRunner>(SamplingRate, Assets.Seed);
+			}});
+			Cases.Add({ TEXT("ScratchingSynth8Impacts"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<FScratchingSynthRunner>(Assets, SamplingRate, BlockSize, false);
+			}});
+			Cases.Add({ TEXT("ScratchingSynth8ImpactsModulated"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<FScratchingSynthRunner>(Assets, SamplingRate, BlockSize, true);
+			}});
+			Cases.Add({ TEXT("ChirpSynthLinear"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<TChirpSynthRunner<FChirpSynth>>(Assets.ModalProxy, SamplingRate, BlockSize,
+																  FChirpSynthParams(2.f, 200.f, 1.f, 1.f, 1.f, 0.f, 0.f, 0.f));
+			}});
+			Cases.Add({ TEXT("ChirpSynthSigmoid"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<TChirpSynthRunner<FSigmoidChirpSynth>>(Assets.ModalProxy, SamplingRate, BlockSize,
+																		 FChirpSynthParams(0.5f, 1.f, 1.f, 1.f, 1.f, 0.f, 0.f, 0.f));
+			}});
+			Cases.Add({ TEXT("ChirpSynthExponent"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<TChirpSynthRunner<FExponentChirpSynth>>(Assets.ModalProxy, SamplingRate, BlockSize,
+																		  FChirpSynthParams(0.5f, 1.f, 1.f, 1.f, 1.f, 0.f, 0.f, 0.f));
+			}});
+			Cases.Add({ TEXT("VehicleEngineSynth"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<TVehicleEngineRunner<FVehicleEngineSynth>>(Assets.ModalProxy, SamplingRate, BlockSize,
+																			 4, Assets.ModalProxy, 32, 1.f, 1.f, Assets.Seed);
+			}});
+			Cases.Add({ TEXT("VehicleEngineEulerSynth"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				return MakeUnique<TVehicleEngineRunner<FVehicleEngineEulerSynth>>(Assets.ModalProxy, SamplingRate, BlockSize,
+																				  4, Assets.ModalProxy, 32, 8, 1.f, Assets.Seed);
+			}});
+			Cases.Add({ TEXT("PianoSynth"), [](const FBenchmarkAssets& Assets, const float SamplingRate, const int32 BlockSize) -> TUniquePtr<FSynthRunner>
+			{
+				if(!Assets.PianoProxy.IsValid())
+					return nullptr;
+				return MakeUnique<FPianoSynthRunner>(Assets.PianoProxy, SamplingRate, BlockSize, Assets.Seed);
+			}});
+			return Cases;
+		}
+
+		void CreateBenchmarkAssets(const int32 Seed, UImpactModalObj* ModalObj, UResidualData* ResidualData, UMultiImpactData* MultiImpactData,
+								   FBenchmarkAssets& OutAssets)
+		{
+			OutAssets.Seed = Seed;
+			if(ModalObj == nullptr)
+			{
+				ModalObj = CreateTransientModalObj(DefaultNumModals, Seed);
+				OutAssets.TransientObjects.Emplace(ModalObj);
+			}
+			if(ResidualData == nullptr)
+			{
+				constexpr float ResidualSamplingRate = 48000.f;
+				const int32 NumFrame = FMath::CeilToInt32(DefaultResidualSeconds * ResidualSamplingRate / FResidualAnalyzer::HopSizeAnalyze);
+				UResidualObj* ResidualObj = CreateTransientResidualObj(NumFrame, ResidualSamplingRate, Seed);
+				OutAssets.TransientObjects.Emplace(ResidualObj);
+				ResidualData = CreateTransientResidualData(ResidualObj);
+				OutAssets.TransientObjects.Emplace(ResidualData);
+			}
+
+			OutAssets.ModalProxy = ModalObj->CreateNewImpactModalObjProxyData();
+			OutAssets.ResidualProxy = ResidualData->CreateNewResidualProxyData();
+
+			if(MultiImpactData)
+			{
+				OutAssets.MultiImpactProxy = MultiImpactData->CreateNewMultiImpactProxyData();
+				return;
+			}
+
+			MultiImpactData = CreateTransientMultiImpactData(ModalObj, ResidualData);
+			OutAssets.TransientObjects.Emplace(MultiImpactData);
+			OutAssets.SpawnInfos.Reset(1);
+			OutAssets.SpawnInfos.AddDefaulted();
+			OutAssets.MultiImpactProxy = MakeShared<FMultiImpactDataAssetProxy, ESPMode::ThreadSafe>(MultiImpactData, OutAssets.SpawnInfos);
+		}
+	}
+}
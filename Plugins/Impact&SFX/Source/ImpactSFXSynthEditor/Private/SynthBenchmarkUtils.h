@@ -0,0 +1,96 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ImpactModalObj.h"
+#include "MultiImpactData.h"
+#include "ResidualData.h"
+#include "Piano/PianoModel.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace LBSImpactSFXSynth
+{
+	namespace Benchmark
+	{
+		/**
+		 * Count heap allocations made by the constructing thread while this object is alive.
+		 * GMalloc is wrapped for the lifetime of the scope. Allocations of other threads are forwarded without being counted.
+		 * Scopes can't be nested.
+		 */
+		class FScopedAllocationCounter
+		{
+		public:
+			FScopedAllocationCounter();
+			~FScopedAllocationCounter();
+
+			FScopedAllocationCounter(const FScopedAllocationCounter&) = delete;
+			FScopedAllocationCounter& operator=(const FScopedAllocationCounter&) = delete;
+
+			/** Number of Malloc and non-zero Realloc calls since construction or the last Reset. */
+			int32 GetNumAllocations() const;
+			void Reset();
+
+			/** Stop counting without uninstalling the wrapper. Used to exclude setup work between measured blocks. */
+			void Pause();
+			void Resume();
+
+		private:
+			FMalloc* PreviousMalloc;
+		};
+
+		/** Amp, decay, freq triplets of NumModals random modals. Same seed, same modals. */
+		TArray<float> MakeModalParams(int32 NumModals, int32 Seed);
+
+		UImpactModalObj* CreateTransientModalObj(int32 NumModals, int32 Seed);
+
+		/** A residual object with the analysis settings of FResidualAnalyzer and a random decaying ERB magnitude grid. */
+		UResidualObj* CreateTransientResidualObj(int32 NumFrame, float SamplingRate, int32 Seed);
+		UResidualData* CreateTransientResidualData(UResidualObj* InResidualObj);
+
+		/** Multi impact data which uses both the given modal object and residual data. */
+		UMultiImpactData* CreateTransientMultiImpactData(UImpactModalObj* InModalObj, UResidualData* InResidualData);
+
+		struct FBenchmarkAssets
+		{
+			FImpactModalObjAssetProxyPtr ModalProxy;
+			FResidualDataAssetProxyPtr ResidualProxy;
+			FMultiImpactDataAssetProxyPtr MultiImpactProxy;
+			FPianoModelAssetProxyPtr PianoProxy;
+			int32 Seed = 0;
+
+			/** Keep generated objects alive while their proxies are used. */
+			TArray<TStrongObjectPtr<UObject>> TransientObjects;
+			/** Multi impact proxies only keep a view of their spawn infos. */
+			TArray<FImpactSpawnInfo> SpawnInfos;
+		};
+
+		/** Build proxies of the given assets. Null assets are replaced by transient ones generated from the seed. */
+		void CreateBenchmarkAssets(int32 Seed, UImpactModalObj* ModalObj, UResidualData* ResidualData, UMultiImpactData* MultiImpactData,
+								   FBenchmarkAssets& OutAssets);
+
+		/** Drive one synthesizer block by block. */
+		class FSynthRunner
+		{
+		public:
+			virtual ~FSynthRunner() = default;
+
+			/** Render one block. Returns the number of voices which were active in this block. */
+			virtual int32 Render(TArrayView<float> OutAudio) = 0;
+
+			/** Setup work between blocks like retriggering. Not measured. */
+			virtual void Prepare() {}
+		};
+
+		using FRunnerFactory = TFunction<TUniquePtr<FSynthRunner>(const FBenchmarkAssets& Assets, float SamplingRate, int32 BlockSize)>;
+
+		struct FBenchmarkCase
+		{
+			FString Name;
+			FRunnerFactory CreateRunner;
+		};
+
+		/** Every synthesizer measured by the benchmark commandlet. A factory returns null when its assets are missing. */
+		TArray<FBenchmarkCase> GetBenchmarkCases();
+	}
+}
@@ -0,0 +1,92 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "ExtendArrayMath.h"
+#include "SynthBenchmarkUtils.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LBSImpactSFXSynth
+{
+	namespace SynthTests
+	{
+		/** Lengths around the four-wide reversal boundaries. */
+		static const int32 RotationLengths[] = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 64, 100 };
+
+		/** Check all shifts in [-2N - 1, 2N + 1], which covers 0, N, multiples of N and negative shifts. Returns the number of wrong rotations. */
+		template <typename T>
+		static int32 CountWrongRotations(const int32 NumSamples)
+		{
+			TArray<T> Source;
+			for(int32 i = 0; i < NumSamples; i++)
+				Source.Add(static_cast<T>(i + 1));
+
+			int32 NumWrong = 0;
+			TArray<T> InPlace;
+			TArray<T> OutOfPlace;
+			OutOfPlace.SetNumZeroed(NumSamples);
+			for(int32 Shift = -2 * NumSamples - 1; Shift <= 2 * NumSamples + 1; Shift++)
+			{
+				InPlace = Source;
+				ExtendArrayMath::ArrayCircularRightShift(TArrayView<T>(InPlace), Shift);
+				ExtendArrayMath::ArrayCircularRightShift(TArrayView<const T>(Source), Shift, TArrayView<T>(OutOfPlace));
+
+				const int32 WrappedShift = ((Shift % NumSamples) + NumSamples) % NumSamples;
+				bool bIsCorrect = true;
+				for(int32 i = 0; i < NumSamples; i++)
+				{
+					const T Expected = Source[(i + WrappedShift) % NumSamples];
+					bIsCorrect &= InPlace[i] == Expected && OutOfPlace[i] == Expected;
+				}
+				NumWrong += bIsCorrect ? 0 : 1;
+			}
+			return NumWrong;
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FArrayCircularRightShiftTest, "ImpactSFXSynth.ExtendArrayMath.CircularRightShift",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FArrayCircularRightShiftTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	//Floats take the vectorized reversal, other types Algo::Reverse
+	for(const int32 NumSamples : RotationLengths)
+	{
+		TestEqual(FString::Printf(TEXT("Float rotations of length %d"), NumSamples), CountWrongRotations<float>(NumSamples), 0);
+		TestEqual(FString::Printf(TEXT("Int32 rotations of length %d"), NumSamples), CountWrongRotations<int32>(NumSamples), 0);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FArrayCircularRightShiftAllocationTest, "ImpactSFXSynth.ExtendArrayMath.CircularRightShiftNoAllocations",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FArrayCircularRightShiftAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth::Benchmark;
+
+	//Same size as the largest FFT buffers rotated by the synthesizers
+	TArray<float> Values;
+	Values.SetNumZeroed(4096);
+	TArray<float> OutValues;
+	OutValues.SetNumZeroed(Values.Num());
+
+	int32 NumAllocations = 0;
+	{
+		FScopedAllocationCounter AllocationCounter;
+		for(int32 Shift = -Values.Num(); Shift <= 2 * Values.Num(); Shift += 37)
+		{
+			ExtendArrayMath::ArrayCircularRightShift(TArrayView<float>(Values), Shift);
+			ExtendArrayMath::ArrayCircularRightShift(TArrayView<const float>(Values), Shift, TArrayView<float>(OutValues));
+		}
+		NumAllocations = AllocationCounter.GetNumAllocations();
+	}
+
+	TestEqual(TEXT("Heap allocations of in-place and out-of-place rotations"), NumAllocations, 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,164 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "ImpactExternalForceSynth.h"
+#include "ImpactModalObj.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LBSImpactSFXSynth
+{
+	namespace SynthTests
+	{
+		static constexpr float ForceTestSamplingRate = 48000.f;
+		static constexpr int32 ForceTestBlockSize = 256;
+		static constexpr int32 ForceTestNumBlocks = 20;
+		static constexpr int32 ForceTestNumChannels = 2;
+		static constexpr int32 ForceTestNumForces = 3;
+
+		/** Modals loud enough that no resonator state falls under the decay threshold of the bank, which isn't linear. */
+		static FImpactModalObjAssetProxyPtr CreateForceTestModalProxy(const int32 NumModals, const int32 Seed)
+		{
+			FRandomStream RandomStream(Seed);
+			UImpactModalObj* ModalObj = NewObject<UImpactModalObj>(GetTransientPackage());
+			ModalObj->Params.SetNumUninitialized(NumModals * 3);
+			for(int32 i = 0; i < NumModals; i++)
+			{
+				ModalObj->Params[i * 3] = RandomStream.FRandRange(0.05f, 0.2f);
+				ModalObj->Params[i * 3 + 1] = RandomStream.FRandRange(5.f, 60.f);
+				ModalObj->Params[i * 3 + 2] = FMath::Exp(RandomStream.FRandRange(FMath::Loge(200.f), FMath::Loge(8000.f)));
+			}
+			ModalObj->NumModals = NumModals;
+			return ModalObj->CreateNewImpactModalObjProxyData();
+		}
+
+		/** Render each force through its own synth, with the force gains applied to the force of each channel, and sum all renders. */
+		static void RenderSumOfForces(const FImpactModalObjAssetProxyPtr& ModalProxy, const TArray<TArray<float>>& Forces,
+									  TArrayView<const float> ForceGains, TArray<TArray<float>>& OutAudio)
+		{
+			OutAudio.SetNum(ForceTestNumChannels);
+			for(TArray<float>& Channel : OutAudio)
+				Channel.SetNumZeroed(ForceTestNumBlocks * ForceTestBlockSize);
+
+			FAlignedFloatBuffer OutBuffers[ForceTestNumChannels];
+			FAlignedFloatBuffer ScaledForces[ForceTestNumChannels];
+			for(int32 Channel = 0; Channel < ForceTestNumChannels; Channel++)
+			{
+				OutBuffers[Channel].SetNumZeroed(ForceTestBlockSize);
+				ScaledForces[Channel].SetNumZeroed(ForceTestBlockSize);
+			}
+
+			for(int32 Force = 0; Force < Forces.Num(); Force++)
+			{
+				FImpactExternalForceSynth Synth(ModalProxy, ForceTestSamplingRate, ForceTestNumChannels);
+				for(int32 Block = 0; Block < ForceTestNumBlocks; Block++)
+				{
+					const int32 Start = Block * ForceTestBlockSize;
+					FMultichannelBufferView OutViews;
+					TArray<TArrayView<const float>> ForceViews;
+					for(int32 Channel = 0; Channel < ForceTestNumChannels; Channel++)
+					{
+						const float Gain = ForceGains.Num() > 0 ? ForceGains[Force * ForceTestNumChannels + Channel] : 1.f;
+						for(int32 i = 0; i < ForceTestBlockSize; i++)
+							ScaledForces[Channel][i] = Gain * Forces[Force][Start + i];
+						ForceViews.Emplace(ScaledForces[Channel]);
+						OutViews.Emplace(OutBuffers[Channel]);
+					}
+
+					Synth.Synthesize(OutViews, ForceViews, ModalProxy, 1.f, 1.f, 1.f, false, false);
+					for(int32 Channel = 0; Channel < ForceTestNumChannels; Channel++)
+					{
+						for(int32 i = 0; i < ForceTestBlockSize; i++)
+							OutAudio[Channel][Start + i] += OutBuffers[Channel][i];
+					}
+				}
+			}
+		}
+
+		static void RenderMultiForces(const FImpactModalObjAssetProxyPtr& ModalProxy, const TArray<TArray<float>>& Forces,
+									  TArrayView<const float> ForceGains, TArray<TArray<float>>& OutAudio)
+		{
+			OutAudio.SetNum(ForceTestNumChannels);
+			FAlignedFloatBuffer OutBuffers[ForceTestNumChannels];
+			for(int32 Channel = 0; Channel < ForceTestNumChannels; Channel++)
+			{
+				OutAudio[Channel].Reset(ForceTestNumBlocks * ForceTestBlockSize);
+				OutBuffers[Channel].SetNumZeroed(ForceTestBlockSize);
+			}
+
+			FImpactExternalForceSynth Synth(ModalProxy, ForceTestSamplingRate, ForceTestNumChannels);
+			for(int32 Block = 0; Block < ForceTestNumBlocks; Block++)
+			{
+				FMultichannelBufferView OutViews;
+				for(FAlignedFloatBuffer& Buffer : OutBuffers)
+					OutViews.Emplace(Buffer);
+
+				TArray<TArrayView<const float>> ForceViews;
+				for(const TArray<float>& Force : Forces)
+					ForceViews.Emplace(TArrayView<const float>(Force).Slice(Block * ForceTestBlockSize, ForceTestBlockSize));
+
+				Synth.SynthesizeMultiForces(OutViews, ForceViews, ForceGains, ModalProxy, 1.f, 1.f, 1.f, false, false);
+				for(int32 Channel = 0; Channel < ForceTestNumChannels; Channel++)
+					OutAudio[Channel].Append(OutBuffers[Channel]);
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImpactExternalForceMultiForcesTest, "ImpactSFXSynth.ExternalForceSynth.MultiForcesMatchSumOfForces",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FImpactExternalForceMultiForcesTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	const FImpactModalObjAssetProxyPtr ModalProxy = CreateForceTestModalProxy(30, 77);
+	if(!TestTrue(TEXT("Modal proxy is valid"), ModalProxy.IsValid()))
+		return false;
+
+	FRandomStream RandomStream(177);
+	TArray<TArray<float>> Forces;
+	Forces.SetNum(ForceTestNumForces);
+	for(TArray<float>& Force : Forces)
+	{
+		Force.SetNumUninitialized(ForceTestNumBlocks * ForceTestBlockSize);
+		for(float& Value : Force)
+			Value = RandomStream.FRandRange(-0.5f, 0.5f);
+	}
+
+	//A zero gain skips its force, and a negative one flips it
+	const float ForceGains[ForceTestNumForces * ForceTestNumChannels] = { 0.5f, 1.f, -1.f, 0.25f, 0.f, 2.f };
+	const TCHAR* CaseNames[] = { TEXT("Without gains"), TEXT("With gains") };
+	const TArrayView<const float> CaseGains[] = { TArrayView<const float>(), MakeArrayView(ForceGains) };
+	for(int32 Case = 0; Case < UE_ARRAY_COUNT(CaseNames); Case++)
+	{
+		TArray<TArray<float>> Expected;
+		TArray<TArray<float>> Output;
+		RenderSumOfForces(ModalProxy, Forces, CaseGains[Case], Expected);
+		RenderMultiForces(ModalProxy, Forces, CaseGains[Case], Output);
+
+		for(int32 Channel = 0; Channel < ForceTestNumChannels; Channel++)
+		{
+			if(!TestEqual(FString::Printf(TEXT("%s channel %d length"), CaseNames[Case], Channel), Output[Channel].Num(), Expected[Channel].Num()))
+				continue;
+
+			float Peak = 0.f;
+			float MaxDiff = 0.f;
+			for(int32 i = 0; i < Expected[Channel].Num(); i++)
+			{
+				Peak = FMath::Max(Peak, FMath::Abs(Expected[Channel][i]));
+				MaxDiff = FMath::Max(MaxDiff, FMath::Abs(Output[Channel][i] - Expected[Channel][i]));
+			}
+
+			//Summing forces before the modal bank only changes float rounding
+			TestTrue(FString::Printf(TEXT("%s channel %d isn't silent"), CaseNames[Case], Channel), Peak > 0.f);
+			TestTrue(FString::Printf(TEXT("%s channel %d max error %g of peak %g"), CaseNames[Case], Channel, MaxDiff, Peak), MaxDiff <= 1e-4f * Peak);
+		}
+	}
+	return true;
+}
+
+#endif
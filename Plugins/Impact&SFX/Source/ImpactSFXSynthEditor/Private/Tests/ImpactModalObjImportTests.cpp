@@ -0,0 +1,123 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "ImpactModalObj.h"
+#include "ImpactModalObjBinaryFactory.h"
+#include "ImpactModalObjFactory.h"
+#include "SynthBenchmarkUtils.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LBSImpactSFXSynth
+{
+	namespace SynthTests
+	{
+		/** Json text in the format of the modal analysis tools. %.9g round trips every float exactly. */
+		static FString MakeModalJson(const TArray<float>& Params, const int32 Version)
+		{
+			FString Json = FString::Printf(TEXT("{\"Version\": %d, \"ModalData\": ["), Version);
+			Json.Reserve(Params.Num() * 16);
+			for(int32 i = 0; i < Params.Num(); i++)
+			{
+				if(i > 0)
+					Json += TEXT(", ");
+				Json += FString::Printf(TEXT("%.9g"), Params[i]);
+			}
+			Json += TEXT("]}");
+			return Json;
+		}
+
+		static bool ImportModalJson(const FString& Json, UImpactModalObj* OutModalObj)
+		{
+			UImpactModalObjFactory* Factory = NewObject<UImpactModalObjFactory>();
+			const TCHAR* Buffer = *Json;
+			return Factory->ImportFromText(OutModalObj, Buffer, Buffer + Json.Len());
+		}
+
+		static bool IsParamsBitIdentical(const TArray<float>& A, const TArray<float>& B)
+		{
+			return A.Num() == B.Num() && FMemory::Memcmp(A.GetData(), B.GetData(), A.Num() * sizeof(float)) == 0;
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImpactModalObjBinaryRoundTripTest, "ImpactSFXSynth.ModalImport.JsonToBinaryRoundTrip",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FImpactModalObjBinaryRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	const TArray<float> SourceParams = Benchmark::MakeModalParams(257, 39);
+	const TStrongObjectPtr<UImpactModalObj> JsonObj(NewObject<UImpactModalObj>(GetTransientPackage()));
+	if(!TestTrue(TEXT("Json import"), ImportModalJson(MakeModalJson(SourceParams, 2), JsonObj.Get())))
+		return false;
+	TestTrue(TEXT("Json params are exact"), IsParamsBitIdentical(JsonObj->Params, SourceParams));
+
+	for(const bool bWriteChecksum : { true, false })
+	{
+		const FString FilePath = FPaths::AutomationTransientDir() / TEXT("ImpactSFXSynth")
+								 / FString::Printf(TEXT("RoundTrip%d.%s"), bWriteChecksum ? 1 : 0, UImpactModalObjBinaryFactory::FileExtension);
+		TArray<uint8> Bytes;
+		if(!TestTrue(TEXT("Binary export"), UImpactModalObjBinaryFactory::ExportToBinaryFile(JsonObj.Get(), FilePath, bWriteChecksum)
+										   && FFileHelper::LoadFileToArray(Bytes, *FilePath)))
+			continue;
+
+		const TStrongObjectPtr<UImpactModalObj> BinaryObj(NewObject<UImpactModalObj>(GetTransientPackage()));
+		if(!TestTrue(TEXT("Binary import"), UImpactModalObjBinaryFactory::ImportFromBinary(BinaryObj.Get(), Bytes.GetData(), Bytes.GetData() + Bytes.Num())))
+			continue;
+
+		TestEqual(TEXT("Version"), BinaryObj->Version, JsonObj->Version);
+		TestEqual(TEXT("Number of modals"), BinaryObj->NumModals, JsonObj->NumModals);
+		TestTrue(TEXT("Binary params are bit identical to json params"), IsParamsBitIdentical(BinaryObj->Params, JsonObj->Params));
+
+		if(bWriteChecksum)
+		{
+			Bytes.Last() ^= 0x01;
+			AddExpectedError(TEXT("corrupted"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestFalse(TEXT("Corrupted payload is rejected"),
+					  UImpactModalObjBinaryFactory::ImportFromBinary(BinaryObj.Get(), Bytes.GetData(), Bytes.GetData() + Bytes.Num()));
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImpactModalObjImportTimeTest, "ImpactSFXSynth.ModalImport.ImportTime",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FImpactModalObjImportTimeTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	constexpr int32 NumModals = 100000;
+	const TArray<float> SourceParams = Benchmark::MakeModalParams(NumModals, 39);
+	const FString Json = MakeModalJson(SourceParams, 1);
+
+	const TStrongObjectPtr<UImpactModalObj> ModalObj(NewObject<UImpactModalObj>(GetTransientPackage()));
+	double JsonSeconds = FPlatformTime::Seconds();
+	const bool bIsJsonImported = ImportModalJson(Json, ModalObj.Get());
+	JsonSeconds = FPlatformTime::Seconds() - JsonSeconds;
+
+	const FString FilePath = FPaths::AutomationTransientDir() / TEXT("ImpactSFXSynth")
+							 / FString::Printf(TEXT("ImportTime.%s"), UImpactModalObjBinaryFactory::FileExtension);
+	TArray<uint8> Bytes;
+	if(!TestTrue(TEXT("Json import and binary export"), bIsJsonImported && UImpactModalObjBinaryFactory::ExportToBinaryFile(ModalObj.Get(), FilePath)
+																		   && FFileHelper::LoadFileToArray(Bytes, *FilePath)))
+		return false;
+
+	double BinarySeconds = FPlatformTime::Seconds();
+	TestTrue(TEXT("Binary import"), UImpactModalObjBinaryFactory::ImportFromBinary(ModalObj.Get(), Bytes.GetData(), Bytes.GetData() + Bytes.Num()));
+	BinarySeconds = FPlatformTime::Seconds() - BinarySeconds;
+
+	AddInfo(FString::Printf(TEXT("%d modals: json %.3f ms (%d bytes), binary %.3f ms (%d bytes), %.1fx faster"), NumModals,
+							JsonSeconds * 1e3, Json.Len(), BinarySeconds * 1e3, Bytes.Num(), JsonSeconds / FMath::Max(BinarySeconds, UE_DOUBLE_SMALL_NUMBER)));
+	return true;
+}
+
+#endif
@@ -0,0 +1,308 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "ResidualAnalyzer.h"
+#include "ResidualData.h"
+#include "ResidualObj.h"
+#include "ResidualSynth.h"
+#include "WaveChunkReader.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LBSImpactSFXSynth
+{
+	namespace SynthTests
+	{
+		static constexpr int32 TestWaveSamplingRate = 48000;
+
+		/** Decaying noise bursts every half second, so no part of the clip is trimmed as silence. Interleaved if NumChannels > 1. */
+		static TArray<float> MakeNoiseBursts(const float Seconds, const int32 NumChannels, const int32 Seed)
+		{
+			FRandomStream RandomStream(Seed);
+			const int32 NumFrames = FMath::RoundToInt32(Seconds * TestWaveSamplingRate);
+			const int32 BurstPeriod = TestWaveSamplingRate / 2;
+			TArray<float> Samples;
+			Samples.SetNumUninitialized(NumFrames * NumChannels);
+			for(int32 Frame = 0; Frame < NumFrames; Frame++)
+			{
+				const float Envelope = 0.8f * FMath::Exp(-20.f * (Frame % BurstPeriod) / TestWaveSamplingRate);
+				for(int32 Channel = 0; Channel < NumChannels; Channel++)
+					Samples[Frame * NumChannels + Channel] = Envelope * RandomStream.FRandRange(-1.f, 1.f);
+			}
+			return Samples;
+		}
+
+		/** Write a canonical 44 byte header wav file in one of the formats FWaveChunkReader reads. */
+		static bool WriteTestWave(const FString& FilePath, const TArray<float>& Samples, const int32 NumChannels, const EWaveSampleFormat Format)
+		{
+			const int32 BytesPerSample = Format == EWaveSampleFormat::PCM16 ? 2 : (Format == EWaveSampleFormat::PCM24 ? 3 : 4);
+			const uint16 FormatTag = Format == EWaveSampleFormat::Float32 ? 3 : 1;
+			const uint32 DataSize = Samples.Num() * BytesPerSample;
+
+			TArray<uint8> Bytes;
+			Bytes.Reserve(44 + DataSize);
+			auto AddTag = [&Bytes](const char* Tag) { Bytes.Append(reinterpret_cast<const uint8*>(Tag), 4); };
+			auto AddInt = [&Bytes](const uint32 Value, const int32 NumBytes)
+			{
+				for(int32 i = 0; i < NumBytes; i++)
+					Bytes.Add(static_cast<uint8>((Value >> (8 * i)) & 0xFF));
+			};
+
+			AddTag("RIFF");
+			AddInt(36 + DataSize, 4);
+			AddTag("WAVE");
+			AddTag("fmt ");
+			AddInt(16, 4);
+			AddInt(FormatTag, 2);
+			AddInt(NumChannels, 2);
+			AddInt(TestWaveSamplingRate, 4);
+			AddInt(TestWaveSamplingRate * NumChannels * BytesPerSample, 4);
+			AddInt(NumChannels * BytesPerSample, 2);
+			AddInt(BytesPerSample * 8, 2);
+			AddTag("data");
+			AddInt(DataSize, 4);
+
+			for(const float Sample : Samples)
+			{
+				const float Clamped = FMath::Clamp(Sample, -1.f, 1.f);
+				switch (Format)
+				{
+				case EWaveSampleFormat::PCM16:
+					AddInt(static_cast<uint32>(FMath::RoundToInt32(Clamped * 32767.f)), 2);
+					break;
+				case EWaveSampleFormat::PCM24:
+					AddInt(static_cast<uint32>(FMath::RoundToInt32(Clamped * 8388607.f)), 3);
+					break;
+				case EWaveSampleFormat::PCM32:
+					AddInt(static_cast<uint32>(FMath::RoundToInt64(Clamped * 2147483647.0)), 4);
+					break;
+				case EWaveSampleFormat::Float32:
+					AddInt(BitCast<uint32>(Clamped), 4);
+					break;
+				}
+			}
+
+			return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+		}
+
+		static FString GetTestWavePath(const TCHAR* Name)
+		{
+			return FPaths::AutomationTransientDir() / TEXT("ImpactSFXSynth") / FString::Printf(TEXT("%s.wav"), Name);
+		}
+
+		static bool AnalyzeTestWave(const FString& FilePath, const int32 Channel, const int32 NumChunks, UResidualObj* OutResidualObj,
+									int32* OutNumCalibrationPasses = nullptr)
+		{
+			FResidualAnalyzer Analyzer(FilePath, Channel);
+			Analyzer.SetNumAnalysisChunks(NumChunks);
+			const bool bIsAnalyzed = Analyzer.StartAnalyzing(OutResidualObj);
+			if(OutNumCalibrationPasses)
+				*OutNumCalibrationPasses = Analyzer.GetNumCalibrationPasses();
+			return bIsAnalyzed;
+		}
+
+		/** Power of the residual object synthesized with the same settings and seed as the analyzer calibration. */
+		static double GetSynthesizedPower(UResidualObj* ResidualObj)
+		{
+			const auto ResidualDataAssetProxy = MakeShared<FResidualDataAssetProxy>(ResidualObj);
+			FResidualSynth ResidualSynth(ResidualObj->GetSamplingRate(), ResidualObj->GetHopSize(), 1, ResidualDataAssetProxy,
+										 1.f, 1.f, 1.f, 0, 0.f, -1.f);
+			FAlignedFloatBuffer SynthesizedData;
+			FResidualSynth::SynthesizeFull(ResidualSynth, SynthesizedData);
+
+			double Power = 0.0;
+			for(const float Sample : SynthesizedData)
+				Power += Sample * Sample;
+			return Power;
+		}
+
+		static float GetMaxAbsDiff(const UResidualObj* A, const UResidualObj* B)
+		{
+			float MaxDiff = 0.f;
+			for(int32 i = 0; i < FMath::Min(A->Data.Num(), B->Data.Num()); i++)
+				MaxDiff = FMath::Max(MaxDiff, FMath::Abs(A->Data[i] - B->Data[i]));
+			return MaxDiff;
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FResidualAnalyzerParallelTest, "ImpactSFXSynth.ResidualAnalyzer.ParallelMatchesSerial",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FResidualAnalyzerParallelTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	const FString FilePath = GetTestWavePath(TEXT("ParallelNoiseBursts"));
+	if(!TestTrue(TEXT("Write test wave"), WriteTestWave(FilePath, MakeNoiseBursts(3.f, 1, 31), 1, EWaveSampleFormat::PCM16)))
+		return false;
+
+	const TStrongObjectPtr<UResidualObj> SerialObj(NewObject<UResidualObj>(GetTransientPackage()));
+	const TStrongObjectPtr<UResidualObj> ParallelObj(NewObject<UResidualObj>(GetTransientPackage()));
+	TestTrue(TEXT("Serial analysis"), AnalyzeTestWave(FilePath, 0, 1, SerialObj.Get()));
+	//More chunks than cores so chunk boundaries are crossed even on small machines
+	TestTrue(TEXT("Parallel analysis"), AnalyzeTestWave(FilePath, 0, 16, ParallelObj.Get()));
+
+	TestEqual(TEXT("Number of frames"), ParallelObj->GetNumFrame(), SerialObj->GetNumFrame());
+	TestTrue(TEXT("ERB data is bit identical"), SerialObj->Data.Num() == ParallelObj->Data.Num()
+			 && FMemory::Memcmp(SerialObj->Data.GetData(), ParallelObj->Data.GetData(), SerialObj->Data.Num() * sizeof(float)) == 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FResidualAnalyzerCalibrationTest, "ImpactSFXSynth.ResidualAnalyzer.Calibration",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FResidualAnalyzerCalibrationTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	//Float samples so the power seen by the analyzer is the power computed here
+	const TArray<float> Samples = MakeNoiseBursts(3.f, 1, 32);
+	const FString FilePath = GetTestWavePath(TEXT("CalibrationNoiseBursts"));
+	if(!TestTrue(TEXT("Write test wave"), WriteTestWave(FilePath, Samples, 1, EWaveSampleFormat::Float32)))
+		return false;
+
+	const TStrongObjectPtr<UResidualObj> ResidualObj(NewObject<UResidualObj>(GetTransientPackage()));
+	int32 NumCalibrationPasses = 0;
+	if(!TestTrue(TEXT("Analysis"), AnalyzeTestWave(FilePath, 0, 0, ResidualObj.Get(), &NumCalibrationPasses)))
+		return false;
+
+	double OrgPower = 0.0;
+	for(const float Sample : Samples)
+		OrgPower += Sample * Sample;
+	const double PowerError = FMath::Abs(GetSynthesizedPower(ResidualObj.Get()) / OrgPower - 1.0);
+
+	//Same 1% tolerance as the bisection. The small margin covers rounding of scaling the data instead of the synth
+	AddInfo(FString::Printf(TEXT("Power error %.5f after %d synthesis passes"), PowerError, NumCalibrationPasses));
+	TestTrue(TEXT("Calibrated power is within 1% of the original"), PowerError <= 0.0101);
+	//The bisection alone needed about 10 passes to reach this tolerance
+	TestTrue(TEXT("Calibration needs at most the first pass and one refinement"), NumCalibrationPasses <= 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FResidualAnalyzerWaveFormatTest, "ImpactSFXSynth.ResidualAnalyzer.WaveFormats",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FResidualAnalyzerWaveFormatTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	const TArray<float> Samples = MakeNoiseBursts(2.f, 1, 33);
+	const FString FloatPath = GetTestWavePath(TEXT("FormatFloat32"));
+	if(!TestTrue(TEXT("Write float wave"), WriteTestWave(FloatPath, Samples, 1, EWaveSampleFormat::Float32)))
+		return false;
+
+	const TStrongObjectPtr<UResidualObj> ReferenceObj(NewObject<UResidualObj>(GetTransientPackage()));
+	if(!TestTrue(TEXT("Float analysis"), AnalyzeTestWave(FloatPath, 0, 0, ReferenceObj.Get())))
+		return false;
+	float MaxMagnitude = 0.f;
+	for(const float Magnitude : ReferenceObj->Data)
+		MaxMagnitude = FMath::Max(MaxMagnitude, Magnitude);
+
+	//Integer formats only differ by quantization noise, which is small compared to the ERB magnitudes
+	const TPair<EWaveSampleFormat, const TCHAR*> IntFormats[] = { { EWaveSampleFormat::PCM16, TEXT("FormatPCM16") },
+																  { EWaveSampleFormat::PCM24, TEXT("FormatPCM24") } };
+	for(const TPair<EWaveSampleFormat, const TCHAR*>& Format : IntFormats)
+	{
+		const FString FilePath = GetTestWavePath(Format.Value);
+		const TStrongObjectPtr<UResidualObj> ResidualObj(NewObject<UResidualObj>(GetTransientPackage()));
+		if(!TestTrue(FString::Printf(TEXT("Analyze %s"), Format.Value),
+					 WriteTestWave(FilePath, Samples, 1, Format.Key) && AnalyzeTestWave(FilePath, 0, 0, ResidualObj.Get())))
+			continue;
+
+		TestEqual(FString::Printf(TEXT("%s number of frames"), Format.Value), ResidualObj->GetNumFrame(), ReferenceObj->GetNumFrame());
+		TestTrue(FString::Printf(TEXT("%s matches float"), Format.Value), GetMaxAbsDiff(ResidualObj.Get(), ReferenceObj.Get()) <= 1e-2f * MaxMagnitude);
+	}
+
+	//Stereo with the test signal on the second channel and unrelated noise on the first
+	const TArray<float> OtherSamples = MakeNoiseBursts(2.f, 1, 34);
+	TArray<float> StereoSamples;
+	StereoSamples.SetNumUninitialized(Samples.Num() * 2);
+	for(int32 i = 0; i < Samples.Num(); i++)
+	{
+		StereoSamples[2 * i] = OtherSamples[i];
+		StereoSamples[2 * i + 1] = Samples[i];
+	}
+	const FString StereoPath = GetTestWavePath(TEXT("FormatStereo"));
+	const TStrongObjectPtr<UResidualObj> ChannelObj(NewObject<UResidualObj>(GetTransientPackage()));
+	if(TestTrue(TEXT("Analyze second channel"), WriteTestWave(StereoPath, StereoSamples, 2, EWaveSampleFormat::Float32)
+				&& AnalyzeTestWave(StereoPath, 1, 0, ChannelObj.Get())))
+	{
+		TestTrue(TEXT("Second channel is bit identical to mono"), ChannelObj->Data == ReferenceObj->Data);
+	}
+
+	//Downmix of identical channels is the mono signal itself
+	for(int32 i = 0; i < Samples.Num(); i++)
+		StereoSamples[2 * i] = Samples[i];
+	const FString DownmixPath = GetTestWavePath(TEXT("FormatDownmix"));
+	const TStrongObjectPtr<UResidualObj> DownmixObj(NewObject<UResidualObj>(GetTransientPackage()));
+	if(TestTrue(TEXT("Analyze downmix"), WriteTestWave(DownmixPath, StereoSamples, 2, EWaveSampleFormat::Float32)
+				&& AnalyzeTestWave(DownmixPath, FWaveChunkReader::DownmixChannels, 0, DownmixObj.Get())))
+	{
+		TestTrue(TEXT("Downmix is bit identical to mono"), DownmixObj->Data == ReferenceObj->Data);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FResidualAnalyzerLongClipTest, "ImpactSFXSynth.ResidualAnalyzer.LongClip",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FResidualAnalyzerLongClipTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	//The analyzer used to stop at 10 s
+	constexpr float Seconds = 30.f;
+	const FString FilePath = GetTestWavePath(TEXT("LongClip"));
+	if(!TestTrue(TEXT("Write test wave"), WriteTestWave(FilePath, MakeNoiseBursts(Seconds, 2, 35), 2, EWaveSampleFormat::PCM24)))
+		return false;
+
+	const TStrongObjectPtr<UResidualObj> ResidualObj(NewObject<UResidualObj>(GetTransientPackage()));
+	if(!TestTrue(TEXT("Analysis"), AnalyzeTestWave(FilePath, FWaveChunkReader::DownmixChannels, 0, ResidualObj.Get())))
+		return false;
+
+	//Bursts repeat until the end so nothing is trimmed except the decayed tail of the last one
+	const int32 MinNumFrame = FMath::FloorToInt32((Seconds - 0.5f) * TestWaveSamplingRate / FResidualAnalyzer::HopSizeAnalyze);
+	TestTrue(FString::Printf(TEXT("%d frames cover more than %.1f s"), ResidualObj->GetNumFrame(), Seconds - 0.5f),
+			 ResidualObj->GetNumFrame() >= MinNumFrame);
+	TestEqual(TEXT("Data size"), ResidualObj->Data.Num(), ResidualObj->GetNumFrame() * FResidualAnalyzer::NumErb);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FResidualAnalyzerSpeedupTest, "ImpactSFXSynth.ResidualAnalyzer.ParallelSpeedup",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FResidualAnalyzerSpeedupTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	const FString FilePath = GetTestWavePath(TEXT("LongNoiseBursts"));
+	if(!TestTrue(TEXT("Write test wave"), WriteTestWave(FilePath, MakeNoiseBursts(120.f, 1, 31), 1, EWaveSampleFormat::PCM16)))
+		return false;
+
+	const TStrongObjectPtr<UResidualObj> ResidualObj(NewObject<UResidualObj>(GetTransientPackage()));
+	double SerialSeconds = FPlatformTime::Seconds();
+	TestTrue(TEXT("Serial analysis"), AnalyzeTestWave(FilePath, 0, 1, ResidualObj.Get()));
+	SerialSeconds = FPlatformTime::Seconds() - SerialSeconds;
+
+	double ParallelSeconds = FPlatformTime::Seconds();
+	TestTrue(TEXT("Parallel analysis"), AnalyzeTestWave(FilePath, 0, 0, ResidualObj.Get()));
+	ParallelSeconds = FPlatformTime::Seconds() - ParallelSeconds;
+
+	//Both include the same serial calibration, so this is a lower bound of the speedup of the frame analysis
+	AddInfo(FString::Printf(TEXT("120 s clip: serial %.3f s, parallel %.3f s, speedup %.2fx on %d cores"), SerialSeconds, ParallelSeconds,
+							SerialSeconds / FMath::Max(ParallelSeconds, UE_DOUBLE_SMALL_NUMBER), FPlatformMisc::NumberOfCoresIncludingHyperthreads()));
+	return true;
+}
+
+#endif
@@ -0,0 +1,66 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "ScratchingSynth.h"
+#include "SynthBenchmarkUtils.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FScratchingSynthAllocationTest, "ImpactSFXSynth.ScratchingSynth.NoAllocationsWhileScratching",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FScratchingSynthAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth;
+	using namespace LBSImpactSFXSynth::Benchmark;
+
+	constexpr float SamplingRate = 48000.f;
+	constexpr int32 BlockSize = 512;
+	FBenchmarkAssets Assets;
+	CreateBenchmarkAssets(42, nullptr, nullptr, nullptr, Assets);
+
+	FScratchingSynth ScratchingSynth(SamplingRate, BlockSize, 1, Assets.Seed, Assets.ResidualProxy, 1.f);
+	FScratchImpactSpawnParams SpawnParams(200.f, 1.f, 0.f, -1.f, 0.5f, 0.5f, 0.f, 0, 2, 1.f);
+	FModalMods ExciteMods;
+	FModalMods ResonMods;
+	FAlignedFloatBuffer OutBuffer;
+	OutBuffer.SetNumZeroed(BlockSize);
+	FMultichannelBufferView OutViews;
+	OutViews.Add(OutBuffer);
+
+	//Back and forth strokes: the spawn rate and the pitch of both modal sets follow the stroke speed,
+	//so new mods are added every block and old mods slots are evicted and reused
+	const float BlockTime = BlockSize / SamplingRate;
+	int32 MaxNumActiveImpacts = 0;
+	auto RenderGesture = [&](const int32 StartBlock, const int32 NumBlocks)
+	{
+		for(int32 Block = StartBlock; Block < StartBlock + NumBlocks; Block++)
+		{
+			const float StrokeSpeed = FMath::Abs(FMath::Sin(UE_TWO_PI * 1.5f * Block * BlockTime));
+			SpawnParams.SpawnRate = 50.f + 350.f * StrokeSpeed;
+			SpawnParams.GainMin = 0.2f + 0.6f * StrokeSpeed;
+			ExciteMods.FreqScale = 0.8f + 0.4f * StrokeSpeed;
+			ResonMods.FreqScale = 0.5f + 0.1f * StrokeSpeed;
+			ScratchingSynth.Synthesize(SpawnParams, Assets.ModalProxy, ExciteMods, Assets.ModalProxy, ResonMods, OutViews, true);
+			MaxNumActiveImpacts = FMath::Max(MaxNumActiveImpacts, ScratchingSynth.GetNumActiveImpacts());
+		}
+	};
+
+	//Warm up one full stroke so every impact and mods slot has been used once
+	const int32 NumStrokeBlocks = FMath::CeilToInt32(1.f / (1.5f * BlockTime));
+	RenderGesture(0, NumStrokeBlocks);
+
+	const int32 NumBlocks = FMath::CeilToInt32(20.f / BlockTime);
+	int32 NumAllocations = 0;
+	{
+		FScopedAllocationCounter AllocationCounter;
+		RenderGesture(NumStrokeBlocks, NumBlocks);
+		NumAllocations = AllocationCounter.GetNumAllocations();
+	}
+
+	TestEqual(TEXT("Heap allocations during a 20 s scratch gesture"), NumAllocations, 0);
+	TestEqual(TEXT("The gesture fills the impact ring"), MaxNumActiveImpacts, FScratchingSynth::MaxNumImpacts);
+	return true;
+}
+
+#endif
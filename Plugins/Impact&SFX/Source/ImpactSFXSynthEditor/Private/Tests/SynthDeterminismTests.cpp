@@ -0,0 +1,248 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#include "SynthBenchmarkUtils.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LBSImpactSFXSynth
+{
+	namespace SynthTests
+	{
+		using namespace Benchmark;
+
+		static constexpr float TestSamplingRate = 48000.f;
+		static constexpr int32 TestBlockSize = 512;
+		static constexpr int32 TestNumBlocks = 94;
+		static constexpr int32 TestSeed = 1234;
+
+		enum class EGoldenCompareMode : uint8
+		{
+			/** Scalar kernels. The render must match the stored buffer bit for bit. */
+			BitExact,
+			/** SIMD and FFT kernels, whose rounding can change with the CPU and the FFT backend. */
+			MinSNR
+		};
+
+		struct FGoldenKernel
+		{
+			const TCHAR* Name;
+			EGoldenCompareMode CompareMode;
+			/** Min SNR in dB of the render against the stored buffer. Only used in MinSNR mode. */
+			double MinSNRDb;
+		};
+
+		//ModalReverb isn't listed as it scatters its modals with FMath::FRand
+		//All kernels below render through SIMD modal banks or FFTs, so none of them is compared bit exact
+		static const FGoldenKernel GoldenKernels[] =
+		{
+			{ TEXT("ModalSynth"), EGoldenCompareMode::MinSNR, 90.0 },
+			{ TEXT("ResidualSynth"), EGoldenCompareMode::MinSNR, 80.0 },
+			{ TEXT("MultiImpactSynth"), EGoldenCompareMode::MinSNR, 80.0 },
+			{ TEXT("HRTFModal"), EGoldenCompareMode::MinSNR, 90.0 },
+			{ TEXT("BurbleSoundGen"), EGoldenCompareMode::MinSNR, 90.0 },
+			{ TEXT("ChirpSynthLinear"), EGoldenCompareMode::MinSNR, 90.0 },
+			{ TEXT("ChirpSynthSigmoid"), EGoldenCompareMode::MinSNR, 90.0 },
+			{ TEXT("ChirpSynthExponent"), EGoldenCompareMode::MinSNR, 90.0 },
+			{ TEXT("VehicleEngineSynth"), EGoldenCompareMode::MinSNR, 90.0 },
+			{ TEXT("VehicleEngineEulerSynth"), EGoldenCompareMode::MinSNR, 90.0 },
+		};
+
+		static const FBenchmarkCase* FindCase(const TArray<FBenchmarkCase>& Cases, const TCHAR* Name)
+		{
+			return Cases.FindByPredicate([Name](const FBenchmarkCase& Case) { return Case.Name == Name; });
+		}
+
+		static bool RenderCase(const FBenchmarkCase& Case, const FBenchmarkAssets& Assets, TArray<float>& OutAudio)
+		{
+			TUniquePtr<FSynthRunner> Runner = Case.CreateRunner(Assets, TestSamplingRate, TestBlockSize);
+			if(!Runner.IsValid())
+				return false;
+
+			FAlignedFloatBuffer Block;
+			Block.SetNumZeroed(TestBlockSize);
+			OutAudio.Reset(TestNumBlocks * TestBlockSize);
+			for(int32 i = 0; i < TestNumBlocks; i++)
+			{
+				Runner->Prepare();
+				Runner->Render(Block);
+				OutAudio.Append(Block);
+			}
+			return true;
+		}
+
+		/** SNR in dB of Signal against Reference. Infinite if they are equal. */
+		static double GetSNRDb(const TArray<float>& Reference, const TArray<float>& Signal)
+		{
+			double ReferenceEnergy = 0.0;
+			double ErrorEnergy = 0.0;
+			for(int32 i = 0; i < Reference.Num(); i++)
+			{
+				const double Error = static_cast<double>(Signal[i]) - Reference[i];
+				ReferenceEnergy += static_cast<double>(Reference[i]) * Reference[i];
+				ErrorEnergy += Error * Error;
+			}
+
+			if(ErrorEnergy <= 0.0)
+				return TNumericLimits<double>::Max();
+			return ReferenceEnergy > 0.0 ? 10.0 * FMath::LogX(10.0, ReferenceEnergy / ErrorEnergy) : TNumericLimits<double>::Lowest();
+		}
+
+		static bool IsBitExact(const TArray<float>& A, const TArray<float>& B)
+		{
+			return A.Num() == B.Num() && FMemory::Memcmp(A.GetData(), B.GetData(), A.Num() * sizeof(float)) == 0;
+		}
+
+		static FString GetGoldenFilePath(const TCHAR* KernelName)
+		{
+			const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("ImpactSFXSynth"));
+			const FString BaseDir = Plugin.IsValid() ? Plugin->GetBaseDir() : FPaths::ProjectDir();
+			return BaseDir / TEXT("Tests") / TEXT("Golden")
+				/ FString::Printf(TEXT("%s_%d_%d.bin"), KernelName, FMath::RoundToInt32(TestSamplingRate), TestBlockSize);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImpactSFXSeededRunToRunTest, "ImpactSFXSynth.Determinism.RunToRun",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FImpactSFXSeededRunToRunTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	const TArray<FBenchmarkCase> Cases = GetBenchmarkCases();
+	for(const FGoldenKernel& Kernel : GoldenKernels)
+	{
+		const FBenchmarkCase* Case = FindCase(Cases, Kernel.Name);
+		if(!TestNotNull(FString::Printf(TEXT("%s case"), Kernel.Name), Case))
+			continue;
+
+		//Regenerate the assets too, so seeded asset generation is covered
+		TArray<float> FirstRun;
+		TArray<float> SecondRun;
+		{
+			FBenchmarkAssets Assets;
+			CreateBenchmarkAssets(TestSeed, nullptr, nullptr, nullptr, Assets);
+			RenderCase(*Case, Assets, FirstRun);
+		}
+		{
+			FBenchmarkAssets Assets;
+			CreateBenchmarkAssets(TestSeed, nullptr, nullptr, nullptr, Assets);
+			RenderCase(*Case, Assets, SecondRun);
+		}
+
+		TestTrue(FString::Printf(TEXT("%s is bit exact between runs with the same seed"), Kernel.Name), IsBitExact(FirstRun, SecondRun));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImpactSFXThreadCountTest, "ImpactSFXSynth.Determinism.ThreadCount",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FImpactSFXThreadCountTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	FBenchmarkAssets Assets;
+	CreateBenchmarkAssets(TestSeed, nullptr, nullptr, nullptr, Assets);
+	const TArray<FBenchmarkCase> Cases = GetBenchmarkCases();
+
+	for(const TCHAR* Name : { TEXT("MultiImpactSynth"), TEXT("ResidualSynth") })
+	{
+		const FBenchmarkCase* Case = FindCase(Cases, Name);
+		if(!TestNotNull(FString::Printf(TEXT("%s case"), Name), Case))
+			continue;
+
+		TArray<float> Reference;
+		RenderCase(*Case, Assets, Reference);
+
+		//Voices share the same proxies, so rendering them concurrently must not change any of them
+		for(const int32 NumThreads : { 2, 4, 8 })
+		{
+			TArray<TArray<float>> Outputs;
+			Outputs.SetNum(NumThreads);
+			ParallelFor(NumThreads, [&](const int32 Index)
+			{
+				RenderCase(*Case, Assets, Outputs[Index]);
+			});
+
+			for(int32 i = 0; i < NumThreads; i++)
+			{
+				TestTrue(FString::Printf(TEXT("%s on thread %d of %d matches the single thread render"), Name, i, NumThreads),
+						 IsBitExact(Reference, Outputs[i]));
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Compare seeded renders against buffers stored under <Plugin>/Tests/Golden.
+ * Run with -GenerateGolden to write those buffers on a reference machine instead, then check them in.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImpactSFXGoldenTest, "ImpactSFXSynth.Determinism.Golden",
+								 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FImpactSFXGoldenTest::RunTest(const FString& Parameters)
+{
+	using namespace LBSImpactSFXSynth::SynthTests;
+
+	const bool bGenerateGolden = FParse::Param(FCommandLine::Get(), TEXT("GenerateGolden"));
+
+	FBenchmarkAssets Assets;
+	CreateBenchmarkAssets(TestSeed, nullptr, nullptr, nullptr, Assets);
+	const TArray<FBenchmarkCase> Cases = GetBenchmarkCases();
+
+	for(const FGoldenKernel& Kernel : GoldenKernels)
+	{
+		const FBenchmarkCase* Case = FindCase(Cases, Kernel.Name);
+		if(!TestNotNull(FString::Printf(TEXT("%s case"), Kernel.Name), Case))
+			continue;
+
+		TArray<float> Output;
+		RenderCase(*Case, Assets, Output);
+		const FString FilePath = GetGoldenFilePath(Kernel.Name);
+
+		if(bGenerateGolden)
+		{
+			const TArrayView<const uint8> Bytes(reinterpret_cast<const uint8*>(Output.GetData()), Output.Num() * sizeof(float));
+			if(FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+				AddInfo(FString::Printf(TEXT("Golden buffer written to %s"), *FilePath));
+			else
+				AddError(FString::Printf(TEXT("Can't write golden buffer %s"), *FilePath));
+			continue;
+		}
+
+		TArray<uint8> Bytes;
+		if(!FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent))
+		{
+			AddError(FString::Printf(TEXT("Missing or unreadable golden buffer %s. Run with -GenerateGolden to create it."), *FilePath));
+			continue;
+		}
+
+		if(!TestEqual(FString::Printf(TEXT("%s golden length"), Kernel.Name), Bytes.Num(), static_cast<int32>(Output.Num() * sizeof(float))))
+			continue;
+
+		TArray<float> Golden;
+		Golden.SetNumUninitialized(Output.Num());
+		FMemory::Memcpy(Golden.GetData(), Bytes.GetData(), Bytes.Num());
+
+		if(Kernel.CompareMode == EGoldenCompareMode::BitExact)
+		{
+			TestTrue(FString::Printf(TEXT("%s is bit exact with the golden buffer"), Kernel.Name), IsBitExact(Golden, Output));
+			continue;
+		}
+
+		const double SNRDb = GetSNRDb(Golden, Output);
+		TestTrue(FString::Printf(TEXT("%s SNR %.1f dB is at least %.1f dB"), Kernel.Name, SNRDb, Kernel.MinSNRDb), SNRDb >= Kernel.MinSNRDb);
+	}
+	return true;
+}
+
+#endif
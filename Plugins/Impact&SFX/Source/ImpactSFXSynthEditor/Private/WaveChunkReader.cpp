@@ -0,0 +1,222 @@
+﻿// Copyright 2023-2024, Le Binh Son, All Rights Reserved.
+
+#include "WaveChunkReader.h"
+
+#include "ImpactSFXSynthEditorLog.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+
+namespace LBSImpactSFXSynth
+{
+	namespace WaveChunkReaderUtils
+	{
+		constexpr uint16 FormatPCM = 1;
+		constexpr uint16 FormatFloat = 3;
+		constexpr uint16 FormatExtensible = 0xFFFE;
+		
+		FORCEINLINE uint16 ReadUInt16(const uint8* Data)
+		{
+			return static_cast<uint16>(Data[0] | (Data[1] << 8));
+		}
+
+		FORCEINLINE uint32 ReadUInt32(const uint8* Data)
+		{
+			return static_cast<uint32>(Data[0]) | (static_cast<uint32>(Data[1]) << 8)
+				| (static_cast<uint32>(Data[2]) << 16) | (static_cast<uint32>(Data[3]) << 24);
+		}
+
+		FORCEINLINE bool IsChunkId(const uint8* Data, const char* Id)
+		{
+			return FMemory::Memcmp(Data, Id, 4) == 0;
+		}
+	}
+	
+	FWaveChunkReader::FWaveChunkReader()
+		: SampleFormat(EWaveSampleFormat::PCM16), SamplingRate(0.f), NumChannels(0), BytesPerSample(2)
+		, DataOffset(0), NumFrames(0), CurrentFrame(0)
+	{
+	}
+
+	FWaveChunkReader::~FWaveChunkReader() = default;
+
+	bool FWaveChunkReader::OpenFile(const FString& FilePath)
+	{
+		MemoryData.Empty();
+		FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+		if(!FileHandle.IsValid())
+			return false;
+
+		if(!ParseHeader())
+		{
+			FileHandle.Reset();
+			NumChannels = 0;
+			return false;
+		}
+		return true;
+	}
+
+	bool FWaveChunkReader::OpenPCM16(TArray<uint8>&& InPCMData, const uint32 InSamplingRate, const uint16 InNumChannels)
+	{
+		FileHandle.Reset();
+		MemoryData = MoveTemp(InPCMData);
+		SampleFormat = EWaveSampleFormat::PCM16;
+		BytesPerSample = 2;
+		SamplingRate = InSamplingRate;
+		NumChannels = InNumChannels;
+		DataOffset = 0;
+		CurrentFrame = 0;
+		NumFrames = NumChannels > 0 ? MemoryData.Num() / (BytesPerSample * NumChannels) : 0;
+		return IsValid();
+	}
+
+	bool FWaveChunkReader::ParseHeader()
+	{
+		using namespace WaveChunkReaderUtils;
+		
+		const int64 FileSize = FileHandle->Size();
+		uint8 Header[12];
+		if(FileSize < 12 || !ReadBytes(Header, 0, 12) || !IsChunkId(Header, "RIFF") || !IsChunkId(&Header[8], "WAVE"))
+		{
+			UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("FWaveChunkReader: Not a RIFF wave file!"));
+			return false;
+		}
+
+		bool bHasFormat = false;
+		int64 Offset = 12;
+		while(Offset + 8 <= FileSize)
+		{
+			uint8 ChunkHeader[8];
+			if(!ReadBytes(ChunkHeader, Offset, 8))
+				return false;
+			
+			const int64 ChunkSize = ReadUInt32(&ChunkHeader[4]);
+			const int64 ChunkStart = Offset + 8;
+			if(IsChunkId(ChunkHeader, "fmt "))
+			{
+				uint8 Format[40];
+				const int64 NumFormatBytes = FMath::Min<int64>(ChunkSize, 40);
+				if(NumFormatBytes < 16 || !ReadBytes(Format, ChunkStart, NumFormatBytes))
+					return false;
+
+				uint16 FormatTag = ReadUInt16(&Format[0]);
+				NumChannels = ReadUInt16(&Format[2]);
+				SamplingRate = ReadUInt32(&Format[4]);
+				const uint16 BitsPerSample = ReadUInt16(&Format[14]);
+				if(FormatTag == FormatExtensible && NumFormatBytes >= 26)
+					FormatTag = ReadUInt16(&Format[24]); //First 2 bytes of the sub format GUID
+
+				if(FormatTag == FormatPCM && BitsPerSample == 16)
+					SampleFormat = EWaveSampleFormat::PCM16;
+				else if(FormatTag == FormatPCM && BitsPerSample == 24)
+					SampleFormat = EWaveSampleFormat::PCM24;
+				else if(FormatTag == FormatPCM && BitsPerSample == 32)
+					SampleFormat = EWaveSampleFormat::PCM32;
+				else if(FormatTag == FormatFloat && BitsPerSample == 32)
+					SampleFormat = EWaveSampleFormat::Float32;
+				else
+				{
+					UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("FWaveChunkReader: Unsupported wave format %d with %d bits per sample!"), FormatTag, BitsPerSample);
+					return false;
+				}
+				
+				BytesPerSample = BitsPerSample / 8;
+				bHasFormat = true;
+			}
+			else if(IsChunkId(ChunkHeader, "data"))
+			{
+				if(!bHasFormat || NumChannels <= 0)
+					return false;
+				
+				DataOffset = ChunkStart;
+				NumFrames = FMath::Min(ChunkSize, FileSize - ChunkStart) / (BytesPerSample * NumChannels);
+				CurrentFrame = 0;
+				return IsValid();
+			}
+
+			Offset = ChunkStart + ChunkSize + (ChunkSize & 1); //Chunks are padded to even sizes
+		}
+
+		UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("FWaveChunkReader: Can't find data chunk!"));
+		return false;
+	}
+
+	bool FWaveChunkReader::ReadBytes(uint8* OutData, const int64 Offset, const int64 NumBytes)
+	{
+		if(FileHandle.IsValid())
+			return FileHandle->Seek(Offset) && FileHandle->Read(OutData, NumBytes);
+
+		if(Offset + NumBytes > MemoryData.Num())
+			return false;
+		
+		FMemory::Memcpy(OutData, &MemoryData[Offset], NumBytes);
+		return true;
+	}
+
+	float FWaveChunkReader::GetSample(const uint8* SampleData) const
+	{
+		switch (SampleFormat)
+		{
+		case EWaveSampleFormat::PCM24:
+			{
+				//Shift to the top of int32 to keep the sign bit
+				const int32 Value = static_cast<int32>((static_cast<uint32>(SampleData[0]) << 8) | (static_cast<uint32>(SampleData[1]) << 16)
+														| (static_cast<uint32>(SampleData[2]) << 24));
+				return static_cast<float>(Value >> 8) / 8388608.0f;
+			}
+		case EWaveSampleFormat::PCM32:
+			return static_cast<float>(static_cast<int32>(WaveChunkReaderUtils::ReadUInt32(SampleData)) / 2147483648.0);
+		case EWaveSampleFormat::Float32:
+			{
+				const uint32 Bits = WaveChunkReaderUtils::ReadUInt32(SampleData);
+				float Value;
+				FMemory::Memcpy(&Value, &Bits, sizeof(float));
+				return Value;
+			}
+		default:
+			return static_cast<float>(static_cast<int16>(WaveChunkReaderUtils::ReadUInt16(SampleData))) / 32768.0f;
+		}
+	}
+
+	int32 FWaveChunkReader::ReadMono(TArrayView<float> OutBuffer, const int32 Channel)
+	{
+		if(!IsValid())
+			return 0;
+		
+		const int32 FrameSize = BytesPerSample * NumChannels;
+		const bool bIsDownmix = Channel == DownmixChannels || Channel >= NumChannels;
+		if(Channel >= NumChannels)
+			UE_LOG(LogImpactSFXSynthEditor, Warning, TEXT("FWaveChunkReader::ReadMono: Channel %d doesn't exist. Downmix all channels instead."), Channel);
+		
+		const float DownmixScale = 1.0f / NumChannels;
+		const int32 StartChannel = bIsDownmix ? 0 : FMath::Max(0, Channel);
+		const int32 EndChannel = bIsDownmix ? NumChannels : StartChannel + 1;
+		
+		int32 NumRead = 0;
+		const int32 NumRequest = static_cast<int32>(FMath::Min<int64>(OutBuffer.Num(), GetNumRemainFrames()));
+		while(NumRead < NumRequest)
+		{
+			const int32 NumChunkFrames = FMath::Min(NumFramesPerRead, NumRequest - NumRead);
+			ChunkData.SetNumUninitialized(NumChunkFrames * FrameSize, EAllowShrinking::No);
+			if(!ReadBytes(ChunkData.GetData(), DataOffset + CurrentFrame * FrameSize, ChunkData.Num()))
+			{
+				UE_LOG(LogImpactSFXSynthEditor, Error, TEXT("FWaveChunkReader::ReadMono: Failed to read wave data!"));
+				NumFrames = CurrentFrame;
+				break;
+			}
+			
+			const uint8* FrameData = ChunkData.GetData();
+			for(int32 i = 0; i < NumChunkFrames; i++, FrameData += FrameSize)
+			{
+				float Sum = 0.f;
+				for(int32 j = StartChannel; j < EndChannel; j++)
+					Sum += GetSample(&FrameData[j * BytesPerSample]);
+				OutBuffer[NumRead + i] = bIsDownmix ? Sum * DownmixScale : Sum;
+			}
+
+			NumRead += NumChunkFrames;
+			CurrentFrame += NumChunkFrames;
+		}
+		
+		return NumRead;
+	}
+}
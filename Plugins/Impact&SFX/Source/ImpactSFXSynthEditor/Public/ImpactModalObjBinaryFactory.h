@@ -0,0 +1,47 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorReimportHandler.h"
+#include "Factories/Factory.h"
+#include "ImpactModalObjBinaryFactory.generated.h"
+
+class UImpactModalObj;
+
+/**
+ * Imports impact modal objects from the compact binary format.
+ * Layout (little endian): FImpactModalBinaryHeader, then packed float arrays of amplitudes, decays and frequencies with NumModals entries each.
+ */
+UCLASS()
+class IMPACTSFXSYNTHEDITOR_API UImpactModalObjBinaryFactory : public UFactory, public FReimportHandler
+{
+	GENERATED_BODY()
+	
+public:
+	static const TCHAR* FileExtension;
+	
+	UImpactModalObjBinaryFactory();
+	
+	virtual UObject* FactoryCreateBinary(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, UObject* Context, const TCHAR* Type, const uint8*& Buffer, const uint8* BufferEnd, FFeedbackContext* Warn) override;
+
+	static bool ImportFromBinary(UImpactModalObj* ImpactModalObj, const uint8* Buffer, const uint8* BufferEnd);
+
+	/** Write a modal obj to the binary format. Useful to convert assets imported from json files. */
+	UFUNCTION(BlueprintCallable, Category = "ImpactSFXSynth|Import")
+	static bool ExportToBinaryFile(const UImpactModalObj* ImpactModalObj, const FString& Filename, bool bWriteChecksum = true);
+
+	/** Import all json and binary modal files of a directory into DestinationPath in one pass. */
+	UFUNCTION(BlueprintCallable, Category = "ImpactSFXSynth|Import")
+	static TArray<UObject*> ImportDirectory(const FString& SourceDirectory, const FString& DestinationPath, bool bReplaceExisting = true);
+	
+	//~ Begin FReimportHandler Interface
+	virtual bool CanReimport(UObject* Obj, TArray<FString>& OutFilenames) override;
+	virtual void SetReimportPaths( UObject* Obj, const TArray<FString>& NewReimportPaths ) override;
+	virtual EReimportResult::Type Reimport( UObject* Obj ) override;
+	//~ End FReimportHandler Interface
+
+	//~ Being UFactory Interface
+	virtual void CleanUp() override;
+	//~ End UFactory Interface
+};
@@ -0,0 +1,34 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ImpactSFXBenchmarkCommandlet.generated.h"
+
+/**
+ * Render every synthesizer headless at fixed block sizes and sampling rates and write the results as JSON.
+ * Usage: UnrealEditor-Cmd <Project> -run=ImpactSFXBenchmark [-Output=<File.json>] [-SampleRates=48000+44100] [-BlockSizes=256+512+1024]
+ *        [-Seconds=N] [-Seed=N] [-Filter=<Name>] [-ModalObj=<Path>] [-ResidualData=<Path>] [-MultiImpactData=<Path>] [-PianoModel=<Path>] -nullrhi
+ * Without asset paths, modal and residual data are generated from the seed. The piano is only measured when -PianoModel is set.
+ * Each result reports:
+ * - NsPerSample: wall time spent in the synthesizer per output frame.
+ * - VoicesPerMs: average active voices * rendered audio time / wall time. It's how many voices one core keeps in real time.
+ * - AllocationsPerBlock: heap allocations made by the rendering thread per block, warm-up blocks excluded.
+ */
+UCLASS()
+class IMPACTSFXSYNTHEDITOR_API UImpactSFXBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UImpactSFXBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	static void ParseIntList(const FString* Value, const TArray<int32>& Defaults, TArray<int32>& OutValues);
+	static FString GetDefaultOutputPath();
+};
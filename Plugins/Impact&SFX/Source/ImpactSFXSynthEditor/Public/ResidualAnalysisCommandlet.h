@@ -0,0 +1,36 @@
+﻿// Copyright 2023-2024, Le Binh Son, All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ResidualAnalysisCommandlet.generated.h"
+
+/**
+ * Analyze wav files into residual objects without opening the editor UI.
+ * Usage: UnrealEditor-Cmd <Project> -run=ResidualAnalysis -Source=<Dir or File[+File...]> -Dest=/Game/Path [-Channel=N] [-Force] -nullrhi
+ * Inputs whose content hash and analysis settings match the last saved result are skipped unless -Force is used.
+ * Subfolders of a source directory are mirrored under Dest. Inputs which still map to the same asset are reported and not analyzed.
+ */
+UCLASS()
+class IMPACTSFXSYNTHEDITOR_API UResidualAnalysisCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UResidualAnalysisCommandlet();
+	
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	/** OutSubFolders maps each file found in a source directory to its folder relative to that directory. */
+	static void GatherSourceFiles(const FString& Source, TArray<FString>& OutFiles, TMap<FString, FString>& OutSubFolders);
+	static FString MakePackageName(const FString& Dest, const FString& SubFolder, const FString& AssetName);
+	static FString MakeCacheKey(const FString& SourceFile, int32 Channel);
+	
+	static FString GetCacheFilePath();
+	static void LoadCache(TMap<FString, FString>& OutCache);
+	static void SaveCache(const TMap<FString, FString>& InCache);
+};
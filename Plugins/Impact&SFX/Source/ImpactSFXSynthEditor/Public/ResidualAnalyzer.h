@@ -5,6 +5,7 @@
 #include "DSP/Dsp.h"
 #include "DSP/BufferVectorOperations.h"
 #include "DSP/FFTAlgorithm.h"
+#include "WaveChunkReader.h"
 
 class UResidualObj;
 class USoundWave;
@@ -17,24 +18,49 @@ namespace LBSImpactSFXSynth
 	{
 	public:
 		static constexpr int32 NumFFTAnalyze = 1024;
+		static constexpr int32 HopSizeAnalyze = NumFFTAnalyze / 2;
 		static constexpr int32 NumErb = 32;
 		static constexpr float FreqMin = 20.0f;
 		static constexpr float FreqMax = 20000.0f;
 		static constexpr float ErbCutThreshold = 1e-3;
+		static constexpr int32 MinFramesPerChunk = 32;
+		static constexpr float MinCalibrateScale = 0.2f;
+		static constexpr float MaxCalibrateScale = 10.0f;
 		
-		FResidualAnalyzer(const USoundWave* Wave);
+		/// @param Wave The sound wave to be analyzed. Its imported PCM data is used by default.
+		/// @param InChannel The channel to be analyzed or FWaveChunkReader::DownmixChannels to average all channels.
+		/// @param bStreamSourceFile Stream the source file of the wave instead, which keeps its original bit depth.
+		/// Only used if the file on disk still has the same hash as when it was imported.
+		FResidualAnalyzer(const USoundWave* Wave, int32 InChannel = 0, bool bStreamSourceFile = false);
+
+		/// @param WaveFilePath A wav file on disk which is streamed while analyzing.
+		/// @param InChannel The channel to be analyzed or FWaveChunkReader::DownmixChannels to average all channels.
+		FResidualAnalyzer(const FString& WaveFilePath, int32 InChannel = 0);
 
 		bool StartAnalyzing(UResidualObj* OutResidualObj);
+
+		/// Number of chunks analyzed in parallel. 1 analyzes every frame on the calling thread. <= 0 uses one chunk per core.
+		/// The analyzed data doesn't depend on this value.
+		void SetNumAnalysisChunks(const int32 InNumChunks) { NumAnalysisChunks = InNumChunks; }
+
+		/// Number of full synthesis passes used to calibrate the magnitude in the last call to StartAnalyzing.
+		int32 GetNumCalibrationPasses() const { return NumCalibrationPasses; }
 			
 	private:
 		float SamplingRate;
 
-		TUniquePtr<IFFTAlgorithm> FFT;
-		FAlignedFloatBuffer WaveData;
+		FFFTSettings FFTSettings;
+		bool bIsFFTValid;
 		FAlignedFloatBuffer WindowBuffer;
-		FAlignedFloatBuffer OutComplex;
-		FAlignedFloatBuffer InReal;
-		FAlignedFloatBuffer OutMagnitude;
+
+		FWaveChunkReader Reader;
+		int32 Channel;
+		int32 NumAnalysisChunks = 0;
+		int32 NumCalibrationPasses = 0;
+		int64 NumPaddedSamples;
+		int64 PaddedReadPos;
+		int64 LastLoudIdx;
+		double OrgPower;
 
 		int32 HopSize;
 		int32 NumFreqs;
@@ -43,9 +69,19 @@ namespace LBSImpactSFXSynth
 		float ErbMax;
 		TArray<int32> Freq2ErbIndexes;
 		
-		void GetPaddedWaveMonoData(TArray<uint8> ImportedSoundWaveData, uint16 ImportedChannelCount, int32 TotalSamples);
+		bool OpenWave(const USoundWave* Wave, bool bStreamSourceFile);
+		bool OpenSourceFile(const USoundWave* Wave);
+		void InitAnalysis();
+		
+		/// Read the next samples of the mono wave data padded with zeros at the start and the end
+		/// @return The number of read samples
+		int32 ReadPaddedWave(float* OutData, int32 NumSamples);
 		void InitFFTBuffers();
 		void InitFreqBuffers();
+
+		/// Calculate ERB envelopes of frames starting every HopSize samples of InData.
+		/// Each call owns its FFT and scratch buffers so chunks can run in parallel.
+		void AnalyzeFrames(const float* InData, int32 NumFrames, float* OutErbData, float* OutTotalMags) const;
 		
 		void CalibrateSynthMagnitudeToOriginal(UResidualObj* OutResidualObj);
 	};
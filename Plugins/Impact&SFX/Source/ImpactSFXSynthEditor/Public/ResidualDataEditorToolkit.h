@@ -23,6 +23,9 @@ namespace LBSImpactSFXSynth
 		class IMPACTSFXSYNTHEDITOR_API FResidualDataEditorToolkit : public FAssetEditorToolkit, public FNotifyHook, public FEditorUndoClient
 		{
 		public:
+			FResidualDataEditorToolkit();
+			virtual ~FResidualDataEditorToolkit() override;
+			
 			void Init(const EToolkitMode::Type Mode, const TSharedPtr<IToolkitHost>& InitToolkitHost, UObject* InParentObject);
 
 			/** FAssetEditorToolkit interface */
@@ -49,6 +52,13 @@ namespace LBSImpactSFXSynth
 			static bool PlaySynthesizedSound(TArrayView<const float> InData);
 
 		protected:
+			struct FPreviewSynthResult
+			{
+				Audio::FAlignedFloatBuffer SynthesizedData;
+				TArray<FRichCurveKey> EnergyKeys;
+				TArray<FRichCurveKey> MagFreqKeys;
+			};
+			
 			struct FCurveData
 			{
 				FCurveModelID ModelID;
@@ -82,10 +92,18 @@ namespace LBSImpactSFXSynth
 
 			FImpactSynthCurve SynthesizedCurve;
 			FImpactSynthCurve MagFreqCurve;
+
+			/** Increased on each preview request so older async tasks know they are outdated and stop early */
+			TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> PreviewGeneration;
+			TSharedRef<FThreadSafeBool, ESPMode::ThreadSafe> bIsToolkitAlive;
+			bool bShouldZoomToFit;
+			/** Set when any request still in flight asked to play, so superseding it doesn't drop the playback */
+			bool bPlayPendingPreview;
 			
 			static const FName AppIdentifier;
 			static const FName PropertiesTabId;
 			static const FName CurveTabId;
+			static const FName SpectrogramTabId;
 
 			void InitCurves();
 			void ResetCurves();
@@ -98,6 +116,9 @@ namespace LBSImpactSFXSynth
 			/**	Spawns the tab allowing for editing/viewing the output curve(s) */
 			TSharedRef<SDockTab> SpawnTab_Properties(const FSpawnTabArgs& Args);
 
+			/**	Spawns the tab showing the ERB magnitudes of the residual object */
+			TSharedRef<SDockTab> SpawnTab_Spectrogram(const FSpawnTabArgs& Args);
+
 			void SetImpactSynthCurve(const int32 Index, FImpactSynthCurve& ImpactSynthCurve);
 			
 			/** Clears the expression curve at the given input index */
@@ -110,8 +131,16 @@ namespace LBSImpactSFXSynth
 			bool RequiresNewCurve(int32 InIndex, const FRichCurve& InRichCurve) const;
 
 			void OnResidualDataSynthesized();
-			void SynthesizeDataAndCurves(Audio::FAlignedFloatBuffer& SynthesizedData);
-			void AddMagFreqCurveKeys(const LBSImpactSFXSynth::FResidualSynth& ResidualSynth, TArrayView<const float> MagFreq);
+
+			/** Synthesize the preview sound and curves in a background task. Only the latest request is applied. */
+			void RequestPreviewSynthesis(bool bPlayWhenFinished);
+			void OnPreviewSynthesisFinished(FPreviewSynthResult&& Result);
+			
+			static bool SynthesizeDataAndCurves(const FResidualDataAssetProxyPtr& ResidualDataAssetProxy, float PlaySampleRate,
+												int32 HopSize, float VolumeScale, FPreviewSynthResult& OutResult,
+												TFunctionRef<bool()> IsCancelled);
+			static void BuildMagFreqCurveKeys(const LBSImpactSFXSynth::FResidualSynth& ResidualSynth, TArrayView<const float> MagFreq,
+											  TArray<FRichCurveKey>& OutKeys);
 
 			void OnStopPlayingResidualData();
 			
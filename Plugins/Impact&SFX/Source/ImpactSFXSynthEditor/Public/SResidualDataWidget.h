@@ -4,13 +4,19 @@
 
 #include "CoreMinimal.h"
 #include "ResidualObj.h"
+#include "Styling/SlateBrush.h"
+#include "UObject/StrongObjectPtr.h"
 #include "Widgets/SLeafWidget.h"
 
+class UTexture2D;
+
 DECLARE_DELEGATE_OneParam(FOnReisdualDataChanged, UResidualObj*)
 
 class IMPACTSFXSYNTHEDITOR_API SResidualDataWidget : public SLeafWidget
 {
 public:
+	static constexpr float MinDb = -80.f;
+	
 	SLATE_BEGIN_ARGS(SResidualDataWidget)
 			: _ResidualData(nullptr)
 		{}
@@ -18,15 +24,33 @@ public:
 		SLATE_EVENT(FOnReisdualDataChanged, OnReisdualDataChanged)
 	SLATE_END_ARGS()
 	 
+	virtual ~SResidualDataWidget() override;
+	
 	void Construct(const FArguments& InArgs);
 	 
 	int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 	FVector2D ComputeDesiredSize(float) const override;
 
+	/** Force the spectrogram to be baked again on the next paint. Called automatically when the residual object reports a change. */
+	void InvalidateSpectrogram();
+	
 private:
+	FDelegateHandle OnObjectPropertyChangedHandle;
+	
+	void OnObjectPropertyChanged(UObject* InObject, FPropertyChangedEvent& InPropertyChangedEvent);
+
 	TAttribute<UResidualObj*> ResidualData;
 	 
 	FOnReisdualDataChanged OnResidualDataChanged;
-	 
-	// FTransform2D GetPointsTransform(const FGeometry& AllottedGeometry) const;
+
+	/** Bake the magnitude grid into a transient texture decimated to the given pixel size */
+	void BakeSpectrogram(const UResidualObj* InResidualObj, const FIntPoint& InSize) const;
+
+	/** Cached spectrogram. Only rebuilt when the data or the decimated size changes. */
+	mutable TStrongObjectPtr<UTexture2D> SpectrogramTexture;
+	mutable FSlateBrush SpectrogramBrush;
+	mutable TWeakObjectPtr<const UResidualObj> CachedResidualObj;
+	mutable FIntPoint CachedSize;
+	mutable int32 CachedNumData;
+	mutable bool bIsSpectrogramDirty;
 };
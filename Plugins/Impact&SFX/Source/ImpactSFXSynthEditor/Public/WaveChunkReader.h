@@ -0,0 +1,66 @@
+﻿// Copyright 2023-2024, Le Binh Son, All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IFileHandle;
+
+namespace LBSImpactSFXSynth
+{
+	enum class EWaveSampleFormat : uint8
+	{
+		PCM16 = 0,
+		PCM24,
+		PCM32,
+		Float32
+	};
+	
+	/// Read wav data in small chunks and convert them to mono float samples.
+	/// Supports 16, 24, 32 bit integer PCM and 32 bit float with any number of channels.
+	class IMPACTSFXSYNTHEDITOR_API FWaveChunkReader
+	{
+	public:
+		static constexpr int32 DownmixChannels = INDEX_NONE;
+		static constexpr int32 NumFramesPerRead = 4096;
+		
+		FWaveChunkReader();
+		~FWaveChunkReader();
+
+		/// Stream a wav file from disk. Only the data of the current chunk is held in memory.
+		bool OpenFile(const FString& FilePath);
+		
+		/// Read from 16 bit interleaved PCM data already in memory.
+		bool OpenPCM16(TArray<uint8>&& InPCMData, uint32 InSamplingRate, uint16 InNumChannels);
+
+		/// Read the next mono samples.
+		/// @param OutBuffer Output buffer.
+		/// @param Channel The channel to be read or DownmixChannels to average all channels.
+		/// @return The number of read samples. Can be smaller than OutBuffer.Num() at the end of data.
+		int32 ReadMono(TArrayView<float> OutBuffer, int32 Channel);
+
+		bool IsValid() const { return NumChannels > 0 && SamplingRate > 0.f; }
+		float GetSamplingRate() const { return SamplingRate; }
+		int32 GetNumChannels() const { return NumChannels; }
+		int64 GetNumFrames() const { return NumFrames; }
+		int64 GetNumRemainFrames() const { return NumFrames - CurrentFrame; }
+		
+	protected:
+		bool ParseHeader();
+		bool ReadBytes(uint8* OutData, int64 Offset, int64 NumBytes);
+		float GetSample(const uint8* SampleData) const;
+		
+	private:
+		TUniquePtr<IFileHandle> FileHandle;
+		TArray<uint8> MemoryData;
+		TArray<uint8> ChunkData;
+
+		EWaveSampleFormat SampleFormat;
+		float SamplingRate;
+		int32 NumChannels;
+		int32 BytesPerSample;
+		int64 DataOffset;
+		int64 NumFrames;
+		int64 CurrentFrame;
+	};
+}
@@ -18,7 +18,8 @@ public class SHVirtualInstrument : ModuleRules
                 "AudioPlatformConfiguration",
                 "WaveTable",
                 "SignalProcessing",
-                "ImpactSFXSynth"
+                "ImpactSFXSynth",
+                "HarmonixMidi"
             }
         );
 			
@@ -35,8 +36,7 @@ public class SHVirtualInstrument : ModuleRules
                 "MetasoundEngine",
                 "MetasoundGenerator",
                 "MetasoundGraphCore",
-                "HarmonixMetasound",
-                "HarmonixMidi"
+                "HarmonixMetasound"
                 // ... add private dependencies that you statically link with here ...	
             }
         );